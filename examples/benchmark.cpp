@@ -2,6 +2,7 @@
 #include <chrono>
 #include <atomic>
 #include <vector>
+#include <algorithm>
 #include "../include/thread_pool/thread_pool.h"
 
 /**
@@ -34,47 +35,141 @@ int main() {
     }
 
     auto end_seq = std::chrono::high_resolution_clock::now();
-    auto duration_seq = std::chrono::duration_cast<std::chrono::milliseconds>(end_seq - start_seq);
+    auto duration_seq = std::chrono::duration_cast<std::chrono::microseconds>(end_seq - start_seq);
 
-    // Benchmark execução com ThreadPool
-    std::cout << "Executando benchmark concorrente..." << std::endl;
-    auto start_conc = std::chrono::high_resolution_clock::now();
+    // Benchmark execução com ThreadPool, em cada modo de escalonamento
+    auto run_pool = [&](SchedulerMode mode, std::vector<long>& results, size_t& threads) {
+        auto start = std::chrono::high_resolution_clock::now();
 
-    ThreadPool pool(std::thread::hardware_concurrency());
-    std::vector<std::future<long>> futures;
+        ThreadPool pool(ThreadPoolOptions{std::thread::hardware_concurrency(), mode});
+        std::vector<TaskFuture<long>> futures;
 
-    for (int i = 0; i < NUM_TAREFAS; ++i) {
-        futures.push_back(pool.submit(heavy_work, i));
-    }
+        for (int i = 0; i < NUM_TAREFAS; ++i) {
+            futures.push_back(pool.async(heavy_work, i));
+        }
 
-    std::vector<long> results_conc(NUM_TAREFAS);
-    for (int i = 0; i < NUM_TAREFAS; ++i) {
-        results_conc[i] = futures[i].get();
-    }
+        // Um único get() no lote em vez de um por tarefa
+        results = when_all(std::move(futures)).get();
 
-    auto end_conc = std::chrono::high_resolution_clock::now();
-    auto duration_conc = std::chrono::duration_cast<std::chrono::milliseconds>(end_conc - start_conc);
+        threads = pool.size();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    };
+
+    std::cout << "Executando benchmark concorrente (fila compartilhada)..." << std::endl;
+    std::vector<long> results_conc;
+    size_t pool_threads = 0;
+    auto duration_conc = run_pool(SchedulerMode::SharedQueue, results_conc, pool_threads);
+
+    std::cout << "Executando benchmark concorrente (work-stealing)..." << std::endl;
+    std::vector<long> results_ws;
+    auto duration_ws = run_pool(SchedulerMode::WorkStealing, results_ws, pool_threads);
 
     // Verifica que os resultados são iguais
-    bool results_match = (results_seq == results_conc);
+    bool results_match = (results_seq == results_conc) && (results_seq == results_ws);
 
     // Calcula speedup
     double speedup = static_cast<double>(duration_seq.count()) / duration_conc.count();
+    double speedup_ws = static_cast<double>(duration_seq.count()) / duration_ws.count();
 
     // Apresenta resultados
     std::cout << "\n=== Resultados do Benchmark ===" << std::endl;
     std::cout << "Número de tarefas: " << NUM_TAREFAS << std::endl;
-    std::cout << "Threads no pool: " << pool.size() << std::endl;
-    std::cout << "Tempo sequencial: " << duration_seq.count() << "ms" << std::endl;
-    std::cout << "Tempo concorrente: " << duration_conc.count() << "ms" << std::endl;
-    std::cout << "Speedup: " << speedup << "x" << std::endl;
+    std::cout << "Threads no pool: " << pool_threads << std::endl;
+    std::cout << "Tempo sequencial: " << duration_seq.count() << "us" << std::endl;
+    std::cout << "Tempo concorrente (fila compartilhada): " << duration_conc.count() << "us" << std::endl;
+    std::cout << "Tempo concorrente (work-stealing): " << duration_ws.count() << "us" << std::endl;
+    std::cout << "Speedup (fila compartilhada): " << speedup << "x" << std::endl;
+    std::cout << "Speedup (work-stealing): " << speedup_ws << "x" << std::endl;
     std::cout << "Resultados consistentes: " << (results_match ? "SIM" : "NÃO") << std::endl;
 
-    if (speedup > 1.0) {
+    if (std::max(speedup, speedup_ws) > 1.0) {
         std::cout << "✓ Concorrência melhorou a performance!" << std::endl;
     } else {
         std::cout << "⚠ Overhead da concorrência impactou performance" << std::endl;
     }
 
+    // Benchmark de lote: N futures individuais vs parallel_for com um único handle
+    const int NUM_PEQUENAS = 100000;
+    std::cout << "\n=== Lote de " << NUM_PEQUENAS << " tarefas pequenas ===" << std::endl;
+    {
+        ThreadPool pool(std::thread::hardware_concurrency());
+        std::vector<long> out(NUM_PEQUENAS);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::future<void>> futures;
+        futures.reserve(NUM_PEQUENAS);
+        for (int i = 0; i < NUM_PEQUENAS; ++i) {
+            futures.push_back(pool.submit([&out, i]() { out[i] = static_cast<long>(i) * i; }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration_individual = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+        start = std::chrono::high_resolution_clock::now();
+        pool.parallel_for(0, NUM_PEQUENAS, 256, [&out](int i) {
+            out[i] = static_cast<long>(i) * i;
+        }).get();
+        end = std::chrono::high_resolution_clock::now();
+        auto duration_bulk = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+        std::cout << "submit individual + N futures: " << duration_individual.count() << "us" << std::endl;
+        std::cout << "parallel_for + um JoinHandle: " << duration_bulk.count() << "us" << std::endl;
+    }
+
+    // Estratégia de espera: latência de tarefas que chegam logo após o pool ficar ocioso
+    const int NUM_RAJADAS = 2000;
+    std::cout << "\n=== Latência após ociosidade (" << NUM_RAJADAS << " rajadas) ===" << std::endl;
+    auto run_wait = [&](WaitStrategy strategy, const char* name) {
+        ThreadPoolOptions options;
+        options.wait_strategy = strategy;
+        ThreadPool pool(options);
+
+        long total_ns = 0;
+        for (int i = 0; i < NUM_RAJADAS; ++i) {
+            // Pausa curta: os workers acabaram de esvaziar a fila
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+            auto submitted = std::chrono::steady_clock::now();
+            total_ns += pool.submit([submitted]() {
+                return static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - submitted).count());
+            }).get();
+        }
+        std::cout << name << ": " << total_ns / NUM_RAJADAS << "ns até o início da tarefa" << std::endl;
+    };
+    run_wait(WaitStrategy::park(), "park imediato");
+    run_wait(WaitStrategy::spin_then_park(), "spin-then-park");
+
+    // Timers pendentes: roda de timers vs. um worker dormindo por timer
+    const int NUM_TIMERS = 200000;
+    std::cout << "\n=== " << NUM_TIMERS << " timers pendentes ===" << std::endl;
+    {
+        ThreadPool pool(4);
+        std::atomic<int> fired{0};
+        std::vector<TimerId> ids;
+        ids.reserve(NUM_TIMERS);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < NUM_TIMERS; ++i) {
+            ids.push_back(pool.schedule_after(std::chrono::milliseconds(1000 + i % 500), [&fired]() { ++fired; }));
+        }
+        auto scheduled = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < NUM_TIMERS; i += 2) {
+            pool.cancel_timer(ids[i]);
+        }
+        auto cancelled = std::chrono::high_resolution_clock::now();
+
+        while (fired.load() < NUM_TIMERS / 2) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        auto insert_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(scheduled - start).count();
+        auto cancel_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(cancelled - scheduled).count();
+        std::cout << "schedule_after: " << insert_ns / NUM_TIMERS << "ns por timer, cancel_timer: "
+                  << cancel_ns / (NUM_TIMERS / 2) << "ns por timer, " << fired.load()
+                  << " disparos com 1 thread de timer e nenhum worker esperando" << std::endl;
+    }
+
     return 0;
 }
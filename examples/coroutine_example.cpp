@@ -0,0 +1,57 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "../include/thread_pool/thread_pool.h"
+#include "../include/thread_pool/async_task.h"
+
+/**
+ * @brief Exemplo da interface de corrotinas (compilar com -DENABLE_COROUTINES=ON)
+ *
+ * Cada etapa salta para um worker com co_await pool.schedule(); aguardar uma
+ * AsyncTask retoma quem aguarda assim que ela termina, sem futures.
+ */
+int main() {
+    std::cout << "=== Exemplo de Corrotinas ===" << std::endl;
+
+    ThreadPool pool(4);
+
+    auto fetch = [&pool](int id) -> AsyncTask<int> {
+        co_await pool.schedule();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        co_return id * 10;
+    };
+
+    auto pipeline = [&]() -> AsyncTask<int> {
+        int total = 0;
+        for (int id = 1; id <= 5; ++id) {
+            int value = co_await fetch(id);
+            std::cout << "Etapa " << id << " -> " << value << " (thread "
+                      << std::this_thread::get_id() << ")" << std::endl;
+            total += value;
+        }
+        co_return total;
+    };
+
+    int total = sync_wait(pipeline());
+    std::cout << "Total: " << total << std::endl;
+
+    // Muitas corrotinas leves: a retomada ocupa uma única InlineTask
+    const int NUM_CORROTINAS = 100000;
+    auto start = std::chrono::high_resolution_clock::now();
+    auto many = [&]() -> AsyncTask<long> {
+        long sum = 0;
+        for (int i = 0; i < NUM_CORROTINAS; ++i) {
+            co_await pool.schedule();
+            sum += i;
+        }
+        co_return sum;
+    };
+    long sum = sync_wait(many());
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    std::cout << NUM_CORROTINAS << " retomadas em " << duration.count() << "us (soma "
+              << sum << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../include/resource_manager/resource_manager.h"
+
+namespace {
+
+const int NUM_CHAVES = 16;
+const int OPERACOES_POR_THREAD = 200000;
+const int ESCRITAS_POR_MIL = 10;               // 1% de escritas
+const int THREADS[] = {1, 2, 4, 8, 16};
+
+/**
+ * @struct Estatisticas
+ * @brief Recurso pequeno e trivialmente copiável; bytes == requisicoes * 100 sempre
+ */
+struct Estatisticas {
+    long requisicoes;                           ///< Requisições atendidas
+    long bytes;                                 ///< Bytes transferidos
+    double latencia_media;                      ///< Latência média (ms)
+    int status;                                 ///< Último código de status
+};
+
+/**
+ * @struct Resultado
+ * @brief Vazão e leituras inconsistentes de uma medição
+ */
+struct Resultado {
+    double mops;                                ///< Milhões de operações por segundo
+    long rasgadas;                              ///< Leituras que violaram o invariante
+};
+
+/**
+ * @brief Mede leituras com get_read_access ou optimistic_read com 1% de escritas
+ */
+Resultado medir(int threads, bool otimista) {
+    ResourceManager<int, Estatisticas> manager;
+    for (int i = 0; i < NUM_CHAVES; ++i) {
+        manager.add_resource(i, std::make_shared<Estatisticas>(Estatisticas{0, 0, 0.0, 200}));
+    }
+
+    std::atomic<int> prontas{0};
+    std::atomic<bool> largada{false};
+    std::atomic<long> rasgadas{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            std::mt19937 rng(42 + t);
+            std::uniform_int_distribution<int> chave(0, NUM_CHAVES - 1);
+            std::uniform_int_distribution<int> sorteio(0, 999);
+            prontas.fetch_add(1);
+            while (!largada.load(std::memory_order_acquire)) std::this_thread::yield();
+
+            long inconsistentes = 0;
+            for (int i = 0; i < OPERACOES_POR_THREAD; ++i) {
+                int key = chave(rng);
+                if (sorteio(rng) < ESCRITAS_POR_MIL) {
+                    auto write_lock = manager.get_write_access(key);
+                    write_lock->requisicoes += 1;
+                    write_lock->bytes += 100;
+                    write_lock->latencia_media = write_lock->latencia_media * 0.9 + 0.1;
+                } else if (otimista) {
+                    Estatisticas copia = manager.optimistic_read(key);
+                    if (copia.bytes != copia.requisicoes * 100) ++inconsistentes;
+                } else {
+                    auto read_lock = manager.get_read_access(key);
+                    if (read_lock->bytes != read_lock->requisicoes * 100) ++inconsistentes;
+                }
+            }
+            rasgadas.fetch_add(inconsistentes);
+        });
+    }
+
+    while (prontas.load() < threads) std::this_thread::yield();
+    auto start = std::chrono::high_resolution_clock::now();
+    largada.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double segundos = std::chrono::duration<double>(end - start).count();
+    return {static_cast<double>(threads) * OPERACOES_POR_THREAD / segundos / 1e6, rasgadas.load()};
+}
+
+}
+
+/**
+ * @brief Benchmark de leituras otimistas (seqlock) contra get_read_access
+ *
+ * Cada operação sorteia uma de poucas chaves quentes; 1% são escritas com
+ * get_write_access. get_read_access adquire o shared_mutex do recurso (e
+ * escreve na sua linha de cache), optimistic_read só lê a versão e o valor.
+ * A coluna "rasgadas" conta cópias inconsistentes e deve ser sempre zero.
+ */
+int main() {
+    std::cout << "=== Benchmark de Leitura Otimista (seqlock) ===" << std::endl;
+    std::cout << NUM_CHAVES << " chaves, " << OPERACOES_POR_THREAD << " operações por thread, "
+              << ESCRITAS_POR_MIL / 10.0 << "% escritas, " << std::thread::hardware_concurrency()
+              << " cores" << std::endl << std::endl;
+
+    std::cout << std::right << std::setw(8) << "Threads" << std::setw(18) << "get_read_access"
+              << std::setw(18) << "optimistic_read" << std::setw(10) << "Ganho"
+              << std::setw(12) << "Rasgadas" << std::endl;
+    std::cout << std::setw(8) << "" << std::setw(18) << "(Mops/s)" << std::setw(18) << "(Mops/s)" << std::endl;
+
+    for (int threads : THREADS) {
+        Resultado lock = medir(threads, false);
+        Resultado otimista = medir(threads, true);
+        std::cout << std::setw(8) << threads
+                  << std::setw(18) << std::fixed << std::setprecision(2) << lock.mops
+                  << std::setw(18) << otimista.mops
+                  << std::setw(9) << otimista.mops / lock.mops << "x"
+                  << std::setw(12) << (lock.rasgadas + otimista.rasgadas) << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "../include/thread_pool/parallel_algorithms.h"
+
+/**
+ * @brief Benchmark dos algoritmos paralelos contra os equivalentes sequenciais de std::
+ *
+ * Cada par executa sobre os mesmos dados; o melhor de várias repetições é
+ * reportado, junto com o speedup e a conferência do resultado.
+ */
+
+namespace {
+
+const int REPETICOES = 5;
+
+/**
+ * @brief Menor tempo de fn em microssegundos entre as repetições
+ */
+template<class F>
+long long best_of(F&& fn) {
+    long long best = -1;
+    for (int i = 0; i < REPETICOES; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        long long us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        if (best < 0 || us < best) best = us;
+    }
+    return best;
+}
+
+void report(const char* name, long long sequential, long long parallel, bool ok) {
+    double speedup = parallel > 0 ? static_cast<double>(sequential) / static_cast<double>(parallel) : 0.0;
+    std::cout << name << ": std " << sequential << "us, paralelo " << parallel << "us, speedup "
+              << speedup << "x" << (ok ? "" : " (RESULTADO DIVERGENTE)") << std::endl;
+}
+
+}
+
+int main() {
+    const size_t N = 1 << 24;
+    ThreadPool pool(ThreadPoolOptions{std::thread::hardware_concurrency(), SchedulerMode::WorkStealing});
+
+    std::cout << "=== Algoritmos paralelos (" << N << " elementos, " << pool.size() << " threads) ===" << std::endl;
+
+    std::mt19937_64 rng(12345);
+    std::vector<double> input(N);
+    for (auto& value : input) value = static_cast<double>(rng() % 1000) / 7.0;
+
+    // reduce: soma de doubles (reassociada pelas duas versões)
+    {
+        double seq = 0, par = 0;
+        long long t_seq = best_of([&]() { seq = std::reduce(input.begin(), input.end(), 0.0); });
+        long long t_par = best_of([&]() { par = parallel_reduce(pool, input.begin(), input.end(), 0.0); });
+        report("reduce", t_seq, t_par, std::abs(seq - par) <= 1e-6 * std::abs(seq));
+    }
+
+    // transform: função com algum custo por elemento
+    {
+        auto op = [](double value) { return std::sqrt(value) * std::log1p(value); };
+        std::vector<double> seq(N), par(N);
+        long long t_seq = best_of([&]() { std::transform(input.begin(), input.end(), seq.begin(), op); });
+        long long t_par = best_of([&]() { parallel_transform(pool, input.begin(), input.end(), par.begin(), op); });
+        report("transform", t_seq, t_par, seq == par);
+    }
+
+    // scan: soma prefixada de inteiros (resultado exato)
+    {
+        std::vector<long long> values(N);
+        for (auto& value : values) value = static_cast<long long>(rng() % 100);
+        std::vector<long long> seq(N), par(N);
+        long long t_seq = best_of([&]() { std::inclusive_scan(values.begin(), values.end(), seq.begin()); });
+        long long t_par = best_of([&]() { parallel_scan(pool, values.begin(), values.end(), par.begin()); });
+        report("inclusive_scan", t_seq, t_par, seq == par);
+    }
+
+    // sort: cada repetição ordena uma cópia dos mesmos dados
+    {
+        std::vector<int> values(N);
+        for (auto& value : values) value = static_cast<int>(rng());
+        std::vector<int> seq, par;
+        long long t_seq = best_of([&]() {
+            seq = values;
+            std::sort(seq.begin(), seq.end());
+        });
+        long long t_par = best_of([&]() {
+            par = values;
+            parallel_sort(pool, par.begin(), par.end());
+        });
+        report("sort", t_seq, t_par, seq == par);
+    }
+
+    return 0;
+}
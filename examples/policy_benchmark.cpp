@@ -0,0 +1,123 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "../include/thread_pool/thread_pool.h"
+#include "../include/thread_pool/basic_thread_pool.h"
+
+namespace {
+
+const int NUM_TAREFAS = 200000;
+const int NUM_SUBMITS = 20000;
+
+/**
+ * @struct Resultado
+ * @brief Tempos de uma configuração
+ */
+struct Resultado {
+    double execute_ns;                          ///< ns por tarefa de execute
+    double submit_ns;                           ///< ns por submit + get em lotes
+};
+
+/**
+ * @brief Mede execute (tarefas mínimas) e submit com future em qualquer pool
+ */
+template<class Pool>
+Resultado medir(Pool& pool) {
+    std::atomic<int> done{0};
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < NUM_TAREFAS; ++i) {
+        pool.execute([&done]() { done.fetch_add(1, std::memory_order_relaxed); });
+    }
+    while (done.load(std::memory_order_acquire) < NUM_TAREFAS) {
+        std::this_thread::yield();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double execute_ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / NUM_TAREFAS;
+
+    start = std::chrono::high_resolution_clock::now();
+    long checksum = 0;
+    std::vector<std::future<long>> futures;
+    for (int batch = 0; batch < NUM_SUBMITS; batch += 256) {
+        futures.clear();
+        for (int i = batch; i < batch + 256; ++i) {
+            futures.push_back(pool.submit([](int n) { return static_cast<long>(n) * 2; }, i));
+        }
+        for (auto& future : futures) {
+            checksum += future.get();
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double submit_ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / NUM_SUBMITS;
+
+    if (checksum == 0) std::cout << "checksum inválido" << std::endl;
+    return {execute_ns, submit_ns};
+}
+
+/**
+ * @brief Imprime uma linha da tabela
+ */
+void imprimir(const std::string& nome, const Resultado& resultado) {
+    std::cout << std::left << std::setw(44) << nome
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << resultado.execute_ns
+              << std::setw(12) << resultado.submit_ns << std::endl;
+}
+
+}
+
+/**
+ * @brief Benchmark das configurações do BasicThreadPool contra o ThreadPool
+ *
+ * Compara o pool configurável em tempo de execução (fila atrás de
+ * shared_ptr e chamadas virtuais) com instâncias do BasicThreadPool, em que
+ * fila, espera e armazenamento de tarefa são resolvidos em compilação.
+ */
+int main() {
+    std::cout << "=== Benchmark de Políticas do Pool ===" << std::endl;
+    size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    std::cout << "Threads: " << threads << ", " << NUM_TAREFAS << " tarefas de execute, "
+              << NUM_SUBMITS << " submits" << std::endl << std::endl;
+
+    std::cout << std::left << std::setw(44) << "Configuração"
+              << std::right << std::setw(10) << "execute" << std::setw(12) << "submit" << std::endl;
+    std::cout << std::left << std::setw(44) << ""
+              << std::right << std::setw(10) << "(ns/tar.)" << std::setw(12) << "(ns/tar.)" << std::endl;
+
+    {
+        ThreadPool pool(ThreadPoolOptions{threads, SchedulerMode::SharedQueue});
+        imprimir("ThreadPool (dinâmico, Mutex)", medir(pool));
+    }
+    {
+        ThreadPoolOptions options{threads, SchedulerMode::SharedQueue, QueueBackend::RingBuffer};
+        options.wait_strategy = WaitStrategy::spin_then_park();
+        ThreadPool pool(options);
+        imprimir("ThreadPool (dinâmico, RingBuffer, spin)", medir(pool));
+    }
+    {
+        DefaultThreadPool pool(threads);
+        imprimir("DefaultThreadPool (Mutex, Park, Inline)", medir(pool));
+    }
+    {
+        BasicThreadPool<MutexQueuePolicy, ParkWaitPolicy, FunctionTaskPolicy> pool(threads);
+        imprimir("Basic<Mutex, Park, std::function>", medir(pool));
+    }
+    {
+        BasicThreadPool<RingQueuePolicy<4096>, ParkWaitPolicy, InlineTaskPolicy> pool(threads);
+        imprimir("Basic<Ring<4096>, Park, Inline>", medir(pool));
+    }
+    {
+        BasicThreadPool<RingQueuePolicy<4096>, SpinThenParkWaitPolicy<>, InlineTaskPolicy> pool(threads);
+        imprimir("Basic<Ring<4096>, SpinThenPark, Inline>", medir(pool));
+    }
+    {
+        BasicThreadPool<RingQueuePolicy<4096>, SpinWaitPolicy, InlineTaskPolicy> pool(threads);
+        imprimir("Basic<Ring<4096>, Spin, Inline>", medir(pool));
+    }
+
+    return 0;
+}
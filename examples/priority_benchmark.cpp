@@ -0,0 +1,81 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include "../include/thread_pool/thread_pool.h"
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Calcula um percentil de uma amostra de latências
+ * @param samples Latências em microssegundos (é ordenada no lugar)
+ * @param percentile Percentil desejado (0-100)
+ * @return Latência no percentil
+ */
+static long percentile_of(std::vector<long>& samples, double percentile) {
+    if (samples.empty()) return 0;
+    std::sort(samples.begin(), samples.end());
+    size_t index = static_cast<size_t>(percentile / 100.0 * (samples.size() - 1));
+    return samples[index];
+}
+
+/**
+ * @brief Benchmark de latência por classe de prioridade
+ *
+ * Inunda o pool com tarefas de fundo e intercala, a cada poucas submissões,
+ * uma tarefa sonda que mede o tempo entre submit e o início da execução.
+ * Compara a sonda com a mesma prioridade do fundo (FIFO puro) contra a sonda
+ * High sobre fundo Low, em cada modo de escalonamento.
+ */
+int main() {
+    std::cout << "=== Benchmark de Prioridades ===" << std::endl;
+
+    const int NUM_FUNDO = 40000;
+    const int SONDA_A_CADA = 80;
+    const int WORK_PER_TASK = 5000;
+
+    auto background_work = []() {
+        volatile long result = 0;
+        for (int i = 0; i < WORK_PER_TASK; ++i) {
+            result = result + i;
+        }
+    };
+
+    auto run_pool = [&](SchedulerMode mode, TaskPriority background, TaskPriority probe) {
+        ThreadPool pool(ThreadPoolOptions{4, mode});
+
+        std::vector<std::future<long>> probes;
+        for (int i = 0; i < NUM_FUNDO; ++i) {
+            pool.submit(background, background_work);
+            if (i % SONDA_A_CADA == 0) {
+                auto submitted = Clock::now();
+                probes.push_back(pool.submit(probe, [submitted]() {
+                    return static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(
+                        Clock::now() - submitted).count());
+                }));
+            }
+        }
+
+        std::vector<long> latencies;
+        latencies.reserve(probes.size());
+        for (auto& future : probes) {
+            latencies.push_back(future.get());
+        }
+
+        std::cout << "  p50: " << percentile_of(latencies, 50) << "μs, p99: "
+                  << percentile_of(latencies, 99) << "μs" << std::endl;
+    };
+
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        const char* name = mode == SchedulerMode::SharedQueue ? "SharedQueue" : "WorkStealing";
+
+        std::cout << "\n" << name << " - sonda Normal sobre fundo Normal:" << std::endl;
+        run_pool(mode, TaskPriority::Normal, TaskPriority::Normal);
+
+        std::cout << name << " - sonda High sobre fundo Low:" << std::endl;
+        run_pool(mode, TaskPriority::Low, TaskPriority::High);
+    }
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/resource_manager/resource_manager.h"
+
+namespace {
+
+const int NUM_CHAVES = 4096;
+const int OPERACOES_TOTAIS = 800000;
+const int PERCENTUAL_ESCRITA = 5;
+const double EXPOENTE_ZIPF = 0.99;
+const int THREADS[] = {1, 2, 4, 8, 16, 32, 64};
+
+/**
+ * @class GeradorZipf
+ * @brief Sorteia chaves com distribuição de Zipf (chave 0 é a mais acessada)
+ */
+class GeradorZipf {
+public:
+    GeradorZipf(int chaves, double expoente) : acumulada(chaves) {
+        double soma = 0.0;
+        for (int i = 0; i < chaves; ++i) {
+            soma += 1.0 / std::pow(i + 1, expoente);
+            acumulada[i] = soma;
+        }
+        for (auto& valor : acumulada) valor /= soma;
+    }
+
+    template<class Rng>
+    int operator()(Rng& rng) {
+        double sorteio = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        auto it = std::lower_bound(acumulada.begin(), acumulada.end(), sorteio);
+        return static_cast<int>(std::min<size_t>(it - acumulada.begin(), acumulada.size() - 1));
+    }
+
+private:
+    std::vector<double> acumulada;              ///< Distribuição acumulada
+};
+
+/**
+ * @brief Gera as chaves de cada thread antes da medição (sorteio fora do tempo medido)
+ */
+std::vector<std::vector<int>> gerar_chaves(int threads, bool zipf) {
+    GeradorZipf gerador(NUM_CHAVES, EXPOENTE_ZIPF);
+    std::vector<std::vector<int>> chaves(threads);
+    int por_thread = OPERACOES_TOTAIS / threads;
+    for (int t = 0; t < threads; ++t) {
+        std::mt19937 rng(1234 + t);
+        std::uniform_int_distribution<int> uniforme(0, NUM_CHAVES - 1);
+        chaves[t].reserve(por_thread);
+        for (int i = 0; i < por_thread; ++i) {
+            chaves[t].push_back(zipf ? gerador(rng) : uniforme(rng));
+        }
+    }
+    return chaves;
+}
+
+/**
+ * @brief Executa as operações em paralelo e retorna milhões de operações por segundo
+ */
+double medir(size_t shards, const std::vector<std::vector<int>>& chaves) {
+    ResourceManager<int, long> manager(shards);
+    for (int i = 0; i < NUM_CHAVES; ++i) {
+        manager.add_resource(i, std::make_shared<long>(0));
+    }
+
+    std::atomic<int> prontas{0};
+    std::atomic<bool> largada{false};
+    std::vector<std::thread> threads;
+    long operacoes = 0;
+    for (const auto& sequencia : chaves) {
+        operacoes += static_cast<long>(sequencia.size());
+        threads.emplace_back([&, &sequencia = sequencia]() {
+            prontas.fetch_add(1);
+            while (!largada.load(std::memory_order_acquire)) std::this_thread::yield();
+            long checksum = 0;
+            for (size_t i = 0; i < sequencia.size(); ++i) {
+                if (static_cast<int>(i % 100) < PERCENTUAL_ESCRITA) {
+                    auto write_lock = manager.get_write_access(sequencia[i]);
+                    ++*write_lock;
+                } else {
+                    auto read_lock = manager.get_read_access(sequencia[i]);
+                    checksum += *read_lock;
+                }
+            }
+            if (checksum < 0) std::cout << "checksum inválido" << std::endl;
+        });
+    }
+
+    while (prontas.load() < static_cast<int>(chaves.size())) std::this_thread::yield();
+    auto start = std::chrono::high_resolution_clock::now();
+    largada.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double segundos = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(operacoes) / segundos / 1e6;
+}
+
+}
+
+/**
+ * @brief Benchmark de escalabilidade do ResourceManager com e sem shards
+ *
+ * Compara o mapa único (um shared_mutex para todas as buscas) com o mapa
+ * dividido em ResourceManager::DEFAULT_SHARDS shards, de 1 a 64 threads, com
+ * chaves uniformes e com chaves Zipf (poucas chaves concentram os acessos e
+ * a disputa passa a ser pelo lock do próprio recurso).
+ */
+int main() {
+    const size_t shards = ResourceManager<int, long>::DEFAULT_SHARDS;
+
+    std::cout << "=== Benchmark de Escalabilidade do ResourceManager ===" << std::endl;
+    std::cout << NUM_CHAVES << " chaves, " << OPERACOES_TOTAIS << " operações por medição, "
+              << PERCENTUAL_ESCRITA << "% escritas, Zipf s=" << EXPOENTE_ZIPF
+              << ", " << std::thread::hardware_concurrency() << " cores" << std::endl << std::endl;
+
+    std::cout << std::left << std::setw(14) << "Distribuição" << std::right << std::setw(8) << "Threads"
+              << std::setw(14) << "1 shard" << std::setw(14) << (std::to_string(shards) + " shards")
+              << std::setw(10) << "Ganho" << std::endl;
+    std::cout << std::left << std::setw(14) << "" << std::right << std::setw(8) << ""
+              << std::setw(14) << "(Mops/s)" << std::setw(14) << "(Mops/s)" << std::endl;
+
+    for (bool zipf : {false, true}) {
+        for (int threads : THREADS) {
+            auto chaves = gerar_chaves(threads, zipf);
+            double unico = medir(1, chaves);
+            double dividido = medir(shards, chaves);
+            std::cout << std::left << std::setw(14) << (zipf ? "Zipf" : "Uniforme")
+                      << std::right << std::setw(8) << threads
+                      << std::setw(14) << std::fixed << std::setprecision(2) << unico
+                      << std::setw(14) << dividido
+                      << std::setw(9) << std::setprecision(2) << dividido / unico << "x" << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <new>
+#include <cstdlib>
+#include "../include/thread_pool/thread_pool.h"
+
+// Contador global de alocações no heap (todas as threads)
+static std::atomic<size_t> allocation_count{0};
+
+void* operator new(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+/**
+ * @brief Benchmark de alocações por tarefa no caminho de submit
+ *
+ * Compara o caminho antigo (std::bind + make_shared<packaged_task> +
+ * std::function) com o ThreadPool::submit atual (InlineTask + estado do
+ * promise no SlabPool), em cada backend de fila.
+ */
+int main() {
+    std::cout << "=== Benchmark de Alocações por Tarefa ===" << std::endl;
+
+    const int NUM_LOTES = 200;
+    const int TAREFAS_POR_LOTE = 256;
+    const int NUM_TAREFAS = NUM_LOTES * TAREFAS_POR_LOTE;
+
+    auto small_work = [](int n) { return static_cast<long>(n) * 2; };
+
+    // Caminho antigo, reproduzido em uma única thread
+    size_t before = allocation_count.load();
+    auto start = std::chrono::high_resolution_clock::now();
+    long checksum_old = 0;
+    for (int i = 0; i < NUM_TAREFAS; ++i) {
+        auto task = std::make_shared<std::packaged_task<long()>>(std::bind(small_work, i));
+        std::future<long> result = task->get_future();
+        std::function<void()> wrapped = [task]() { (*task)(); };
+        wrapped();
+        checksum_old += result.get();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double old_allocs = static_cast<double>(allocation_count.load() - before) / NUM_TAREFAS;
+    auto old_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / NUM_TAREFAS;
+
+    std::cout << "\nCaminho antigo (bind + packaged_task + std::function):" << std::endl;
+    std::cout << "  Alocações por tarefa: " << old_allocs << std::endl;
+    std::cout << "  Tempo por tarefa (sem fila): " << old_ns << "ns" << std::endl;
+
+    auto run_pool = [&](QueueBackend backend, const char* name) {
+        ThreadPoolOptions options;
+        options.num_threads = 4;
+        options.queue_backend = backend;
+        ThreadPool pool(options);
+
+        std::vector<std::future<long>> futures;
+        futures.reserve(TAREFAS_POR_LOTE);
+
+        auto run_batch = [&](int batch) {
+            long checksum = 0;
+            for (int i = 0; i < TAREFAS_POR_LOTE; ++i) {
+                futures.push_back(pool.submit(small_work, batch * TAREFAS_POR_LOTE + i));
+            }
+            for (auto& future : futures) {
+                checksum += future.get();
+            }
+            futures.clear();
+            return checksum;
+        };
+
+        // Aquecimento: enche os caches do SlabPool e as deques
+        for (int batch = 0; batch < 10; ++batch) {
+            run_batch(batch);
+        }
+
+        size_t pool_before = allocation_count.load();
+        auto pool_start = std::chrono::high_resolution_clock::now();
+        long checksum = 0;
+        for (int batch = 0; batch < NUM_LOTES; ++batch) {
+            checksum += run_batch(batch);
+        }
+        auto pool_end = std::chrono::high_resolution_clock::now();
+        double allocs = static_cast<double>(allocation_count.load() - pool_before) / NUM_TAREFAS;
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(pool_end - pool_start).count() / NUM_TAREFAS;
+
+        std::cout << "\nThreadPool::submit (" << name << "):" << std::endl;
+        std::cout << "  Alocações por tarefa: " << allocs << std::endl;
+        std::cout << "  Tempo por tarefa (submit + get): " << ns << "ns" << std::endl;
+        std::cout << "  Resultados consistentes: " << (checksum == checksum_old ? "SIM" : "NÃO") << std::endl;
+    };
+
+    run_pool(QueueBackend::Mutex, "MutexTaskQueue");
+    run_pool(QueueBackend::RingBuffer, "RingBufferTaskQueue");
+
+    return 0;
+}
@@ -39,6 +39,18 @@ int main() {
         std::cout << "Resultado da tarefa " << i << ": " << result << std::endl;
     }
 
+    // Retrato das métricas dos workers, lido sem parar o pool
+    ThreadPoolStats stats = pool.stats();
+    std::cout << "\nTarefas executadas: " << stats.totals.tasks_executed
+              << ", utilização: " << stats.totals.utilization() * 100 << "%" << std::endl;
+    std::cout << "Espera na fila p50/p99: " << stats.totals.queue_wait.percentile(0.5).count() << "ns / "
+              << stats.totals.queue_wait.percentile(0.99).count() << "ns" << std::endl;
+    for (const auto& worker : stats.workers) {
+        std::cout << "Worker " << worker.index << ": " << worker.tasks_executed << " tarefas, execução p50 "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(worker.run_time.percentile(0.5)).count()
+                  << "ms" << std::endl;
+    }
+
     std::cout << "Exemplo concluído com sucesso!" << std::endl;
     return 0;
 }
@@ -0,0 +1,47 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <vector>
+#include "../include/thread_pool/thread_pool.h"
+
+/**
+ * @brief Exemplo de linha do tempo das tarefas exportada para o Perfetto
+ *
+ * Grava algumas tarefas nomeadas com TraceLabel e escreve trace.json, que
+ * pode ser aberto em https://ui.perfetto.dev ou chrome://tracing.
+ */
+int main(int argc, char* argv[]) {
+    const char* path = argc > 1 ? argv[1] : "trace.json";
+
+    ThreadPool pool(ThreadPoolOptions{4, SchedulerMode::WorkStealing});
+    pool.start_tracing();
+
+    std::vector<std::future<int>> results;
+    {
+        TraceLabel label("carregar");
+        for (int i = 0; i < 8; ++i) {
+            results.push_back(pool.submit([i]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2 + i % 3));
+                return i;
+            }));
+        }
+    }
+    {
+        TraceLabel label("processar");
+        pool.parallel_for(0, 64, 4, [](int) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }).get();
+    }
+
+    int sum = 0;
+    for (auto& result : results) {
+        sum += result.get();
+    }
+    pool.stop_tracing();
+
+    std::ofstream out(path);
+    pool.write_trace(out);
+    std::cout << "Soma: " << sum << std::endl;
+    std::cout << "Trace escrito em " << path << " (abra em https://ui.perfetto.dev)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,160 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class EpochDomain
+ * @brief Recuperação de memória por épocas para leitores sem lock
+ *
+ * Leitores marcam com EpochGuard o trecho em que seguem ponteiros de uma
+ * estrutura compartilhada; escritores desligam um nó da estrutura e o
+ * entregam a retire() em vez de apagá-lo. O nó só é apagado quando a época
+ * global avança duas vezes desde a retirada, o que exige que todos os
+ * leitores ativos tenham observado a época atual; nenhum leitor que ainda
+ * possa enxergar o nó continua ativo nesse ponto.
+ *
+ * Entrar e sair de um EpochGuard escreve só no registro da própria thread
+ * (em linha de cache própria), sem contador compartilhado entre leitores.
+ * Os registros das threads são reaproveitados quando uma thread termina.
+ */
+class EpochDomain {
+public:
+    /**
+     * @brief Domínio global do processo
+     * @return Instância única
+     */
+    static EpochDomain& instance();
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    /**
+     * @brief Destrutor que apaga os objetos ainda pendentes
+     */
+    ~EpochDomain();
+
+    /**
+     * @brief Marca a thread atual como leitora na época atual (aninhável)
+     */
+    void enter();
+
+    /**
+     * @brief Encerra o trecho de leitura da thread atual
+     */
+    void leave();
+
+    /**
+     * @brief Adia a destruição de um objeto já inacessível para novos leitores
+     *
+     * Chama collect(), que pode destruir objetos retirados por qualquer
+     * estrutura do processo: não chame segurando um lock que esses
+     * destrutores possam precisar.
+     *
+     * @param pointer Objeto retirado da estrutura
+     * @param deleter Função que destrói o objeto
+     */
+    void retire(void* pointer, void (*deleter)(void*));
+
+    /**
+     * @brief Adia o delete de um objeto já inacessível para novos leitores
+     * @param pointer Objeto retirado da estrutura
+     */
+    template<typename T>
+    void retire(T* pointer) {
+        retire(pointer, [](void* object) { delete static_cast<T*>(object); });
+    }
+
+    /**
+     * @brief Tenta avançar a época e apaga os objetos que já podem ser liberados
+     */
+    void collect();
+
+    /**
+     * @brief Retorna o número de objetos retirados ainda não apagados
+     * @return Objetos pendentes
+     */
+    size_t pending() const;
+
+private:
+    friend struct EpochRecordHolder;
+
+    static constexpr uint64_t QUIESCENT = UINT64_MAX; ///< Registro fora de leitura
+
+    /**
+     * @struct Record
+     * @brief Registro de uma thread, em linha de cache própria
+     */
+    struct alignas(64) Record {
+        std::atomic<uint64_t> epoch{QUIESCENT}; ///< Época observada (QUIESCENT fora de leitura)
+        std::atomic<bool> in_use{false};        ///< Registro pertence a uma thread viva
+        unsigned depth = 0;                     ///< Guardas aninhados (só a dona acessa)
+        Record* next = nullptr;                 ///< Próximo registro (lista só cresce)
+    };
+
+    /**
+     * @struct Retired
+     * @brief Objeto aguardando a liberação
+     */
+    struct Retired {
+        void* pointer;                          ///< Objeto retirado
+        void (*deleter)(void*);                 ///< Função de destruição
+        uint64_t epoch;                         ///< Época da retirada
+    };
+
+    EpochDomain() = default;
+
+    /**
+     * @brief Registro da thread atual (adquirido no primeiro uso)
+     */
+    Record* local_record();
+
+    /**
+     * @brief Obtém um registro livre ou cria um novo
+     */
+    Record* acquire_record();
+
+    /**
+     * @brief Avança a época se todos os leitores ativos a observaram (com retired_mutex)
+     */
+    bool try_advance();
+
+    alignas(64) std::atomic<uint64_t> global_epoch{1}; ///< Época global
+    std::atomic<Record*> records{nullptr};      ///< Registros das threads
+    mutable std::mutex retired_mutex;           ///< Protege retired e o avanço da época
+    std::vector<Retired> retired;               ///< Objetos aguardando liberação
+};
+
+/**
+ * @class EpochGuard
+ * @brief RAII para um trecho de leitura sem lock no EpochDomain
+ */
+class EpochGuard {
+public:
+    /**
+     * @brief Construtor que entra na época atual
+     * @param domain Domínio de recuperação
+     */
+    explicit EpochGuard(EpochDomain& domain = EpochDomain::instance())
+        : domain(domain) {
+        domain.enter();
+    }
+
+    /**
+     * @brief Destrutor que sai da época
+     */
+    ~EpochGuard() {
+        domain.leave();
+    }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+private:
+    EpochDomain& domain;                        ///< Domínio de recuperação
+};
+
+#endif
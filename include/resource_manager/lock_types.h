@@ -2,17 +2,52 @@
 #define LOCK_TYPES_H
 
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <utility>
+#include <vector>
+
+template<typename T>
+class SharedResource;
+
+template<typename Key, typename Resource, typename Hash>
+class ResourceManager;
+
+/**
+ * @enum AccessMode
+ * @brief Como um SharedResource sincroniza leitores e escritores
+ */
+enum class AccessMode {
+    Locked,                                     ///< shared_mutex; o escritor altera o recurso no lugar
+    CopyOnWrite                                 ///< Leitores usam versões imutáveis sem lock; o escritor copia e publica
+};
+
+/**
+ * @enum LockMode
+ * @brief Tipo de lock pedido para cada chave em ResourceManager::lock_many
+ */
+enum class LockMode {
+    Read,                                       ///< Lock de leitura compartilhada
+    Write                                       ///< Lock de escrita exclusiva
+};
 
 /**
  * @class ReadLock
  * @brief RAII wrapper para lock de leitura compartilhada
  *
  * Garante que o lock é adquirido na construção e liberado na destruição.
+ * Em recursos AccessMode::CopyOnWrite, não há lock: o ReadLock segura uma
+ * versão imutável, que escritores nunca alteram.
  */
 template<typename T>
 class ReadLock {
 public:
+    /**
+     * @brief Construtor sem lock sobre uma versão imutável do recurso
+     * @param snapshot Versão publicada do recurso
+     */
+    explicit ReadLock(std::shared_ptr<T> snapshot);
+
     /**
      * @brief Construtor que adquire o lock de leitura
      * @param resource Recurso a ser acessado
@@ -53,6 +88,10 @@ private:
  * @brief RAII wrapper para lock de escrita exclusiva
  *
  * Garante acesso exclusivo ao recurso durante o tempo de vida do lock.
+ * Criado por um SharedResource, avisa o dono no início e no fim da
+ * escrita: o contador de versão dos leitores otimistas fica ímpar enquanto
+ * o lock existe e, em AccessMode::CopyOnWrite, as alterações vão para uma
+ * cópia publicada como nova versão na liberação.
  */
 template<typename T>
 class WriteLock {
@@ -61,19 +100,21 @@ public:
      * @brief Construtor que adquire o lock de escrita
      * @param resource Recurso a ser acessado
      * @param mutex Mutex compartilhado para controle
+     * @param owner SharedResource avisado no início e no fim da escrita (opcional)
      */
-    WriteLock(std::shared_ptr<T> resource, std::shared_mutex& mutex);
+    WriteLock(std::shared_ptr<T> resource, std::shared_mutex& mutex,
+              SharedResource<T>* owner = nullptr);
 
     /**
-     * @brief Destrutor que libera o lock
+     * @brief Destrutor que publica a nova versão e libera o lock
      */
-    ~WriteLock() = default;
+    ~WriteLock();
 
     // Não copiável, apenas movível
     WriteLock(const WriteLock&) = delete;
     WriteLock& operator=(const WriteLock&) = delete;
-    WriteLock(WriteLock&&) = default;
-    WriteLock& operator=(WriteLock&&) = default;
+    WriteLock(WriteLock&& other) noexcept;
+    WriteLock& operator=(WriteLock&& other) noexcept;
 
     /**
      * @brief Operador de acesso ao recurso
@@ -88,11 +129,64 @@ public:
     T* operator->();
 
 private:
+    /**
+     * @brief Encerra a escrita no dono, ainda com o lock
+     */
+    void publish();
+
     std::shared_ptr<T> resource;                ///< Recurso protegido
     std::unique_lock<std::shared_mutex> lock;   ///< Lock de escrita
+    SharedResource<T>* owner;                   ///< Dono avisado da escrita (nulo se não há)
+};
+
+/**
+ * @class MultiLock
+ * @brief RAII para um lote de locks adquiridos juntos por ResourceManager::lock_many
+ *
+ * Segura os locks de leitura e de escrita do lote, adquiridos em uma ordem
+ * global determinística, e os libera juntos na destruição.
+ */
+template<typename T>
+class MultiLock {
+public:
+    /**
+     * @brief Construtor padrão (lote vazio)
+     */
+    MultiLock() = default;
+
+    // Não copiável, apenas movível
+    MultiLock(const MultiLock&) = delete;
+    MultiLock& operator=(const MultiLock&) = delete;
+    MultiLock(MultiLock&&) = default;
+    MultiLock& operator=(MultiLock&&) = default;
+
+    /**
+     * @brief Acesso ao recurso de uma posição do lote
+     * @param index Posição da chave no vetor passado a lock_many
+     * @return Referência para o recurso (só altere os pedidos com LockMode::Write)
+     */
+    T& operator[](size_t index) { return *resources[index]; }
+
+    /**
+     * @brief Retorna o número de chaves do lote
+     * @return Tamanho do vetor de chaves
+     */
+    size_t size() const { return resources.size(); }
+
+private:
+    template<typename Key, typename Resource, typename Hash>
+    friend class ResourceManager;
+
+    std::vector<ReadLock<T>> read_locks;        ///< Locks de leitura do lote
+    std::vector<WriteLock<T>> write_locks;      ///< Locks de escrita do lote
+    std::vector<T*> resources;                  ///< Recurso de cada posição do lote
 };
 
 // Implementações dos templates
+template<typename T>
+ReadLock<T>::ReadLock(std::shared_ptr<T> snapshot)
+    : resource(std::move(snapshot)) {}
+
 template<typename T>
 ReadLock<T>::ReadLock(std::shared_ptr<T> resource, std::shared_mutex& mutex)
     : resource(std::move(resource)), lock(mutex) {}
@@ -104,8 +198,42 @@ template<typename T>
 T* ReadLock<T>::operator->() { return resource.get(); }
 
 template<typename T>
-WriteLock<T>::WriteLock(std::shared_ptr<T> resource, std::shared_mutex& mutex)
-    : resource(std::move(resource)), lock(mutex) {}
+WriteLock<T>::WriteLock(std::shared_ptr<T> resource, std::shared_mutex& mutex,
+                        SharedResource<T>* owner)
+    : resource(std::move(resource)), lock(mutex), owner(owner) {
+    if (owner) {
+        owner->begin_write(this->resource);
+    }
+}
+
+template<typename T>
+WriteLock<T>::~WriteLock() {
+    publish();
+}
+
+template<typename T>
+WriteLock<T>::WriteLock(WriteLock&& other) noexcept
+    : resource(std::move(other.resource)), lock(std::move(other.lock)),
+      owner(std::exchange(other.owner, nullptr)) {}
+
+template<typename T>
+WriteLock<T>& WriteLock<T>::operator=(WriteLock&& other) noexcept {
+    if (this != &other) {
+        publish();
+        resource = std::move(other.resource);
+        lock = std::move(other.lock);
+        owner = std::exchange(other.owner, nullptr);
+    }
+    return *this;
+}
+
+template<typename T>
+void WriteLock<T>::publish() {
+    if (owner) {
+        owner->end_write();
+        owner = nullptr;
+    }
+}
 
 template<typename T>
 T& WriteLock<T>::operator*() { return *resource; }
@@ -1,12 +1,58 @@
 #ifndef RESOURCE_MANAGER_H
 #define RESOURCE_MANAGER_H
 
-#include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
-#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
 #include "shared_resource.h"
 #include "lock_types.h"
+#include "epoch.h"
+
+namespace detail {
+
+/**
+ * @brief Lança o erro de recurso não encontrado
+ * @param key Descrição da chave procurada
+ * @throws std::runtime_error sempre
+ */
+[[noreturn]] void throw_resource_not_found(const std::string& key);
+
+/**
+ * @brief Descreve uma chave genérica para mensagens de erro
+ * @param key Chave do recurso
+ * @return Texto da chave (strings e números), ou um marcador para outros tipos
+ */
+template<typename Key>
+std::string describe_key(const Key& key) {
+    if constexpr (std::is_convertible_v<const Key&, std::string>) {
+        return std::string(key);
+    } else if constexpr (std::is_arithmetic_v<Key>) {
+        return std::to_string(key);
+    } else {
+        return "<chave>";
+    }
+}
+
+/**
+ * @brief Espalha os bits de um hash (std::hash de inteiros é a identidade)
+ * @param hash Hash original
+ * @return Hash com os bits altos dependentes de todos os bits de entrada
+ */
+inline uint64_t mix_hash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+}
 
 /**
  * @class ResourceManager
@@ -14,14 +60,43 @@
  *
  * Gerencia múltiplos recursos com suporte a locks de leitura/escrita
  * e prevenção de deadlocks.
+ *
+ * A busca de uma chave não adquire lock nenhum: o mapa é uma tabela hash
+ * com encadeamento em que os ponteiros são atômicos, e os leitores a
+ * percorrem dentro de um EpochGuard. add_resource e remove_resource
+ * serializam-se pelo mutex do shard da chave e entregam os nós
+ * desligados ao EpochDomain, que só os apaga quando nenhum leitor em
+ * andamento pode mais alcançá-los. Só o lock do próprio recurso é
+ * adquirido no acesso, e os locks retornados mantêm o recurso vivo mesmo
+ * que ele seja removido do gerenciador.
+ *
+ * Cada recurso escolhe seu AccessMode ao ser adicionado. Em CopyOnWrite,
+ * get_snapshot() e get_read_access() devolvem a versão publicada sem lock
+ * nenhum, e get_write_access() altera uma cópia publicada quando o lock é
+ * liberado, sem bloquear os leitores.
+ *
+ * O mapa pode ser dividido em shards, cada um com sua tabela e seu mutex
+ * de escrita em linha de cache própria, escolhido pelo hash da chave, para
+ * que escritas em chaves diferentes não disputem o mesmo lock.
+ *
+ * @tparam Key Tipo da chave
+ * @tparam Resource Tipo do recurso
+ * @tparam Hash Hash da chave
  */
-template<typename Key, typename Resource>
+template<typename Key, typename Resource, typename Hash = std::hash<Key>>
 class ResourceManager {
 public:
+    static constexpr size_t DEFAULT_SHARDS = 64; ///< Sugestão de shards para o modo dividido
+
     /**
-     * @brief Construtor padrão
+     * @brief Construtor com o número de shards do mapa
+     * @param num_shards Número de sub-mapas (arredondado para potência de dois);
+     *                   1 mantém um único mapa com um único lock de escrita
      */
-    ResourceManager() = default;
+    explicit ResourceManager(size_t num_shards = 1);
+
+    ResourceManager(const ResourceManager&) = delete;
+    ResourceManager& operator=(const ResourceManager&) = delete;
 
     /**
      * @brief Obtém acesso de leitura a um recurso
@@ -37,12 +112,58 @@ public:
      */
     WriteLock<Resource> get_write_access(const Key& key);
 
+    /**
+     * @brief Lê uma cópia do recurso sem lock nenhum (seqlock)
+     *
+     * Para recursos pequenos e trivialmente copiáveis (contadores,
+     * configurações, estatísticas): a busca roda dentro do EpochGuard e a
+     * leitura é SharedResource::optimistic_read(), sem tocar o mutex do
+     * recurso nem sua contagem de referências.
+     *
+     * @param key Chave do recurso
+     * @return Cópia consistente do recurso
+     */
+    Resource optimistic_read(const Key& key) const;
+
+    /**
+     * @brief Obtém uma versão imutável do recurso
+     *
+     * Em recursos CopyOnWrite, a busca e a leitura da versão publicada não
+     * adquirem lock nem esperam escritores; em recursos Locked, é uma cópia
+     * feita com o lock de leitura.
+     *
+     * @param key Chave do recurso
+     * @return Versão do recurso, válida enquanto o ponteiro existir
+     */
+    std::shared_ptr<const Resource> get_snapshot(const Key& key) const;
+
+    /**
+     * @brief Adquire um lote de locks de leitura e escrita de uma vez, sem deadlock
+     *
+     * Todas as chaves são buscadas em uma única seção de leitura do mapa;
+     * se alguma não existe, nada é travado. Os locks são então adquiridos
+     * em ordem crescente de endereço do SharedResource, a mesma ordem
+     * global para qualquer lote, então dois lotes que se sobrepõem nunca
+     * esperam um pelo outro em ciclo. Chaves repetidas recebem um único
+     * lock (de escrita se algum pedido for de escrita). Não misture com um
+     * get_write_access já seguro pela mesma thread, que fica fora da ordem.
+     *
+     * @param keys Chaves do lote
+     * @param modes Tipo de lock de cada chave
+     * @return Guarda que libera todos os locks do lote
+     * @throws std::invalid_argument se keys e modes têm tamanhos diferentes
+     * @throws std::runtime_error se alguma chave não existe
+     */
+    MultiLock<Resource> lock_many(const std::vector<Key>& keys, const std::vector<LockMode>& modes);
+
     /**
      * @brief Adiciona um novo recurso ao gerenciador
      * @param key Chave do recurso
      * @param resource Recurso a ser adicionado
+     * @param mode Sincronização do recurso (Locked ou CopyOnWrite)
      */
-    void add_resource(const Key& key, std::shared_ptr<Resource> resource);
+    void add_resource(const Key& key, std::shared_ptr<Resource> resource,
+                      AccessMode mode = AccessMode::Locked);
 
     /**
      * @brief Remove um recurso do gerenciador
@@ -59,58 +180,349 @@ public:
 
     /**
      * @brief Retorna número de recursos gerenciados
+     *
+     * Trava o mutex de escrita de todos os shards, em ordem, antes de somar,
+     * então o total corresponde a um instante em que nenhuma inserção ou
+     * remoção estava em andamento e é coerente com contains().
+     *
      * @return Quantidade de recursos
      */
     size_t size() const;
 
+    /**
+     * @brief Retorna o número de shards do mapa
+     * @return Shards (potência de dois)
+     */
+    size_t shard_count() const;
+
 private:
-    mutable std::shared_mutex resources_mutex;  ///< Mutex para proteção do mapa
-    std::unordered_map<Key, std::shared_ptr<SharedResource<Resource>>> resources; ///< Mapa de recursos
+    using Entry = std::shared_ptr<SharedResource<Resource>>;
+
+    static constexpr size_t INITIAL_BUCKETS = 16; ///< Buckets iniciais de cada shard
+
+    /**
+     * @struct Node
+     * @brief Nó da tabela; chave e recurso não mudam depois de publicado
+     */
+    struct Node {
+        const Key key;                          ///< Chave do recurso
+        const Entry entry;                      ///< Recurso compartilhado
+        std::atomic<Node*> next;                ///< Próximo nó do bucket
+
+        Node(const Key& key, Entry entry, Node* next)
+            : key(key), entry(std::move(entry)), next(next) {}
+    };
+
+    /**
+     * @struct Table
+     * @brief Vetor de buckets; dono dos nós ainda encadeados nele
+     */
+    struct Table {
+        size_t mask;                            ///< Buckets - 1
+        std::unique_ptr<std::atomic<Node*>[]> buckets; ///< Listas de nós
+
+        explicit Table(size_t count)
+            : mask(count - 1), buckets(new std::atomic<Node*>[count]) {
+            for (size_t i = 0; i < count; ++i) {
+                buckets[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        ~Table() {
+            for (size_t i = 0; i <= mask; ++i) {
+                Node* node = buckets[i].load(std::memory_order_relaxed);
+                while (node) {
+                    Node* next = node->next.load(std::memory_order_relaxed);
+                    delete node;
+                    node = next;
+                }
+            }
+        }
+    };
+
+    /**
+     * @struct Shard
+     * @brief Parte do mapa com sua tabela e seu mutex de escrita, em linha de cache própria
+     */
+    struct alignas(64) Shard {
+        std::atomic<Table*> table{nullptr};     ///< Tabela atual (lida sem lock)
+        mutable std::mutex mutex;               ///< Serializa inserções e remoções
+        size_t count = 0;                       ///< Recursos do shard (protegido por mutex)
+
+        ~Shard() {
+            delete table.load(std::memory_order_relaxed);
+        }
+    };
+
+    Shard& shard_of(uint64_t hash) const {
+        return shards[hash & shard_mask];
+    }
+
+    static uint64_t hash_of(const Key& key) {
+        return detail::mix_hash(Hash{}(key));
+    }
+
+    static std::atomic<Node*>& bucket_of(Table& table, uint64_t hash) {
+        return table.buckets[(hash >> 32) & table.mask];
+    }
+
+    /**
+     * @brief Procura a chave sem lock (o chamador está dentro de um EpochGuard)
+     */
+    static Node* lookup(const Shard& shard, const Key& key, uint64_t hash);
+
+    /**
+     * @brief Busca o recurso sem lock do mapa (lança se não existe)
+     */
+    Entry find(const Key& key) const;
+
+    /**
+     * @brief Dobra a tabela do shard copiando os nós (com o mutex do shard)
+     *
+     * Os nós não são reencadeados no lugar, o que confundiria leitores
+     * percorrendo a tabela antiga: a nova tabela recebe cópias e a antiga
+     * é devolvida para ser retirada depois que o mutex for liberado.
+     *
+     * @return Tabela antiga, ainda alcançável por leitores em andamento
+     */
+    static Table* grow(Shard& shard);
+
+    std::unique_ptr<Shard[]> shards;            ///< Sub-mapas de recursos
+    size_t shard_mask;                          ///< Shards - 1
 };
 
 // Implementação do template
-template<typename Key, typename Resource>
-ReadLock<Resource> ResourceManager<Key, Resource>::get_read_access(const Key& key) {
-    std::shared_lock lock(resources_mutex);
-    auto it = resources.find(key);
-    if (it == resources.end()) {
-        throw std::runtime_error("Recurso não encontrado: " + std::to_string(key));
+template<typename Key, typename Resource, typename Hash>
+ResourceManager<Key, Resource, Hash>::ResourceManager(size_t num_shards) {
+    size_t count = 1;
+    while (count < num_shards) count <<= 1;
+    shards.reset(new Shard[count]);
+    shard_mask = count - 1;
+    for (size_t i = 0; i < count; ++i) {
+        shards[i].table.store(new Table(INITIAL_BUCKETS), std::memory_order_release);
+    }
+}
+
+template<typename Key, typename Resource, typename Hash>
+typename ResourceManager<Key, Resource, Hash>::Node*
+ResourceManager<Key, Resource, Hash>::lookup(const Shard& shard, const Key& key, uint64_t hash) {
+    Table* table = shard.table.load(std::memory_order_acquire);
+    Node* node = bucket_of(*table, hash).load(std::memory_order_acquire);
+    while (node && !(node->key == key)) {
+        node = node->next.load(std::memory_order_acquire);
+    }
+    return node;
+}
+
+template<typename Key, typename Resource, typename Hash>
+typename ResourceManager<Key, Resource, Hash>::Entry
+ResourceManager<Key, Resource, Hash>::find(const Key& key) const {
+    uint64_t hash = hash_of(key);
+    {
+        EpochGuard guard;
+        if (Node* node = lookup(shard_of(hash), key, hash)) {
+            return node->entry;
+        }
+    }
+    detail::throw_resource_not_found(detail::describe_key(key));
+}
+
+template<typename Key, typename Resource, typename Hash>
+ReadLock<Resource> ResourceManager<Key, Resource, Hash>::get_read_access(const Key& key) {
+    return find(key)->lock_read();
+}
+
+template<typename Key, typename Resource, typename Hash>
+WriteLock<Resource> ResourceManager<Key, Resource, Hash>::get_write_access(const Key& key) {
+    return find(key)->lock_write();
+}
+
+template<typename Key, typename Resource, typename Hash>
+Resource ResourceManager<Key, Resource, Hash>::optimistic_read(const Key& key) const {
+    uint64_t hash = hash_of(key);
+    {
+        EpochGuard guard;
+        if (Node* node = lookup(shard_of(hash), key, hash)) {
+            return node->entry->optimistic_read();
+        }
+    }
+    detail::throw_resource_not_found(detail::describe_key(key));
+}
+
+template<typename Key, typename Resource, typename Hash>
+std::shared_ptr<const Resource> ResourceManager<Key, Resource, Hash>::get_snapshot(const Key& key) const {
+    uint64_t hash = hash_of(key);
+    {
+        EpochGuard guard;
+        if (Node* node = lookup(shard_of(hash), key, hash)) {
+            return node->entry->snapshot();
+        }
+    }
+    detail::throw_resource_not_found(detail::describe_key(key));
+}
+
+template<typename Key, typename Resource, typename Hash>
+MultiLock<Resource> ResourceManager<Key, Resource, Hash>::lock_many(const std::vector<Key>& keys,
+                                                                  const std::vector<LockMode>& modes) {
+    if (keys.size() != modes.size()) {
+        throw std::invalid_argument("lock_many: keys e modes com tamanhos diferentes");
+    }
+
+    struct Request {
+        Entry entry;                            ///< Recurso pedido
+        LockMode mode;                          ///< Lock pedido
+        size_t index;                           ///< Posição em keys
+    };
+    std::vector<Request> requests;
+    requests.reserve(keys.size());
+    {
+        // Uma única seção de leitura do mapa para o lote inteiro
+        EpochGuard guard;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            uint64_t hash = hash_of(keys[i]);
+            Node* node = lookup(shard_of(hash), keys[i], hash);
+            if (!node) {
+                detail::throw_resource_not_found(detail::describe_key(keys[i]));
+            }
+            requests.push_back({node->entry, modes[i], i});
+        }
+    }
+
+    // Ordem global de aquisição: endereço do SharedResource
+    std::sort(requests.begin(), requests.end(), [](const Request& a, const Request& b) {
+        return std::less<SharedResource<Resource>*>()(a.entry.get(), b.entry.get());
+    });
+
+    MultiLock<Resource> batch;
+    batch.resources.resize(keys.size());
+    batch.read_locks.reserve(keys.size());
+    batch.write_locks.reserve(keys.size());
+    for (size_t begin = 0; begin < requests.size();) {
+        size_t end = begin;
+        LockMode mode = LockMode::Read;
+        while (end < requests.size() && requests[end].entry == requests[begin].entry) {
+            if (requests[end].mode == LockMode::Write) mode = LockMode::Write;
+            ++end;
+        }
+
+        Resource* resource;
+        if (mode == LockMode::Write) {
+            batch.write_locks.push_back(requests[begin].entry->lock_write());
+            resource = &*batch.write_locks.back();
+        } else {
+            batch.read_locks.push_back(requests[begin].entry->lock_read());
+            resource = &*batch.read_locks.back();
+        }
+        for (size_t i = begin; i < end; ++i) {
+            batch.resources[requests[i].index] = resource;
+        }
+        begin = end;
+    }
+    return batch;
+}
+
+template<typename Key, typename Resource, typename Hash>
+void ResourceManager<Key, Resource, Hash>::add_resource(const Key& key, std::shared_ptr<Resource> resource,
+                                                        AccessMode mode) {
+    auto entry = std::make_shared<SharedResource<Resource>>(std::move(resource), mode);
+    uint64_t hash = hash_of(key);
+    Shard& shard = shard_of(hash);
+    Node* replaced = nullptr;
+    Table* old_table = nullptr;
+    {
+        std::lock_guard lock(shard.mutex);
+        if (shard.count >= shard.table.load(std::memory_order_relaxed)->mask + 1) {
+            old_table = grow(shard);
+        }
+        std::atomic<Node*>* link = &bucket_of(*shard.table.load(std::memory_order_relaxed), hash);
+        Node* node = link->load(std::memory_order_relaxed);
+        while (node && !(node->key == key)) {
+            link = &node->next;
+            node = link->load(std::memory_order_relaxed);
+        }
+        if (node) {
+            // Substitui o nó inteiro: leitores veem o recurso antigo ou o novo
+            replaced = node;
+            link->store(new Node(key, std::move(entry), node->next.load(std::memory_order_relaxed)),
+                        std::memory_order_release);
+        } else {
+            link->store(new Node(key, std::move(entry), nullptr), std::memory_order_release);
+            ++shard.count;
+        }
+    }
+    // retire() pode rodar destrutores de recursos de qualquer gerenciador, que
+    // por sua vez podem adicionar ou remover recursos neste mesmo shard
+    if (old_table) {
+        EpochDomain::instance().retire(old_table);
+    }
+    if (replaced) {
+        EpochDomain::instance().retire(replaced);
     }
-    return it->second->lock_read();
 }
 
-template<typename Key, typename Resource>
-WriteLock<Resource> ResourceManager<Key, Resource>::get_write_access(const Key& key) {
-    std::shared_lock lock(resources_mutex);
-    auto it = resources.find(key);
-    if (it == resources.end()) {
-        throw std::runtime_error("Recurso não encontrado: " + std::to_string(key));
+template<typename Key, typename Resource, typename Hash>
+void ResourceManager<Key, Resource, Hash>::remove_resource(const Key& key) {
+    uint64_t hash = hash_of(key);
+    Shard& shard = shard_of(hash);
+    Node* removed = nullptr;
+    {
+        std::lock_guard lock(shard.mutex);
+        std::atomic<Node*>* link = &bucket_of(*shard.table.load(std::memory_order_relaxed), hash);
+        Node* node = link->load(std::memory_order_relaxed);
+        while (node && !(node->key == key)) {
+            link = &node->next;
+            node = link->load(std::memory_order_relaxed);
+        }
+        if (!node) return;
+        // O nó removido mantém seu next: um leitor parado nele continua a lista
+        link->store(node->next.load(std::memory_order_relaxed), std::memory_order_release);
+        --shard.count;
+        removed = node;
     }
-    return it->second->lock_write();
+    EpochDomain::instance().retire(removed);
 }
 
-template<typename Key, typename Resource>
-void ResourceManager<Key, Resource>::add_resource(const Key& key, std::shared_ptr<Resource> resource) {
-    std::unique_lock lock(resources_mutex);
-    resources[key] = std::make_shared<SharedResource<Resource>>(resource);
+template<typename Key, typename Resource, typename Hash>
+typename ResourceManager<Key, Resource, Hash>::Table*
+ResourceManager<Key, Resource, Hash>::grow(Shard& shard) {
+    Table* old_table = shard.table.load(std::memory_order_relaxed);
+    Table* new_table = new Table((old_table->mask + 1) * 2);
+    for (size_t i = 0; i <= old_table->mask; ++i) {
+        for (Node* node = old_table->buckets[i].load(std::memory_order_relaxed); node;
+             node = node->next.load(std::memory_order_relaxed)) {
+            uint64_t hash = hash_of(node->key);
+            auto& bucket = bucket_of(*new_table, hash);
+            bucket.store(new Node(node->key, node->entry, bucket.load(std::memory_order_relaxed)),
+                         std::memory_order_relaxed);
+        }
+    }
+    shard.table.store(new_table, std::memory_order_release);
+    return old_table;
 }
 
-template<typename Key, typename Resource>
-void ResourceManager<Key, Resource>::remove_resource(const Key& key) {
-    std::unique_lock lock(resources_mutex);
-    resources.erase(key);
+template<typename Key, typename Resource, typename Hash>
+bool ResourceManager<Key, Resource, Hash>::contains(const Key& key) const {
+    uint64_t hash = hash_of(key);
+    EpochGuard guard;
+    return lookup(shard_of(hash), key, hash) != nullptr;
 }
 
-template<typename Key, typename Resource>
-bool ResourceManager<Key, Resource>::contains(const Key& key) const {
-    std::shared_lock lock(resources_mutex);
-    return resources.find(key) != resources.end();
+template<typename Key, typename Resource, typename Hash>
+size_t ResourceManager<Key, Resource, Hash>::size() const {
+    // Escritores travam um único shard, então travar todos em ordem não causa deadlock
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(shard_mask + 1);
+    size_t total = 0;
+    for (size_t i = 0; i <= shard_mask; ++i) {
+        locks.emplace_back(shards[i].mutex);
+        total += shards[i].count;
+    }
+    return total;
 }
 
-template<typename Key, typename Resource>
-size_t ResourceManager<Key, Resource>::size() const {
-    std::shared_lock lock(resources_mutex);
-    return resources.size();
+template<typename Key, typename Resource, typename Hash>
+size_t ResourceManager<Key, Resource, Hash>::shard_count() const {
+    return shard_mask + 1;
 }
 
 #endif
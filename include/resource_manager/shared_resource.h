@@ -1,25 +1,96 @@
 #ifndef SHARED_RESOURCE_H
 #define SHARED_RESOURCE_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <new>
 #include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include "lock_types.h"
+#include "epoch.h"
+
+namespace detail {
+
+/**
+ * @brief Copia bytes que um escritor pode estar alterando (leitura do seqlock)
+ *
+ * A cópia pode ler um valor rasgado; quem chama a descarta se a versão
+ * mudou. As leituras são atômicas relaxadas, palavra a palavra quando o
+ * endereço permite, para o compilador não as fundir nem trocar por memcpy,
+ * e a função fica fora da instrumentação do ThreadSanitizer, que apontaria
+ * como corrida justamente a sobreposição que a validação descarta.
+ *
+ * @param destination Buffer de destino
+ * @param source Recurso lido
+ * @param size Bytes a copiar
+ */
+#if defined(__GNUC__)
+__attribute__((no_sanitize("thread")))
+inline void seqlock_copy(void* destination, const void* source, size_t size) {
+    auto* out = static_cast<unsigned char*>(destination);
+    const auto* in = static_cast<const unsigned char*>(source);
+    size_t offset = 0;
+    if (reinterpret_cast<uintptr_t>(in) % alignof(uint64_t) == 0) {
+        for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+            uint64_t word = __atomic_load_n(reinterpret_cast<const uint64_t*>(in + offset), __ATOMIC_RELAXED);
+            std::memcpy(out + offset, &word, sizeof(word));
+        }
+    }
+    for (; offset < size; ++offset) {
+        out[offset] = __atomic_load_n(in + offset, __ATOMIC_RELAXED);
+    }
+}
+#else
+inline void seqlock_copy(void* destination, const void* source, size_t size) {
+    std::memcpy(destination, source, size);
+}
+#endif
+
+}
 
 /**
  * @class SharedResource
  * @brief Recurso compartilhado com controle de acesso leitura/escrita
  *
  * Encapsula um recurso com suporte a múltiplos leitores ou um único escritor
- * usando shared_mutex.
+ * usando shared_mutex. Quando o SharedResource pertence a um shared_ptr
+ * (como no ResourceManager), os locks retornados o mantêm vivo, então
+ * remover o recurso do gerenciador não destrói o mutex de um lock ativo.
+ *
+ * Recursos pequenos e trivialmente copiáveis também podem ser lidos sem
+ * lock por optimistic_read() (seqlock): o leitor lê a versão, copia o
+ * valor e confere a versão de novo, sem nenhuma escrita em memória
+ * compartilhada. Cada WriteLock incrementa a versão ao começar e ao
+ * terminar; o leitor só repete a cópia quando uma escrita se sobrepôs.
+ *
+ * Em AccessMode::CopyOnWrite (recursos grandes e lidos quase sempre, como
+ * tabelas de rotas e árvores de configuração), o recurso é uma sequência
+ * de versões imutáveis: snapshot() e lock_read() pegam a versão atual sem
+ * lock, e o WriteLock altera uma cópia privada, publicada atomicamente na
+ * liberação. Leitores nunca esperam um escritor, mesmo que ele demore para
+ * reconstruir o recurso; escritores continuam serializados pelo mutex.
+ * Cada versão é liberada quando o último leitor que a segura a solta.
  */
 template<typename T>
-class SharedResource {
+class SharedResource : public std::enable_shared_from_this<SharedResource<T>> {
 public:
     /**
      * @brief Construtor com recurso a ser gerenciado
      * @param resource Recurso a ser compartilhado
+     * @param mode Sincronização de leitores e escritores
+     * @throws std::logic_error se CopyOnWrite e o recurso não é copiável
      */
-    explicit SharedResource(std::shared_ptr<T> resource);
+    explicit SharedResource(std::shared_ptr<T> resource, AccessMode mode = AccessMode::Locked);
+
+    /**
+     * @brief Destrutor que libera a versão publicada
+     */
+    ~SharedResource();
 
     /**
      * @brief Obtém lock de leitura para o recurso
@@ -33,34 +104,205 @@ public:
      */
     WriteLock<T> lock_write();
 
+    /**
+     * @brief Lê uma cópia do recurso sem adquirir lock (seqlock)
+     *
+     * Repete a cópia enquanto uma escrita se sobrepõe a ela; depois de
+     * OPTIMISTIC_ATTEMPTS tentativas, copia com o lock de leitura para não
+     * ficar preso sob escritas contínuas. Escritas feitas por get() em vez
+     * de lock_write() não são vistas pela validação.
+     *
+     * @return Cópia consistente do recurso
+     */
+    T optimistic_read() const;
+
+    /**
+     * @brief Obtém uma versão imutável do recurso
+     *
+     * Em CopyOnWrite, é a versão publicada, obtida sem lock e sem esperar
+     * escritores; em Locked, é uma cópia feita com o lock de leitura.
+     *
+     * @return Versão do recurso, válida enquanto o ponteiro existir
+     * @throws std::logic_error se Locked e o recurso não é copiável
+     */
+    std::shared_ptr<const T> snapshot() const;
+
+    /**
+     * @brief Retorna o modo de acesso do recurso
+     * @return Modo escolhido na construção
+     */
+    AccessMode mode() const;
+
     /**
      * @brief Acesso direto ao recurso (sem locking - uso interno)
-     * @return Ponteiro para o recurso
+     * @return Ponteiro para o recurso (em CopyOnWrite, a versão atual)
      */
     std::shared_ptr<T> get();
 
 private:
-    std::shared_ptr<T> resource;                ///< Recurso gerenciado
-    std::shared_mutex mutex;                    ///< Mutex para controle de acesso
+    friend class WriteLock<T>;
+
+    /**
+     * @struct Version
+     * @brief Versão publicada em CopyOnWrite (retirada pelo EpochDomain)
+     */
+    struct Version {
+        std::shared_ptr<T> value;               ///< Conteúdo imutável da versão
+    };
+
+    /**
+     * @brief Ponteiro para o recurso que também mantém este SharedResource vivo
+     */
+    std::shared_ptr<T> pinned();
+
+    /**
+     * @brief Versão publicada atual, lida sem lock (CopyOnWrite)
+     */
+    std::shared_ptr<T> current() const;
+
+    /**
+     * @brief Início da escrita (com o lock): seqlock ímpar ou cópia privada
+     * @param target Ponteiro do WriteLock, redirecionado para a cópia em CopyOnWrite
+     */
+    void begin_write(std::shared_ptr<T>& target);
+
+    /**
+     * @brief Fim da escrita (ainda com o lock): seqlock par ou publicação da cópia
+     */
+    void end_write();
+
+    static constexpr int OPTIMISTIC_ATTEMPTS = 64; ///< Tentativas antes do lock de leitura
+
+    const AccessMode access_mode;               ///< Modo de acesso
+    std::shared_ptr<T> resource;                ///< Recurso gerenciado (Locked)
+    std::atomic<Version*> published{nullptr};   ///< Versão atual (CopyOnWrite)
+    std::shared_ptr<T> draft;                   ///< Cópia do escritor ativo (CopyOnWrite)
+    mutable std::shared_mutex mutex;            ///< Mutex para controle de acesso
+    alignas(64) std::atomic<uint64_t> version{0}; ///< Versão do seqlock (ímpar durante escrita)
 };
 
 // Implementação do template
 template<typename T>
-SharedResource<T>::SharedResource(std::shared_ptr<T> resource)
-    : resource(std::move(resource)) {}
+SharedResource<T>::SharedResource(std::shared_ptr<T> resource, AccessMode mode)
+    : access_mode(mode) {
+    if (mode == AccessMode::CopyOnWrite) {
+        if constexpr (!std::is_copy_constructible_v<T>) {
+            throw std::logic_error("AccessMode::CopyOnWrite requer recurso copiável");
+        }
+        published.store(new Version{std::move(resource)}, std::memory_order_release);
+    } else {
+        this->resource = std::move(resource);
+    }
+}
+
+template<typename T>
+SharedResource<T>::~SharedResource() {
+    delete published.load(std::memory_order_relaxed);
+}
 
 template<typename T>
 ReadLock<T> SharedResource<T>::lock_read() {
-    return ReadLock<T>(resource, mutex);
+    if (access_mode == AccessMode::CopyOnWrite) {
+        return ReadLock<T>(current());
+    }
+    return ReadLock<T>(pinned(), mutex);
 }
 
 template<typename T>
 WriteLock<T> SharedResource<T>::lock_write() {
-    return WriteLock<T>(resource, mutex);
+    return WriteLock<T>(pinned(), mutex, this);
+}
+
+template<typename T>
+T SharedResource<T>::optimistic_read() const {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "optimistic_read requer recurso trivialmente copiável");
+
+    if (access_mode == AccessMode::CopyOnWrite) {
+        return *current();
+    }
+
+    alignas(T) unsigned char buffer[sizeof(T)];
+    for (int attempt = 0; attempt < OPTIMISTIC_ATTEMPTS; ++attempt) {
+        uint64_t before = version.load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+            detail::seqlock_copy(buffer, resource.get(), sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (version.load(std::memory_order_relaxed) == before) {
+                return *std::launder(reinterpret_cast<T*>(buffer));
+            }
+        }
+        if (attempt >= OPTIMISTIC_ATTEMPTS / 2) {
+            std::this_thread::yield();
+        }
+    }
+    std::shared_lock lock(mutex);
+    return *resource;
+}
+
+template<typename T>
+std::shared_ptr<const T> SharedResource<T>::snapshot() const {
+    if (access_mode == AccessMode::CopyOnWrite) {
+        return current();
+    }
+    if constexpr (std::is_copy_constructible_v<T>) {
+        std::shared_lock lock(mutex);
+        return std::make_shared<const T>(*resource);
+    } else {
+        throw std::logic_error("snapshot requer recurso copiável");
+    }
+}
+
+template<typename T>
+AccessMode SharedResource<T>::mode() const {
+    return access_mode;
+}
+
+template<typename T>
+std::shared_ptr<T> SharedResource<T>::current() const {
+    // A versão só é apagada depois que nenhum leitor dentro da época pode vê-la
+    EpochGuard guard;
+    return published.load(std::memory_order_acquire)->value;
+}
+
+template<typename T>
+void SharedResource<T>::begin_write(std::shared_ptr<T>& target) {
+    if (access_mode == AccessMode::CopyOnWrite) {
+        if constexpr (std::is_copy_constructible_v<T>) {
+            draft = std::make_shared<T>(*published.load(std::memory_order_relaxed)->value);
+        }
+        // Mesmo dono do ponteiro original (que mantém este SharedResource vivo), apontando para a cópia
+        target = std::shared_ptr<T>(std::move(target), draft.get());
+        return;
+    }
+    // Ímpar antes de qualquer escrita no recurso
+    version.store(version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+template<typename T>
+void SharedResource<T>::end_write() {
+    if (access_mode == AccessMode::CopyOnWrite) {
+        Version* previous = published.exchange(new Version{std::move(draft)}, std::memory_order_acq_rel);
+        EpochDomain::instance().retire(previous);
+        return;
+    }
+    version.store(version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template<typename T>
+std::shared_ptr<T> SharedResource<T>::pinned() {
+    if (auto self = this->weak_from_this().lock()) {
+        return std::shared_ptr<T>(std::move(self), resource.get());
+    }
+    return resource;
 }
 
 template<typename T>
 std::shared_ptr<T> SharedResource<T>::get() {
+    if (access_mode == AccessMode::CopyOnWrite) {
+        return current();
+    }
     return resource;
 }
 
@@ -0,0 +1,296 @@
+#ifndef ASYNC_TASK_H
+#define ASYNC_TASK_H
+
+#include "thread_pool.h"
+
+#ifdef THREAD_POOL_HAS_COROUTINES
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "slab_pool.h"
+
+template<class T = void>
+class AsyncTask;
+
+namespace detail {
+
+/**
+ * @struct AsyncPromiseBase
+ * @brief Parte do promise comum a AsyncTask<T> e AsyncTask<void>
+ *
+ * O quadro da corrotina vem do SlabPool; ao terminar, a corrotina
+ * transfere o controle diretamente para quem a aguardava (symmetric
+ * transfer), sem passar pela fila nem crescer a pilha.
+ */
+struct AsyncPromiseBase {
+    /**
+     * @struct FinalAwaiter
+     * @brief Retoma a continuação no ponto final de suspensão
+     */
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template<class Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            std::coroutine_handle<> continuation = handle.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    static void* operator new(size_t size) {
+        return SlabPool::allocate(size);
+    }
+
+    static void operator delete(void* pointer, size_t size) noexcept {
+        SlabPool::deallocate(pointer, size);
+    }
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept {
+        error = std::current_exception();
+    }
+
+    std::coroutine_handle<> continuation;       ///< Corrotina que aguarda o resultado
+    std::exception_ptr error;                   ///< Exceção que escapou do corpo
+};
+
+/**
+ * @struct AsyncPromise
+ * @brief Promise com armazenamento do resultado
+ */
+template<class T>
+struct AsyncPromise : AsyncPromiseBase {
+    template<class U>
+    void return_value(U&& value) {
+        result.emplace(std::forward<U>(value));
+    }
+
+    /**
+     * @brief Entrega o resultado ou relança a exceção do corpo
+     */
+    T take() {
+        if (error) std::rethrow_exception(error);
+        return std::move(*result);
+    }
+
+    std::optional<T> result;                    ///< Valor de co_return
+};
+
+template<>
+struct AsyncPromise<void> : AsyncPromiseBase {
+    void return_void() noexcept {}
+
+    void take() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+}
+
+/**
+ * @class AsyncTask
+ * @brief Corrotina preguiçosa que produz um T
+ *
+ * Só começa quando aguardada (co_await) ou passada a sync_wait, e executa na
+ * thread de quem a iniciou até encontrar um co_await pool.schedule(). Aguardar
+ * uma AsyncTask não enfileira nada: a continuação é retomada diretamente
+ * quando o corpo termina. Exceções do corpo são relançadas em quem aguarda.
+ * @tparam T Tipo do resultado (void se não há resultado)
+ */
+template<class T>
+class AsyncTask {
+public:
+    /**
+     * @struct promise_type
+     * @brief Promise exigido pelo compilador
+     */
+    struct promise_type : detail::AsyncPromise<T> {
+        AsyncTask get_return_object() noexcept {
+            return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+    AsyncTask(AsyncTask&& other) noexcept
+        : handle(std::exchange(other.handle, {})) {}
+
+    AsyncTask& operator=(AsyncTask&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+
+    AsyncTask(const AsyncTask&) = delete;
+    AsyncTask& operator=(const AsyncTask&) = delete;
+
+    /**
+     * @brief Destrói o quadro da corrotina (que não pode estar em execução)
+     */
+    ~AsyncTask() {
+        if (handle) handle.destroy();
+    }
+
+    bool await_ready() const noexcept {
+        return !handle || handle.done();
+    }
+
+    /**
+     * @brief Inicia o corpo, que retoma awaiting ao terminar
+     */
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume() {
+        return handle.promise().take();
+    }
+
+private:
+    explicit AsyncTask(std::coroutine_handle<promise_type> handle) noexcept
+        : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle; ///< Quadro da corrotina
+};
+
+namespace detail {
+
+/**
+ * @struct SyncWaitState
+ * @brief Sinal de término usado por sync_wait
+ */
+struct SyncWaitState {
+    /**
+     * @brief Marca o término e acorda a thread bloqueada
+     */
+    void set() {
+        // Notifica com o lock: a thread acordada destrói este estado
+        std::lock_guard lock(mutex);
+        done = true;
+        condition.notify_one();
+    }
+
+    /**
+     * @brief Bloqueia até set()
+     */
+    void wait() {
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [this]() { return done; });
+    }
+
+    std::mutex mutex;                           ///< Protege done
+    std::condition_variable condition;          ///< Sinaliza o término
+    bool done = false;                          ///< A corrotina terminou
+};
+
+/**
+ * @class SyncWaitTask
+ * @brief Corrotina auxiliar que aguarda uma AsyncTask e sinaliza sync_wait
+ */
+class SyncWaitTask {
+public:
+    struct promise_type {
+        /**
+         * @struct FinalAwaiter
+         * @brief Sinaliza só depois que o quadro está suspenso
+         */
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                handle.promise().state->set();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        SyncWaitTask get_return_object() noexcept {
+            return SyncWaitTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        SyncWaitState* state = nullptr;         ///< Sinal de quem espera
+    };
+
+    explicit SyncWaitTask(std::coroutine_handle<promise_type> handle) noexcept
+        : handle(handle) {}
+
+    SyncWaitTask(const SyncWaitTask&) = delete;
+    SyncWaitTask& operator=(const SyncWaitTask&) = delete;
+
+    ~SyncWaitTask() {
+        if (handle) handle.destroy();
+    }
+
+    /**
+     * @brief Inicia a corrotina e bloqueia até ela terminar
+     */
+    void run(SyncWaitState& state) {
+        handle.promise().state = &state;
+        handle.resume();
+        state.wait();
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle; ///< Quadro da corrotina auxiliar
+};
+
+/**
+ * @brief Aguarda task e guarda o resultado (ou a exceção)
+ */
+template<class T, class Result>
+SyncWaitTask make_sync_wait(AsyncTask<T>& task, Result& result, std::exception_ptr& error) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            (void)result;
+            co_await task;
+        } else {
+            result.emplace(co_await task);
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+}
+
+}
+
+/**
+ * @brief Executa uma AsyncTask até o fim, bloqueando a thread chamadora
+ *
+ * Ponte entre código comum e corrotinas. Não deve ser chamada de dentro de
+ * um worker do pool onde a tarefa continua, pois ocuparia esse worker.
+ * @param task Tarefa a executar
+ * @return Resultado da tarefa
+ * @throws Exceção lançada pelo corpo da tarefa
+ */
+template<class T>
+T sync_wait(AsyncTask<T> task) {
+    std::conditional_t<std::is_void_v<T>, bool, std::optional<T>> result{};
+    std::exception_ptr error;
+    detail::SyncWaitState state;
+
+    detail::make_sync_wait(task, result, error).run(state);
+
+    if (error) std::rethrow_exception(error);
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*result);
+    }
+}
+
+#endif
+
+#endif
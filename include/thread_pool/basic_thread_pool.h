@@ -0,0 +1,165 @@
+#ifndef BASIC_THREAD_POOL_H
+#define BASIC_THREAD_POOL_H
+
+#include <atomic>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "pool_policies.h"
+
+/**
+ * @class BasicThreadPool
+ * @brief Pool de threads enxuto com fila, espera e tarefa escolhidas em compilação
+ *
+ * A fila é membro do pool (sem shared_ptr nem chamadas virtuais) e o laço do
+ * worker, a espera e a invocação da tarefa são instanciados para as
+ * políticas escolhidas, então o caminho quente pode ser todo inlinado. Em
+ * troca, oferece só o núcleo: execute e submit com uma classe de prioridade,
+ * número fixo de threads e nenhuma métrica, rastreamento ou espera
+ * cooperativa. Para essas funções, use ThreadPool, que continua sendo o pool
+ * configurável em tempo de execução (ThreadPoolOptions).
+ *
+ * @tparam QueuePolicy MutexQueuePolicy ou RingQueuePolicy<N>
+ * @tparam WaitPolicy ParkWaitPolicy, SpinThenParkWaitPolicy<S, Y> ou SpinWaitPolicy
+ * @tparam TaskPolicy InlineTaskPolicy ou FunctionTaskPolicy
+ */
+template<class QueuePolicy = MutexQueuePolicy,
+         class WaitPolicy = ParkWaitPolicy,
+         class TaskPolicy = InlineTaskPolicy>
+class BasicThreadPool {
+public:
+    using Task = typename TaskPolicy::Task;
+    using Queue = typename QueuePolicy::template Queue<Task>;
+
+    /**
+     * @brief Construtor que inicia as threads
+     * @param num_threads Número de threads (padrão: número de cores hardware)
+     */
+    explicit BasicThreadPool(size_t num_threads = std::thread::hardware_concurrency()) {
+        if (num_threads == 0) num_threads = 1;
+        threads.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i) {
+            threads.emplace_back([this]() { run(); });
+        }
+    }
+
+    /**
+     * @brief Destrutor que executa as tarefas pendentes e junta as threads
+     */
+    ~BasicThreadPool() {
+        stopping.store(true, std::memory_order_release);
+        idle.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    BasicThreadPool(const BasicThreadPool&) = delete;
+    BasicThreadPool& operator=(const BasicThreadPool&) = delete;
+
+    /**
+     * @brief Enfileira uma tarefa sem future (exceções são registradas e descartadas)
+     * @param f Função sem argumentos
+     * @throws std::runtime_error se o pool está parando
+     */
+    template<class F>
+    void execute(F&& f) {
+        push(TaskPolicy::make(std::forward<F>(f)));
+    }
+
+    /**
+     * @brief Submete uma tarefa e retorna o future do resultado
+     * @param f Função a ser executada
+     * @param args Argumentos para a função
+     * @return Future com o resultado
+     * @throws std::runtime_error se o pool está parando
+     */
+    template<class F, class... Args>
+    auto submit(F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<F, Args...>> {
+
+        using return_type = std::invoke_result_t<F, Args...>;
+
+        std::promise<return_type> promise(std::allocator_arg, PoolAllocator<return_type>());
+        std::future<return_type> result = promise.get_future();
+
+        push(TaskPolicy::make([promise = std::move(promise),
+                               function = std::forward<F>(f),
+                               arguments = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+            try {
+                if constexpr (std::is_void_v<return_type>) {
+                    std::apply(function, arguments);
+                    promise.set_value();
+                } else {
+                    promise.set_value(std::apply(function, arguments));
+                }
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        }));
+        return result;
+    }
+
+    /**
+     * @brief Retorna o número de threads
+     * @return Threads do pool
+     */
+    size_t size() const {
+        return threads.size();
+    }
+
+private:
+    /**
+     * @brief Publica a tarefa; com a fila cheia, cede a vez até haver espaço
+     */
+    void push(Task task) {
+        while (true) {
+            if (stopping.load(std::memory_order_acquire)) {
+                throw std::runtime_error("BasicThreadPool está parado, não pode aceitar tarefas");
+            }
+            if (queue.try_push(task)) break;
+            std::this_thread::yield();
+        }
+        if constexpr (WaitPolicy::parks) {
+            idle.notify_one();
+        }
+    }
+
+    /**
+     * @brief Laço do worker: fila, espera e tarefa resolvidas em compilação
+     */
+    void run() {
+        auto try_pop = [this](Task& task) { return queue.try_pop(task); };
+        Task task;
+        while (true) {
+            if (!try_pop(task) &&
+                !WaitPolicy::wait(idle,
+                                  [&]() { return try_pop(task); },
+                                  [this]() { return stopping.load(std::memory_order_acquire); })) {
+                return;  // Parado e sem tarefas
+            }
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cerr << "Exceção em BasicThreadPool: " << e.what() << std::endl;
+            }
+            task = nullptr;
+        }
+    }
+
+    Queue queue;                                ///< Fila de tarefas (membro, sem indireção)
+    EventCount idle;                            ///< Espera dos workers ociosos
+    std::atomic<bool> stopping{false};          ///< Flag de parada
+    std::vector<std::thread> threads;           ///< Threads do pool
+};
+
+/**
+ * @brief Instância equivalente ao ThreadPool padrão (fila com mutex, dorme sem trabalho, InlineTask)
+ */
+using DefaultThreadPool = BasicThreadPool<MutexQueuePolicy, ParkWaitPolicy, InlineTaskPolicy>;
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef CANCELLATION_H
+#define CANCELLATION_H
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+/**
+ * @class TaskCancelledError
+ * @brief Entregue no future de uma tarefa cancelada antes de começar
+ */
+class TaskCancelledError : public std::runtime_error {
+public:
+    TaskCancelledError() : std::runtime_error("Tarefa cancelada antes de executar") {}
+};
+
+namespace detail {
+
+/**
+ * @struct CancellationState
+ * @brief Flag de cancelamento de um grupo, opcionalmente ligada a um grupo pai
+ */
+struct CancellationState {
+    std::atomic<bool> cancelled{false};         ///< Grupo cancelado
+    std::shared_ptr<CancellationState> parent;  ///< Grupo que, cancelado, cancela este
+};
+
+}
+
+/**
+ * @class CancellationToken
+ * @brief Visão somente leitura do cancelamento de um grupo de tarefas
+ *
+ * Cópias são baratas e podem ser capturadas pela tarefa para consultar o
+ * cancelamento durante a execução. Um token padrão nunca é cancelado.
+ */
+class CancellationToken {
+public:
+    /**
+     * @brief Construtor de um token que nunca é cancelado
+     */
+    CancellationToken() noexcept = default;
+
+    /**
+     * @brief Verifica se o grupo (ou algum grupo pai) foi cancelado
+     * @return true se cancelado
+     */
+    bool cancelled() const noexcept {
+        for (const detail::CancellationState* group = state.get(); group; group = group->parent.get()) {
+            if (group->cancelled.load(std::memory_order_acquire)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Lança TaskCancelledError se o grupo foi cancelado
+     * @throws TaskCancelledError se cancelado
+     */
+    void throw_if_cancelled() const;
+
+    /**
+     * @brief Verifica se o token está ligado a alguma CancellationSource
+     * @return false para o token padrão
+     */
+    bool can_be_cancelled() const noexcept {
+        return state != nullptr;
+    }
+
+private:
+    friend class CancellationSource;
+
+    explicit CancellationToken(std::shared_ptr<detail::CancellationState> state) noexcept
+        : state(std::move(state)) {}
+
+    std::shared_ptr<detail::CancellationState> state; ///< Grupo observado
+};
+
+/**
+ * @class CancellationSource
+ * @brief Dono de um grupo de tarefas canceláveis
+ *
+ * Todas as tarefas submetidas com token() pertencem ao grupo; cancel()
+ * cancela o grupo inteiro de uma vez. Tarefas que ainda não começaram são
+ * descartadas pelo worker sem executar o corpo; as que já executam veem
+ * cancelled() no token que capturaram e decidem quando parar. Um grupo
+ * criado a partir do token de outro é cancelado junto com ele.
+ */
+class CancellationSource {
+public:
+    /**
+     * @brief Construtor de um grupo independente
+     */
+    CancellationSource();
+
+    /**
+     * @brief Construtor de um subgrupo cancelado também pelo grupo de parent
+     * @param parent Token do grupo pai
+     */
+    explicit CancellationSource(const CancellationToken& parent);
+
+    /**
+     * @brief Retorna um token do grupo
+     * @return Token observando este grupo
+     */
+    CancellationToken token() const noexcept;
+
+    /**
+     * @brief Cancela o grupo (e seus subgrupos); chamadas repetidas não têm efeito
+     */
+    void cancel() noexcept;
+
+    /**
+     * @brief Verifica se o grupo foi cancelado (diretamente ou pelo pai)
+     * @return true se cancelado
+     */
+    bool cancelled() const noexcept;
+
+private:
+    std::shared_ptr<detail::CancellationState> state; ///< Grupo
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef CPU_TOPOLOGY_H
+#define CPU_TOPOLOGY_H
+
+#include <string>
+#include <vector>
+#include "thread_pool_options.h"
+
+/**
+ * @struct CpuInfo
+ * @brief Posição de uma CPU lógica na topologia da máquina
+ */
+struct CpuInfo {
+    int id = 0;                                 ///< Número da CPU lógica
+    int package = 0;                            ///< Soquete físico
+    int core = 0;                               ///< Núcleo físico dentro do soquete
+    int smt_rank = 0;                           ///< 0 para a primeira thread do núcleo, 1+ para irmãs SMT
+    size_t llc = 0;                             ///< Domínio de último nível de cache (índice denso)
+};
+
+/**
+ * @class CpuTopology
+ * @brief Topologia de CPUs lida de /sys: núcleos, irmãs SMT e domínios de LLC
+ *
+ * Sem /sys (ou fora do Linux) assume hardware_concurrency CPUs, cada uma em
+ * seu próprio núcleo e todas no mesmo domínio de LLC.
+ */
+class CpuTopology {
+public:
+    /**
+     * @brief Lê a topologia das CPUs online
+     * @param sysfs_root Diretório equivalente a /sys/devices/system/cpu
+     * @return Topologia detectada
+     */
+    static CpuTopology detect(const std::string& sysfs_root = "/sys/devices/system/cpu");
+
+    /**
+     * @brief Interpreta uma lista de CPUs no formato do kernel ("0-3,8,10-11")
+     * @param text Texto da lista
+     * @return CPUs em ordem crescente
+     */
+    static std::vector<int> parse_cpu_list(const std::string& text);
+
+    /**
+     * @brief Retorna as CPUs online
+     * @return CPUs em ordem crescente de id
+     */
+    const std::vector<CpuInfo>& cpus() const;
+
+    /**
+     * @brief Retorna o número de núcleos físicos
+     * @return Número de pares (soquete, núcleo) distintos
+     */
+    size_t num_cores() const;
+
+    /**
+     * @brief Retorna o número de domínios de LLC
+     * @return Número de domínios
+     */
+    size_t num_llc_domains() const;
+
+    /**
+     * @brief Retorna o domínio de LLC de uma CPU
+     * @param cpu Número da CPU lógica
+     * @return Índice do domínio, ou 0 se a CPU é desconhecida
+     */
+    size_t llc_domain(int cpu) const;
+
+    /**
+     * @brief Retorna as CPUs lógicas que dividem o núcleo físico de uma CPU
+     * @param cpu Número da CPU lógica
+     * @return Irmãs SMT, incluindo a própria CPU
+     */
+    std::vector<int> smt_siblings(int cpu) const;
+
+    /**
+     * @brief Ordena CPUs para fixação de workers
+     *
+     * Compact preenche um domínio de LLC por vez; Scatter alterna entre
+     * domínios. Nos dois casos núcleos físicos vêm antes das irmãs SMT.
+     * @param mode Modo de fixação (None retorna lista vazia)
+     * @param allowed CPUs permitidas (vazio: todas as online)
+     * @return CPU para o worker i na posição i (circular)
+     */
+    std::vector<int> placement(AffinityMode mode, const std::vector<int>& allowed = {}) const;
+
+private:
+    std::vector<CpuInfo> cpu_list;              ///< CPUs online
+    size_t llc_count = 1;                       ///< Número de domínios de LLC
+};
+
+#endif
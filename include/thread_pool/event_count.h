@@ -0,0 +1,83 @@
+#ifndef EVENT_COUNT_H
+#define EVENT_COUNT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#if !defined(__linux__)
+#include <mutex>
+#include <condition_variable>
+#endif
+
+/**
+ * @class EventCount
+ * @brief Ponto de espera no estilo futex para workers ociosos
+ *
+ * Quem espera anuncia a intenção com prepare_wait, verifica de novo se há
+ * trabalho e só então dorme com wait. Quem notifica publica o trabalho e
+ * chama notify, que não faz nenhuma chamada de sistema se ninguém anunciou
+ * espera. No Linux dorme direto no futex da época; nas demais plataformas
+ * usa mutex e variável de condição.
+ */
+class EventCount {
+public:
+    using Key = uint32_t;
+
+    /**
+     * @brief Anuncia que a thread vai dormir
+     * @return Chave a passar para wait (ou descartar com cancel_wait)
+     */
+    Key prepare_wait();
+
+    /**
+     * @brief Desiste da espera anunciada (achou trabalho na nova verificação)
+     */
+    void cancel_wait();
+
+    /**
+     * @brief Dorme até alguma notificação posterior a prepare_wait
+     * @param key Chave retornada por prepare_wait
+     */
+    void wait(Key key);
+
+    /**
+     * @brief Dorme até uma notificação ou até o timeout
+     * @param key Chave retornada por prepare_wait
+     * @param timeout Tempo máximo de espera
+     * @return true se notificado, false se o prazo expirou
+     */
+    bool wait_for(Key key, std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief Acorda até count threads adormecidas
+     * @param count Número de threads que têm trabalho para fazer
+     */
+    void notify(size_t count);
+
+    /**
+     * @brief Acorda uma thread adormecida, se houver
+     */
+    void notify_one();
+
+    /**
+     * @brief Acorda todas as threads adormecidas
+     */
+    void notify_all();
+
+    /**
+     * @brief Retorna o número de threads entre prepare_wait e o despertar
+     * @return Número de threads esperando
+     */
+    size_t waiters() const;
+
+private:
+    alignas(64) std::atomic<Key> epoch{0};      ///< Época, incrementada a cada notificação útil
+    std::atomic<uint32_t> waiting{0};           ///< Threads que anunciaram espera
+#if !defined(__linux__)
+    std::mutex mutex;                           ///< Mutex para dormir (sem futex)
+    std::condition_variable condition;          ///< Variável de condição (sem futex)
+#endif
+};
+
+#endif
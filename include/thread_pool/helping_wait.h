@@ -0,0 +1,97 @@
+#ifndef HELPING_WAIT_H
+#define HELPING_WAIT_H
+
+#include <chrono>
+#include <future>
+
+/**
+ * @class HelpingWait
+ * @brief Espera cooperativa: um worker bloqueado em um resultado executa outras tarefas
+ *
+ * Uma tarefa que espera o resultado de outra tarefa do mesmo pool ocupa um
+ * worker; com aninhamento suficiente (divisão e conquista recursiva) todos
+ * os workers ficam esperando e o pool trava. Chamada de uma thread worker,
+ * a espera tira tarefas da fila do worker e as executa até a dependência
+ * ficar pronta; sem tarefa disponível, recua com yield e sleeps curtos. Fora
+ * de um worker, quem chama usa a espera bloqueante comum.
+ *
+ * JoinHandle::wait()/get() e TaskFuture::wait()/get() já esperam assim;
+ * para std::future, use HelpingWait::get(future).
+ */
+class HelpingWait {
+public:
+    /**
+     * @brief Verifica se a thread corrente é um worker de algum ThreadPool
+     * @return true dentro de um worker
+     */
+    static bool in_worker() noexcept;
+
+    /**
+     * @brief Executa uma tarefa pendente do worker corrente
+     * @return true se executou uma tarefa (false fora de um worker)
+     */
+    static bool run_one();
+
+    /**
+     * @brief Executa tarefas pendentes até done() retornar true
+     *
+     * Só deve ser chamada de um worker (in_worker()).
+     * @param done Predicado de conclusão, consultado entre tarefas
+     */
+    template<class Predicate>
+    static void until(Predicate&& done);
+
+    /**
+     * @brief Espera um std::future ajudando o pool, se chamado de um worker
+     * @param future Future a ser esperado
+     */
+    template<class T>
+    static void wait(const std::future<T>& future);
+
+    /**
+     * @brief Espera um std::future ajudando o pool e retorna o resultado
+     * @param future Future consumido
+     * @return Valor da tarefa (relança a exceção dela)
+     */
+    template<class T>
+    static T get(std::future<T>& future);
+
+private:
+    /**
+     * @brief Recua quando não há tarefa para executar
+     * @param round Rodadas seguidas sem tarefa
+     */
+    static void back_off(unsigned round);
+};
+
+// Implementação dos templates
+template<class Predicate>
+void HelpingWait::until(Predicate&& done) {
+    unsigned idle_rounds = 0;
+    while (!done()) {
+        if (run_one()) {
+            idle_rounds = 0;
+        } else {
+            back_off(idle_rounds++);
+        }
+    }
+}
+
+template<class T>
+void HelpingWait::wait(const std::future<T>& future) {
+    if (!in_worker()) {
+        future.wait();
+        return;
+    }
+    until([&future]() {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+}
+
+template<class T>
+T HelpingWait::get(std::future<T>& future) {
+    wait(future);
+    return future.get();
+}
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef INLINE_TASK_H
+#define INLINE_TASK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <functional>
+#include <utility>
+
+/**
+ * @class InlineTask
+ * @brief Tarefa move-only com armazenamento inline (small-buffer)
+ *
+ * Substitui std::function<void()> nas filas: callables de até
+ * INLINE_CAPACITY bytes, com move noexcept, são guardados dentro do próprio
+ * objeto, sem alocação. Callables maiores caem para o heap. O objeto ocupa
+ * exatamente uma linha de cache (64 bytes), incluindo o instante em que a
+ * tarefa entrou na fila, usado pelas métricas de espera dos workers.
+ */
+class InlineTask {
+public:
+    static constexpr size_t INLINE_CAPACITY = 48; ///< Bytes disponíveis para o callable
+
+    /**
+     * @brief Construtor padrão (tarefa vazia)
+     */
+    InlineTask() noexcept = default;
+
+    /**
+     * @brief Construtor de tarefa vazia a partir de nullptr
+     */
+    InlineTask(std::nullptr_t) noexcept {}
+
+    /**
+     * @brief Construtor a partir de qualquer callable void()
+     * @param function Callable a ser armazenado
+     */
+    template<class F, class = std::enable_if_t<
+        !std::is_same_v<std::decay_t<F>, InlineTask> &&
+        !std::is_same_v<std::decay_t<F>, std::nullptr_t>>>
+    InlineTask(F&& function);
+
+    /**
+     * @brief Construtor de movimento
+     */
+    InlineTask(InlineTask&& other) noexcept;
+
+    /**
+     * @brief Atribuição por movimento
+     */
+    InlineTask& operator=(InlineTask&& other) noexcept;
+
+    /**
+     * @brief Esvazia a tarefa
+     */
+    InlineTask& operator=(std::nullptr_t) noexcept;
+
+    // Não copiável, apenas movível
+    InlineTask(const InlineTask&) = delete;
+    InlineTask& operator=(const InlineTask&) = delete;
+
+    /**
+     * @brief Destrutor que destrói o callable armazenado
+     */
+    ~InlineTask();
+
+    /**
+     * @brief Executa o callable
+     * @throws std::bad_function_call se a tarefa estiver vazia
+     */
+    void operator()();
+
+    /**
+     * @brief Verifica se há callable armazenado
+     * @return true se não vazia
+     */
+    explicit operator bool() const noexcept;
+
+    /**
+     * @brief Registra o instante em que a tarefa entrou na fila
+     * @param nanoseconds Instante em ns de steady_clock (0: não medido)
+     */
+    void stamp(int64_t nanoseconds) noexcept { enqueued_at = nanoseconds; }
+
+    /**
+     * @brief Retorna o instante registrado por stamp()
+     * @return Instante em ns de steady_clock, ou 0 se a tarefa não foi marcada
+     */
+    int64_t enqueued() const noexcept { return enqueued_at; }
+
+    /**
+     * @brief Verifica se um callable do tipo F é armazenado sem alocação
+     * @return true se cabe no buffer inline
+     */
+    template<class F>
+    static constexpr bool fits_inline();
+
+private:
+    /**
+     * @struct Operations
+     * @brief Tabela de operações do tipo apagado
+     */
+    struct Operations {
+        void (*invoke)(void* storage);
+        void (*relocate)(void* destination, void* source) noexcept; ///< Move e destrói a origem
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template<class F>
+    struct InlineOperations;
+
+    template<class F>
+    struct HeapOperations;
+
+    /**
+     * @brief Destrói o callable e esvazia a tarefa
+     */
+    void reset() noexcept;
+
+    alignas(std::max_align_t) unsigned char storage[INLINE_CAPACITY]; ///< Buffer do callable
+    const Operations* operations = nullptr;     ///< Operações do tipo armazenado
+    int64_t enqueued_at = 0;                    ///< Entrada na fila em ns de steady_clock (0: não medido)
+};
+
+// Implementações dos templates
+template<class F>
+struct InlineTask::InlineOperations {
+    static void invoke(void* storage) {
+        (*static_cast<F*>(storage))();
+    }
+    static void relocate(void* destination, void* source) noexcept {
+        F* from = static_cast<F*>(source);
+        ::new (destination) F(std::move(*from));
+        from->~F();
+    }
+    static void destroy(void* storage) noexcept {
+        static_cast<F*>(storage)->~F();
+    }
+    static constexpr Operations table{&invoke, &relocate, &destroy};
+};
+
+template<class F>
+struct InlineTask::HeapOperations {
+    static F*& pointer(void* storage) {
+        return *static_cast<F**>(storage);
+    }
+    static void invoke(void* storage) {
+        (*pointer(storage))();
+    }
+    static void relocate(void* destination, void* source) noexcept {
+        ::new (destination) F*(pointer(source));
+    }
+    static void destroy(void* storage) noexcept {
+        delete pointer(storage);
+    }
+    static constexpr Operations table{&invoke, &relocate, &destroy};
+};
+
+template<class F>
+constexpr bool InlineTask::fits_inline() {
+    return sizeof(F) <= INLINE_CAPACITY &&
+           alignof(F) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<F>;
+}
+
+template<class F, class>
+InlineTask::InlineTask(F&& function) {
+    using Callable = std::decay_t<F>;
+    if constexpr (fits_inline<Callable>()) {
+        ::new (static_cast<void*>(storage)) Callable(std::forward<F>(function));
+        operations = &InlineOperations<Callable>::table;
+    } else {
+        ::new (static_cast<void*>(storage)) Callable*(new Callable(std::forward<F>(function)));
+        operations = &HeapOperations<Callable>::table;
+    }
+}
+
+inline InlineTask::InlineTask(InlineTask&& other) noexcept
+    : operations(other.operations)
+    , enqueued_at(other.enqueued_at) {
+    if (operations) {
+        operations->relocate(storage, other.storage);
+        other.operations = nullptr;
+    }
+}
+
+inline InlineTask& InlineTask::operator=(InlineTask&& other) noexcept {
+    if (this != &other) {
+        reset();
+        if (other.operations) {
+            other.operations->relocate(storage, other.storage);
+            operations = other.operations;
+            other.operations = nullptr;
+        }
+        enqueued_at = other.enqueued_at;
+    }
+    return *this;
+}
+
+inline InlineTask& InlineTask::operator=(std::nullptr_t) noexcept {
+    reset();
+    enqueued_at = 0;
+    return *this;
+}
+
+inline InlineTask::~InlineTask() {
+    reset();
+}
+
+inline void InlineTask::operator()() {
+    if (!operations) {
+        throw std::bad_function_call();
+    }
+    operations->invoke(storage);
+}
+
+inline InlineTask::operator bool() const noexcept {
+    return operations != nullptr;
+}
+
+inline void InlineTask::reset() noexcept {
+    if (operations) {
+        operations->destroy(storage);
+        operations = nullptr;
+    }
+}
+
+#endif
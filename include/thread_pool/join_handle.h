@@ -0,0 +1,120 @@
+#ifndef JOIN_HANDLE_H
+#define JOIN_HANDLE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+/**
+ * @class JoinHandle
+ * @brief Handle único para aguardar um lote de tarefas
+ *
+ * Retornado por ThreadPool::submit_bulk e ThreadPool::parallel_for no lugar
+ * de N std::futures. Guarda a primeira exceção lançada por qualquer parte
+ * do lote e a relança em get(). Chamados de um worker, wait() e get()
+ * executam outras tarefas do pool enquanto esperam (HelpingWait).
+ */
+class JoinHandle {
+public:
+    /**
+     * @class State
+     * @brief Estado compartilhado entre o handle e as partes do lote
+     */
+    class State {
+    public:
+        /**
+         * @brief Construtor com o número de partes pendentes
+         * @param parts Número de partes do lote
+         */
+        explicit State(size_t parts);
+
+        /**
+         * @brief Marca uma parte como concluída
+         */
+        void complete();
+
+        /**
+         * @brief Registra falha de uma parte (apenas a primeira é guardada)
+         * @param error Exceção capturada
+         */
+        void fail(std::exception_ptr error);
+
+        /**
+         * @brief Verifica se alguma parte falhou
+         * @return true se houve falha
+         */
+        bool failed() const;
+
+        /**
+         * @brief Verifica se todas as partes terminaram
+         * @return true se concluído
+         */
+        bool done() const;
+
+    private:
+        friend class JoinHandle;
+
+        std::atomic<size_t> remaining;          ///< Partes ainda em execução
+        std::atomic<bool> has_error{false};     ///< Indica falha em alguma parte
+        std::exception_ptr error;               ///< Primeira exceção registrada
+        std::mutex mutex;                       ///< Mutex para espera
+        std::condition_variable condition;      ///< Sinaliza conclusão do lote
+    };
+
+    /**
+     * @brief Construtor padrão (handle vazio, já concluído)
+     */
+    JoinHandle() = default;
+
+    /**
+     * @brief Construtor para um lote com número de partes dado
+     * @param parts Número de partes do lote
+     */
+    explicit JoinHandle(size_t parts);
+
+    /**
+     * @brief Espera todas as partes terminarem (não relança exceções)
+     */
+    void wait() const;
+
+    /**
+     * @brief Espera com timeout
+     * @param timeout Tempo máximo de espera
+     * @return true se o lote terminou dentro do prazo
+     */
+    template<class Rep, class Period>
+    bool wait_for(const std::chrono::duration<Rep, Period>& timeout) const;
+
+    /**
+     * @brief Espera o lote e relança a primeira exceção, se houver
+     */
+    void get() const;
+
+    /**
+     * @brief Verifica, sem bloquear, se o lote terminou
+     * @return true se concluído
+     */
+    bool ready() const;
+
+    /**
+     * @brief Acesso ao estado compartilhado (usado pelas partes do lote)
+     * @return Estado do lote
+     */
+    const std::shared_ptr<State>& shared_state() const;
+
+private:
+    std::shared_ptr<State> state;               ///< Estado compartilhado (nulo se vazio)
+};
+
+// Implementação do template
+template<class Rep, class Period>
+bool JoinHandle::wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+    if (!state) return true;
+    std::unique_lock lock(state->mutex);
+    return state->condition.wait_for(lock, timeout, [this]() { return state->done(); });
+}
+
+#endif
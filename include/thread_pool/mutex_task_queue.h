@@ -0,0 +1,141 @@
+#ifndef MUTEX_TASK_QUEUE_H
+#define MUTEX_TASK_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include "task_queue.h"
+#include "slab_pool.h"
+
+/**
+ * @class MutexTaskQueue
+ * @brief Fila de tarefas protegida por mutex, com níveis de prioridade
+ *
+ * Implementa uma fila bloqueante que permite produção e consumo seguro
+ * de tarefas entre múltiplas threads. Cada TaskPriority tem sua própria
+ * fila FIFO; pop compara apenas as cabeças dos níveis, tratando cada nível
+ * abaixo de High como se tivesse chegado um limite de aging mais tarde.
+ * Assim High passa à frente, mas uma tarefa Low que esperou mais que dois
+ * limites acaba servida (evita starvation). Com capacidade, push espera
+ * por espaço enquanto a fila estiver cheia.
+ */
+class MutexTaskQueue : public TaskQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Construtor com limite de aging e capacidade
+     * @param aging_threshold Atraso efetivo aplicado por nível abaixo de High
+     * @param capacity Máximo de tarefas na fila (0: ilimitada)
+     */
+    explicit MutexTaskQueue(Clock::duration aging_threshold = std::chrono::milliseconds(10),
+                            size_t capacity = 0);
+
+    bool push(Task task) override;
+
+    /**
+     * @brief Adiciona uma tarefa no nível de prioridade indicado
+     * @param task Tarefa a ser adicionada
+     * @param priority Classe de prioridade
+     * @return true se bem-sucedido, false se a fila está parada
+     */
+    bool push(Task task, TaskPriority priority) override;
+
+    /**
+     * @brief Adiciona um lote sob um único lock, acordando só os workers necessários
+     *
+     * Com a fila limitada, publica o que couber e espera espaço para o resto.
+     * @param tasks Tarefas a serem adicionadas (o vetor é esvaziado)
+     * @return true se bem-sucedido, false se a fila está parada
+     */
+    bool push_bulk(std::vector<Task>& tasks) override;
+    bool try_push(Task& task, TaskPriority priority) override;
+    bool push_for(Task& task, TaskPriority priority, std::chrono::nanoseconds timeout) override;
+    bool pop(Task& task) override;
+    bool try_pop(Task& task) override;
+
+    /**
+     * @brief Remove a tarefa mais antiga do nível menos urgente não vazio
+     * @param task Referência para armazenar a tarefa removida
+     * @return true se removeu, false se a fila está vazia
+     */
+    bool pop_oldest(Task& task) override;
+
+    /**
+     * @brief Remove até max tarefas da fila sem bloquear, sob um único lock
+     * @param tasks Vetor ao qual as tarefas removidas são anexadas
+     * @param max Número máximo de tarefas a remover
+     * @return Número de tarefas removidas
+     */
+    size_t try_pop_bulk(std::vector<Task>& tasks, size_t max) override;
+
+    void stop() override;
+    bool stopped() const override;
+
+    /**
+     * @brief Retorna o tamanho atual da fila (sem travar)
+     * @return Número de tarefas em todos os níveis
+     */
+    size_t size() const override;
+
+    /**
+     * @brief Retorna a profundidade de um nível de prioridade (sem travar)
+     * @param priority Classe de prioridade
+     * @return Número de tarefas no nível
+     */
+    size_t size(TaskPriority priority) const override;
+    size_t capacity() const override;
+
+private:
+    /**
+     * @struct Entry
+     * @brief Tarefa enfileirada com o instante de entrada (para aging)
+     */
+    struct Entry {
+        Task task;                              ///< Tarefa
+        Clock::time_point enqueued;             ///< Instante do enfileiramento
+    };
+
+    using Level = std::deque<Entry, PoolAllocator<Entry>>;
+
+    /**
+     * @brief Verifica se todos os níveis estão vazios (requer lock)
+     */
+    bool empty() const;
+
+    /**
+     * @brief Verifica se a fila atingiu a capacidade (requer lock)
+     */
+    bool full() const;
+
+    /**
+     * @brief Insere no nível indicado (requer lock e espaço)
+     */
+    void insert(size_t index, Task& task, Clock::time_point now);
+
+    /**
+     * @brief Remove a cabeça de um nível (requer lock e nível não vazio)
+     */
+    void remove(size_t index, Task& task);
+
+    /**
+     * @brief Remove a próxima tarefa segundo prioridade e aging (requer lock e fila não vazia)
+     */
+    void take(Task& task);
+
+    mutable std::mutex mutex;                   ///< Mutex para sincronização
+    std::condition_variable condition;          ///< Variável de condição para espera
+    std::condition_variable not_full;           ///< Sinaliza espaço para produtores
+    std::array<Level, NUM_TASK_PRIORITIES> levels; ///< Uma fila FIFO por prioridade
+    std::array<std::atomic<size_t>, NUM_TASK_PRIORITIES> depth{}; ///< Profundidade publicada por nível
+    const Clock::duration aging_threshold;      ///< Atraso efetivo por nível abaixo de High
+    const size_t limit;                         ///< Capacidade (0: ilimitada)
+    size_t waiting;                             ///< Consumidores bloqueados em pop
+    size_t producers_waiting;                   ///< Produtores esperando espaço
+    bool stop_flag;                             ///< Flag de parada
+};
+
+#endif
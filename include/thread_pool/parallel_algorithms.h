@@ -0,0 +1,300 @@
+#ifndef PARALLEL_ALGORITHMS_H
+#define PARALLEL_ALGORITHMS_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "thread_pool.h"
+
+/**
+ * @file parallel_algorithms.h
+ * @brief Algoritmos paralelos sobre ThreadPool: reduce, transform, sort e scan
+ *
+ * Todos recebem iteradores de acesso aleatório, bloqueiam a thread chamadora
+ * até o fim e relançam a primeira exceção de um elemento. O trabalho é
+ * dividido com ThreadPool::parallel_chunks (blocos grandes no início, nunca
+ * menores que grain no fim); resultados parciais ficam em slots alinhados a
+ * linha de cache, um por pedaço, sem falso compartilhamento. Chamados de
+ * dentro de um worker, a espera pelo JoinHandle executa tarefas pendentes
+ * do pool em vez de bloquear o worker, então podem ser aninhados em tarefas.
+ */
+
+namespace detail {
+
+/**
+ * @struct PaddedSlot
+ * @brief Acumulador parcial isolado em sua própria linha de cache
+ */
+template<class T>
+struct alignas(64) PaddedSlot {
+    std::optional<T> value;                     ///< Resultado parcial (vazio se o pedaço não recebeu trabalho)
+};
+
+/**
+ * @brief Grão padrão: ao menos 1024 elementos e cerca de 8 blocos por worker
+ */
+inline size_t default_grain(const ThreadPool& pool, size_t count) {
+    size_t workers = std::max<size_t>(pool.size(), 1);
+    return std::max<size_t>(1024, count / (8 * workers));
+}
+
+/**
+ * @brief Número de pedaços para count elementos com o grão dado
+ */
+inline size_t part_count(const ThreadPool& pool, size_t count, size_t grain) {
+    size_t chunks = (count + grain - 1) / grain;
+    return std::max<size_t>(1, std::min(chunks, std::max<size_t>(pool.size(), 1)));
+}
+
+/**
+ * @brief Posição de corte do merge path
+ *
+ * Retorna quantos elementos de [a, a + na) estão entre os primeiros
+ * diagonal elementos do merge estável de a com b (empates vêm de a).
+ */
+template<class It, class Compare>
+size_t merge_split(It a, size_t na, It b, size_t nb, size_t diagonal, Compare& comp) {
+    size_t low = diagonal > nb ? diagonal - nb : 0;
+    size_t high = std::min(diagonal, na);
+    while (low < high) {
+        size_t i = low + (high - low) / 2;
+        size_t j = diagonal - i;
+        // a[i] vem antes de b[j - 1]: o corte precisa de mais elementos de a
+        if (j > 0 && !comp(b[j - 1], a[i])) {
+            low = i + 1;
+        } else {
+            high = i;
+        }
+    }
+    return low;
+}
+
+}
+
+/**
+ * @brief Reduz [first, last) com op a partir de init, em paralelo
+ *
+ * Como std::reduce, op deve ser associativa e comutativa: os blocos são
+ * combinados fora de ordem.
+ * @param pool Pool onde a redução executa
+ * @param first Início do range
+ * @param last Fim do range
+ * @param init Valor inicial (entra uma única vez)
+ * @param op Operação binária
+ * @param grain Menor bloco (0: automático)
+ * @return op(init, todos os elementos)
+ */
+template<class It, class T, class BinaryOp = std::plus<>>
+T parallel_reduce(ThreadPool& pool, It first, It last, T init, BinaryOp op = BinaryOp(), size_t grain = 0) {
+    size_t count = static_cast<size_t>(std::distance(first, last));
+    if (count == 0) return init;
+    grain = grain ? grain : detail::default_grain(pool, count);
+    size_t parts = detail::part_count(pool, count, grain);
+
+    std::vector<detail::PaddedSlot<T>> partials(parts);
+    pool.parallel_chunks(size_t{0}, count, grain, parts, [&](size_t part, size_t lo, size_t hi) {
+        auto& slot = partials[part].value;
+        It it = first + static_cast<typename std::iterator_traits<It>::difference_type>(lo);
+        size_t i = lo;
+        if (!slot) {
+            slot.emplace(*it);
+            ++it;
+            ++i;
+        }
+        for (; i < hi; ++i, ++it) {
+            *slot = op(std::move(*slot), *it);
+        }
+    }).get();
+
+    T result = std::move(init);
+    for (auto& partial : partials) {
+        if (partial.value) result = op(std::move(result), std::move(*partial.value));
+    }
+    return result;
+}
+
+/**
+ * @brief Aplica op a cada elemento de [first, last) gravando em d_first, em paralelo
+ * @param pool Pool onde a transformação executa
+ * @param first Início do range de entrada
+ * @param last Fim do range de entrada
+ * @param d_first Início do range de saída (pode ser igual a first)
+ * @param op Operação unária
+ * @param grain Menor bloco (0: automático)
+ * @return Iterador após o último elemento escrito
+ */
+template<class It, class Out, class UnaryOp>
+Out parallel_transform(ThreadPool& pool, It first, It last, Out d_first, UnaryOp op, size_t grain = 0) {
+    size_t count = static_cast<size_t>(std::distance(first, last));
+    if (count == 0) return d_first;
+    grain = grain ? grain : detail::default_grain(pool, count);
+
+    using InDiff = typename std::iterator_traits<It>::difference_type;
+    using OutDiff = typename std::iterator_traits<Out>::difference_type;
+    pool.parallel_chunks(size_t{0}, count, grain, 0, [&](size_t, size_t lo, size_t hi) {
+        std::transform(first + static_cast<InDiff>(lo), first + static_cast<InDiff>(hi),
+                       d_first + static_cast<OutDiff>(lo), op);
+    }).get();
+    return d_first + static_cast<OutDiff>(count);
+}
+
+/**
+ * @brief Soma prefixada inclusiva de [first, last) em d_first, em paralelo
+ *
+ * Como std::inclusive_scan: op deve ser associativa. Duas passadas sobre
+ * blocos de tamanho fixo: a primeira reduz cada bloco, a varredura dos
+ * totais de bloco é sequencial (poucos blocos) e a segunda reescreve cada
+ * bloco a partir do seu deslocamento.
+ * @param pool Pool onde a varredura executa
+ * @param first Início do range de entrada
+ * @param last Fim do range de entrada
+ * @param d_first Início do range de saída (pode ser igual a first)
+ * @param op Operação binária associativa
+ * @param grain Tamanho dos blocos (0: automático)
+ * @return Iterador após o último elemento escrito
+ */
+template<class It, class Out, class BinaryOp = std::plus<>>
+Out parallel_scan(ThreadPool& pool, It first, It last, Out d_first, BinaryOp op = BinaryOp(), size_t grain = 0) {
+    using T = typename std::iterator_traits<It>::value_type;
+    using InDiff = typename std::iterator_traits<It>::difference_type;
+    using OutDiff = typename std::iterator_traits<Out>::difference_type;
+
+    size_t count = static_cast<size_t>(std::distance(first, last));
+    if (count == 0) return d_first;
+    grain = grain ? grain : detail::default_grain(pool, count);
+    size_t blocks = (count + grain - 1) / grain;
+    if (blocks == 1) return std::inclusive_scan(first, last, d_first, op);
+
+    // Passada 1: total de cada bloco (os blocos são a unidade de trabalho)
+    std::vector<detail::PaddedSlot<T>> totals(blocks);
+    pool.parallel_for(size_t{0}, blocks, 1, [&](size_t block) {
+        size_t lo = block * grain;
+        size_t hi = std::min(count, lo + grain);
+        It it = first + static_cast<InDiff>(lo);
+        T sum = *it;
+        for (size_t i = lo + 1; i < hi; ++i) {
+            sum = op(std::move(sum), *++it);
+        }
+        totals[block].value.emplace(std::move(sum));
+    }).get();
+
+    // Deslocamento de cada bloco = varredura exclusiva dos totais
+    for (size_t block = 1; block < blocks; ++block) {
+        *totals[block].value = op(*totals[block - 1].value, std::move(*totals[block].value));
+    }
+
+    // Passada 2: cada bloco parte do total acumulado dos anteriores
+    pool.parallel_for(size_t{0}, blocks, 1, [&](size_t block) {
+        size_t lo = block * grain;
+        size_t hi = std::min(count, lo + grain);
+        It in = first + static_cast<InDiff>(lo);
+        Out out = d_first + static_cast<OutDiff>(lo);
+        if (block == 0) {
+            std::inclusive_scan(in, first + static_cast<InDiff>(hi), out, op);
+        } else {
+            std::inclusive_scan(in, first + static_cast<InDiff>(hi), out, op, *totals[block - 1].value);
+        }
+    }).get();
+    return d_first + static_cast<OutDiff>(count);
+}
+
+/**
+ * @brief Ordena [first, last) em paralelo (merge sort com merge path)
+ *
+ * Ordena um bloco por pedaço com std::sort e intercala os blocos em rodadas.
+ * Cada intercalação é dividida pelo merge path em partes independentes,
+ * então todas as rodadas, inclusive a última, usam todos os workers. Não é
+ * estável entre elementos equivalentes. Requer tipo movível e construível
+ * por padrão (buffer auxiliar de mesmo tamanho).
+ * @param pool Pool onde a ordenação executa
+ * @param first Início do range
+ * @param last Fim do range
+ * @param comp Comparação estrita
+ * @param grain Menor bloco ordenado sequencialmente (0: automático)
+ */
+template<class It, class Compare = std::less<>>
+void parallel_sort(ThreadPool& pool, It first, It last, Compare comp = Compare(), size_t grain = 0) {
+    using T = typename std::iterator_traits<It>::value_type;
+    using Diff = typename std::iterator_traits<It>::difference_type;
+
+    size_t count = static_cast<size_t>(std::distance(first, last));
+    grain = grain ? grain : std::max<size_t>(detail::default_grain(pool, count), 4096);
+    size_t workers = std::max<size_t>(pool.size(), 1);
+    if (count <= grain || workers == 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    // Blocos em potência de dois: cada rodada junta pares vizinhos
+    size_t blocks = 1;
+    while (blocks < workers && count / (blocks * 2) >= grain) {
+        blocks *= 2;
+    }
+    auto bound = [count, blocks](size_t block) { return count * block / blocks; };
+
+    pool.parallel_for(size_t{0}, blocks, 1, [&](size_t block) {
+        std::sort(first + static_cast<Diff>(bound(block)), first + static_cast<Diff>(bound(block + 1)), comp);
+    }).get();
+
+    std::vector<T> buffer(count);
+    bool in_buffer = false;                     // Onde estão os dados ordenados da rodada
+    for (size_t width = 1; width < blocks; width *= 2) {
+        size_t pairs = blocks / (2 * width);
+        size_t pieces = std::max<size_t>(1, workers / pairs);
+
+        auto merge_round = [&](auto source, auto target) {
+            // Cortes calculados antes de mover qualquer elemento: a busca de
+            // um trecho lê elementos que outro trecho move
+            std::vector<size_t> splits(pairs * (pieces + 1));
+            pool.parallel_for(size_t{0}, splits.size(), 1, [&](size_t index) {
+                size_t pair = index / (pieces + 1);
+                size_t piece = index % (pieces + 1);
+                size_t lo = bound(pair * 2 * width);
+                size_t mid = bound(pair * 2 * width + width);
+                size_t hi = bound((pair + 1) * 2 * width);
+                splits[index] = detail::merge_split(source + static_cast<Diff>(lo), mid - lo,
+                                                    source + static_cast<Diff>(mid), hi - mid,
+                                                    (hi - lo) * piece / pieces, comp);
+            }).get();
+
+            pool.parallel_for(size_t{0}, pairs * pieces, 1, [&](size_t task) {
+                size_t pair = task / pieces;
+                size_t piece = task % pieces;
+                size_t lo = bound(pair * 2 * width);
+                size_t mid = bound(pair * 2 * width + width);
+                size_t hi = bound((pair + 1) * 2 * width);
+
+                // Trecho [d0, d1) da saída desta intercalação
+                size_t d0 = (hi - lo) * piece / pieces;
+                size_t d1 = (hi - lo) * (piece + 1) / pieces;
+                size_t i0 = splits[pair * (pieces + 1) + piece];
+                size_t i1 = splits[pair * (pieces + 1) + piece + 1];
+                auto a = source + static_cast<Diff>(lo);
+                auto b = source + static_cast<Diff>(mid);
+                std::merge(std::make_move_iterator(a + static_cast<Diff>(i0)),
+                           std::make_move_iterator(a + static_cast<Diff>(i1)),
+                           std::make_move_iterator(b + static_cast<Diff>(d0 - i0)),
+                           std::make_move_iterator(b + static_cast<Diff>(d1 - i1)),
+                           target + static_cast<Diff>(lo + d0), comp);
+            }).get();
+        };
+
+        if (in_buffer) {
+            merge_round(buffer.begin(), first);
+        } else {
+            merge_round(first, buffer.begin());
+        }
+        in_buffer = !in_buffer;
+    }
+
+    if (in_buffer) {
+        parallel_transform(pool, buffer.begin(), buffer.end(), first, [](T& value) { return std::move(value); });
+    }
+}
+
+#endif
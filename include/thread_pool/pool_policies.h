@@ -0,0 +1,269 @@
+#ifndef POOL_POLICIES_H
+#define POOL_POLICIES_H
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "event_count.h"
+#include "inline_task.h"
+#include "slab_pool.h"
+
+/**
+ * Políticas do BasicThreadPool, resolvidas em tempo de compilação.
+ *
+ * QueuePolicy::Queue<Task> guarda as tarefas: try_push(Task&) move a tarefa
+ * só em caso de sucesso, try_pop(Task&) não bloqueia (e deve ser barato com
+ * a fila vazia, pois as esperas ativas o chamam em laço) e empty() é uma
+ * leitura sem lock. WaitPolicy::wait() decide como um worker sem trabalho
+ * espera, e WaitPolicy::parks indica se algum worker pode estar dormindo no
+ * EventCount. TaskPolicy::Task é o tipo apagado da tarefa e
+ * TaskPolicy::make() o constrói a partir de um callable.
+ */
+
+namespace detail {
+
+/**
+ * @brief Dica de espera ativa para o processador
+ */
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+}
+
+/**
+ * @struct MutexQueuePolicy
+ * @brief Fila ilimitada protegida por mutex (equivalente à MutexTaskQueue sem prioridades)
+ */
+struct MutexQueuePolicy {
+    template<class Task>
+    class Queue {
+    public:
+        bool try_push(Task& task) {
+            std::lock_guard lock(mutex);
+            tasks.push_back(std::move(task));
+            count.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_pop(Task& task) {
+            if (empty()) return false;
+            std::lock_guard lock(mutex);
+            if (tasks.empty()) return false;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            count.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool empty() const {
+            return count.load(std::memory_order_acquire) == 0;
+        }
+
+    private:
+        std::mutex mutex;                       ///< Protege tasks
+        std::deque<Task, PoolAllocator<Task>> tasks; ///< Tarefas em ordem FIFO
+        std::atomic<size_t> count{0};           ///< Tamanho lido sem lock
+    };
+};
+
+/**
+ * @struct RingQueuePolicy
+ * @brief Anel limitado lock-free (Vyukov) com capacidade fixada em compilação
+ * @tparam Capacity Número de células (potência de dois)
+ */
+template<size_t Capacity>
+struct RingQueuePolicy {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "RingQueuePolicy requer capacidade potência de dois");
+
+    template<class Task>
+    class Queue {
+    public:
+        Queue() : cells(new Cell[Capacity]) {
+            for (size_t i = 0; i < Capacity; ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        bool try_push(Task& task) {
+            size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &cells[pos & MASK];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;  // Anel cheio
+                } else {
+                    pos = enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            cell->task = std::move(task);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_pop(Task& task) {
+            size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &cells[pos & MASK];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+                if (diff == 0) {
+                    if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;  // Anel vazio
+                } else {
+                    pos = dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            task = std::move(cell->task);
+            cell->task = nullptr;  // Libera capturas da tarefa imediatamente
+            cell->sequence.store(pos + MASK + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool empty() const {
+            return enqueue_pos.load(std::memory_order_acquire) == dequeue_pos.load(std::memory_order_acquire);
+        }
+
+    private:
+        static constexpr size_t MASK = Capacity - 1;
+
+        /**
+         * @struct Cell
+         * @brief Célula do anel em linha de cache própria
+         */
+        struct alignas(64) Cell {
+            std::atomic<size_t> sequence;       ///< Estado da célula nesta volta
+            Task task;                          ///< Tarefa armazenada
+        };
+
+        std::unique_ptr<Cell[]> cells;          ///< Células do anel
+        alignas(64) std::atomic<size_t> enqueue_pos{0}; ///< Próxima escrita
+        alignas(64) std::atomic<size_t> dequeue_pos{0}; ///< Próxima leitura
+    };
+};
+
+/**
+ * @struct ParkWaitPolicy
+ * @brief Dorme no EventCount assim que não há trabalho (WaitStrategy::park())
+ */
+struct ParkWaitPolicy {
+    static constexpr bool parks = true;         ///< Workers podem dormir
+
+    /**
+     * @brief Espera até obter uma tarefa ou a parada
+     * @param event Ponto de espera notificado pelos produtores
+     * @param try_pop Tenta obter uma tarefa
+     * @param stopped Indica que o pool está parando
+     * @return true se try_pop obteve tarefa, false se parado e vazio
+     */
+    template<class TryPop, class Stopped>
+    static bool wait(EventCount& event, TryPop&& try_pop, Stopped&& stopped) {
+        while (true) {
+            EventCount::Key key = event.prepare_wait();
+            if (try_pop()) {
+                event.cancel_wait();
+                return true;
+            }
+            if (stopped()) {
+                event.cancel_wait();
+                return try_pop();
+            }
+            event.wait(key);
+            if (try_pop()) return true;
+        }
+    }
+};
+
+/**
+ * @struct SpinThenParkWaitPolicy
+ * @brief Gira e cede a vez antes de dormir (WaitStrategy::spin_then_park())
+ * @tparam Spins Tentativas com pausa de CPU
+ * @tparam Yields Tentativas com yield
+ */
+template<size_t Spins = 2000, size_t Yields = 50>
+struct SpinThenParkWaitPolicy {
+    static constexpr bool parks = true;         ///< Workers podem dormir
+
+    template<class TryPop, class Stopped>
+    static bool wait(EventCount& event, TryPop&& try_pop, Stopped&& stopped) {
+        for (size_t i = 0; i < Spins && !stopped(); ++i) {
+            if (try_pop()) return true;
+            detail::cpu_relax();
+        }
+        for (size_t i = 0; i < Yields && !stopped(); ++i) {
+            if (try_pop()) return true;
+            std::this_thread::yield();
+        }
+        return ParkWaitPolicy::wait(event, try_pop, stopped);
+    }
+};
+
+/**
+ * @struct SpinWaitPolicy
+ * @brief Nunca dorme: consulta a fila com yield (menor latência, CPU sempre ocupada)
+ */
+struct SpinWaitPolicy {
+    static constexpr bool parks = false;        ///< Produtores não notificam
+
+    template<class TryPop, class Stopped>
+    static bool wait(EventCount&, TryPop&& try_pop, Stopped&& stopped) {
+        while (!stopped()) {
+            if (try_pop()) return true;
+            std::this_thread::yield();
+        }
+        return try_pop();
+    }
+};
+
+/**
+ * @struct InlineTaskPolicy
+ * @brief Tarefas em InlineTask: callables pequenos sem alocação
+ */
+struct InlineTaskPolicy {
+    using Task = InlineTask;
+
+    template<class F>
+    static Task make(F&& f) {
+        return Task(std::forward<F>(f));
+    }
+};
+
+/**
+ * @struct FunctionTaskPolicy
+ * @brief Tarefas em std::function<void()> (referência para comparação)
+ *
+ * Callables move-only, como os de submit, são guardados em um shared_ptr.
+ */
+struct FunctionTaskPolicy {
+    using Task = std::function<void()>;
+
+    template<class F>
+    static Task make(F&& f) {
+        using Callable = std::decay_t<F>;
+        if constexpr (std::is_copy_constructible_v<Callable>) {
+            return Task(std::forward<F>(f));
+        } else {
+            auto shared = std::make_shared<Callable>(std::forward<F>(f));
+            return Task([shared]() { (*shared)(); });
+        }
+    }
+};
+
+#endif
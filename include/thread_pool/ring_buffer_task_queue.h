@@ -0,0 +1,131 @@
+#ifndef RING_BUFFER_TASK_QUEUE_H
+#define RING_BUFFER_TASK_QUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include "task_queue.h"
+
+/**
+ * @class RingBufferTaskQueue
+ * @brief Fila de tarefas limitada, lock-free, multi-produtor/multi-consumidor
+ *
+ * Anel de capacidade fixa (potência de dois) em que cada célula carrega um
+ * número de sequência, no estilo da fila limitada de Dmitry Vyukov. Produtores
+ * e consumidores disputam apenas um contador atômico cada, em linhas de cache
+ * separadas. O mutex só é usado quando o anel está de fato vazio (consumidor)
+ * ou cheio (produtor) e a thread precisa dormir. O anel é FIFO único:
+ * prioridades de tarefa são aceitas, mas não reordenam a execução.
+ */
+class RingBufferTaskQueue : public TaskQueue {
+public:
+    using TaskQueue::push;
+    using TaskQueue::size;
+
+    /**
+     * @brief Construtor com capacidade fixa
+     * @param capacity Capacidade do anel (arredondada para potência de dois)
+     */
+    explicit RingBufferTaskQueue(size_t capacity);
+
+    /**
+     * @brief Adiciona uma tarefa, bloqueando apenas se o anel estiver cheio
+     * @param task Tarefa a ser adicionada
+     * @return true se bem-sucedido, false se a fila está parada
+     */
+    bool push(Task task) override;
+
+    /**
+     * @brief Adiciona um lote, acordando no máximo um consumidor por tarefa
+     * @param tasks Tarefas a serem adicionadas (o vetor é esvaziado)
+     * @return true se bem-sucedido, false se a fila está parada
+     */
+    bool push_bulk(std::vector<Task>& tasks) override;
+
+    /**
+     * @brief Remove uma tarefa, bloqueando apenas se o anel estiver vazio
+     * @param task Referência para armazenar a tarefa removida
+     * @return true se obteve tarefa, false se a fila está parada e vazia
+     */
+    bool pop(Task& task) override;
+
+    bool try_pop(Task& task) override;
+    size_t try_pop_bulk(std::vector<Task>& tasks, size_t max) override;
+    void stop() override;
+    bool stopped() const override;
+
+    /**
+     * @brief Retorna o tamanho aproximado da fila sem travar
+     * @return Número de tarefas no anel
+     */
+    size_t size() const override;
+
+    /**
+     * @brief Tenta adicionar uma tarefa sem bloquear
+     * @param task Tarefa a ser adicionada (só é movida em caso de sucesso)
+     * @param priority Classe de prioridade (ignorada: o anel é FIFO)
+     * @return true se adicionou, false se o anel está cheio ou parado
+     */
+    bool try_push(Task& task, TaskPriority priority = TaskPriority::Normal) override;
+
+    /**
+     * @brief Adiciona uma tarefa esperando no máximo timeout com o anel cheio
+     * @param task Tarefa a ser adicionada (só é movida em caso de sucesso)
+     * @param priority Classe de prioridade (ignorada: o anel é FIFO)
+     * @param timeout Tempo máximo de espera
+     * @return true se adicionou, false se expirou ou a fila está parada
+     */
+    bool push_for(Task& task, TaskPriority priority, std::chrono::nanoseconds timeout) override;
+
+    /**
+     * @brief Retorna a capacidade do anel
+     * @return Número máximo de tarefas
+     */
+    size_t capacity() const override;
+
+private:
+    /**
+     * @struct Cell
+     * @brief Célula do anel, isolada em sua própria linha de cache
+     */
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence;           ///< Sequência que indica o estado da célula
+        Task task;                              ///< Tarefa armazenada
+    };
+
+    /**
+     * @brief Escreve a tarefa em uma célula livre, sem notificar consumidores
+     */
+    bool enqueue(Task& task);
+
+    /**
+     * @brief Lê a tarefa de uma célula publicada, sem notificar produtores
+     */
+    bool dequeue(Task& task);
+
+    /**
+     * @brief Acorda uma thread bloqueada, se houver
+     */
+    void notify(const std::atomic<size_t>& waiters, std::condition_variable& condition);
+
+    /**
+     * @brief Acorda até count consumidores bloqueados
+     */
+    void notify_consumers(size_t count);
+
+    const size_t mask;                          ///< Capacidade - 1 (índice por máscara)
+    std::unique_ptr<Cell[]> cells;              ///< Células do anel
+
+    alignas(64) std::atomic<size_t> enqueue_pos{0}; ///< Próxima posição de escrita
+    alignas(64) std::atomic<size_t> dequeue_pos{0}; ///< Próxima posição de leitura
+
+    alignas(64) std::atomic<size_t> pop_waiters{0};  ///< Consumidores dormindo (anel vazio)
+    std::atomic<size_t> push_waiters{0};        ///< Produtores dormindo (anel cheio)
+    std::atomic<bool> stop_flag{false};         ///< Flag de parada
+    std::mutex mutex;                           ///< Mutex usado apenas para dormir
+    std::condition_variable not_empty;          ///< Sinaliza tarefa disponível
+    std::condition_variable not_full;           ///< Sinaliza espaço disponível
+};
+
+#endif
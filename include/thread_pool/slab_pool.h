@@ -0,0 +1,93 @@
+#ifndef SLAB_POOL_H
+#define SLAB_POOL_H
+
+#include <cstddef>
+#include <new>
+
+/**
+ * @class SlabPool
+ * @brief Pool de blocos de tamanho fixo para estado de tarefas e filas
+ *
+ * Blocos de 64 a 1024 bytes são recortados de slabs grandes e reciclados
+ * por listas livres locais a cada thread. Quando a lista local cresce demais,
+ * metade volta para uma lista global (um lock por lote, não por bloco); quando
+ * esvazia, um lote é buscado da lista global. Em regime estável nenhuma
+ * alocação chega ao heap. Pedidos maiores usam ::operator new diretamente.
+ */
+class SlabPool {
+public:
+    static constexpr size_t MAX_BLOCK_SIZE = 1024; ///< Maior bloco servido pelo pool
+
+    /**
+     * @brief Aloca um bloco de pelo menos size bytes
+     * @param size Tamanho em bytes
+     * @return Ponteiro alinhado a alignof(std::max_align_t)
+     */
+    static void* allocate(size_t size);
+
+    /**
+     * @brief Devolve um bloco ao pool
+     * @param pointer Bloco obtido de allocate
+     * @param size Mesmo tamanho passado em allocate
+     */
+    static void deallocate(void* pointer, size_t size) noexcept;
+};
+
+/**
+ * @class PoolAllocator
+ * @brief Allocator padrão apoiado no SlabPool
+ *
+ * Usado para o estado compartilhado de std::promise/std::future e para os
+ * nós das deques de tarefas.
+ */
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    /**
+     * @brief Aloca espaço para n objetos
+     * @param n Número de objetos
+     * @return Ponteiro para a memória alocada
+     */
+    T* allocate(size_t n);
+
+    /**
+     * @brief Libera espaço de n objetos
+     * @param pointer Memória obtida de allocate
+     * @param n Número de objetos
+     */
+    void deallocate(T* pointer, size_t n) noexcept;
+};
+
+// Implementação do template
+template<typename T>
+T* PoolAllocator<T>::allocate(size_t n) {
+    if constexpr (alignof(T) > alignof(std::max_align_t)) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    } else {
+        return static_cast<T*>(SlabPool::allocate(n * sizeof(T)));
+    }
+}
+
+template<typename T>
+void PoolAllocator<T>::deallocate(T* pointer, size_t n) noexcept {
+    if constexpr (alignof(T) > alignof(std::max_align_t)) {
+        ::operator delete(pointer, std::align_val_t(alignof(T)));
+    } else {
+        SlabPool::deallocate(pointer, n * sizeof(T));
+    }
+}
+
+template<typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept { return true; }
+
+template<typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept { return false; }
+
+#endif
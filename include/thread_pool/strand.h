@@ -0,0 +1,318 @@
+#ifndef STRAND_H
+#define STRAND_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "thread_pool.h"
+
+template<typename Key, typename Hash>
+class StrandMap;
+
+/**
+ * @class Strand
+ * @brief Executor serial sobre um ThreadPool compartilhado
+ *
+ * Tarefas postadas no mesmo strand executam na ordem de submissão e nunca
+ * ao mesmo tempo, mas não prendem um worker: enquanto houver fila, uma única
+ * tarefa de drenagem roda no pool e executa um lote; com mais trabalho
+ * pendente, ela se republica em vez de monopolizar o worker. Um strand vazio
+ * não ocupa nenhum worker. Strands diferentes executam em paralelo.
+ *
+ * Cópias compartilham a mesma fila. As tarefas pendentes mantêm o estado
+ * vivo, então o objeto pode ser destruído antes delas terminarem; o pool
+ * deve sobreviver a todas.
+ */
+class Strand {
+public:
+    static constexpr size_t DRAIN_BATCH = 32;   ///< Tarefas por drenagem antes de devolver o worker
+
+    /**
+     * @brief Construtor de um strand sobre o pool
+     * @param pool Pool que executa as tarefas
+     * @param priority Classe de prioridade das drenagens no pool
+     */
+    explicit Strand(ThreadPool& pool, TaskPriority priority = TaskPriority::Normal);
+
+    /**
+     * @brief Posta uma tarefa sem future (exceções são registradas e descartadas)
+     * @param f Função sem argumentos
+     * @throws std::runtime_error se o pool está parado
+     */
+    template<class F>
+    void post(F&& f);
+
+    /**
+     * @brief Submete uma tarefa ao strand
+     * @param f Função a ser executada
+     * @param args Argumentos para a função
+     * @return Future com o resultado
+     * @throws std::runtime_error se o pool está parado
+     */
+    template<class F, class... Args>
+    auto submit(F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<F, Args...>>;
+
+    /**
+     * @brief Verifica se a thread corrente está executando uma tarefa deste strand
+     * @return true dentro de uma tarefa do strand
+     */
+    bool running_in_this_thread() const noexcept;
+
+    /**
+     * @brief Retorna o número de tarefas aguardando no strand
+     * @return Tarefas ainda não iniciadas
+     */
+    size_t pending() const;
+
+private:
+    template<typename Key, typename Hash>
+    friend class StrandMap;
+
+    /**
+     * @struct State
+     * @brief Fila e flag de drenagem compartilhadas pelas cópias e pela drenagem
+     */
+    struct State {
+        State(ThreadPool& pool, TaskPriority priority) : pool(pool), priority(priority) {}
+
+        ThreadPool& pool;                       ///< Pool que executa as drenagens
+        TaskPriority priority;                  ///< Prioridade das drenagens
+        mutable std::mutex mutex;               ///< Protege tasks e active
+        std::deque<TaskQueue::Task, PoolAllocator<TaskQueue::Task>> tasks; ///< Tarefas em ordem de submissão
+        bool active = false;                    ///< Há uma drenagem publicada ou executando
+        std::function<void()> on_idle;          ///< Chamado quando a fila esvazia (StrandMap)
+    };
+
+    explicit Strand(std::shared_ptr<State> state) noexcept : state(std::move(state)) {}
+
+    /**
+     * @brief Enfileira uma tarefa no estado
+     * @param state Strand de destino
+     * @param task Tarefa
+     * @return true se o strand estava ocioso e precisa de uma drenagem
+     */
+    static bool push(State& state, TaskQueue::Task task);
+
+    /**
+     * @brief Publica a drenagem de um strand que acabou de ficar ativo
+     * @param state Strand ativado por push
+     * @throws std::runtime_error se o pool recusa a drenagem (parado ou fila cheia); a
+     *         tarefa de quem chamou é descartada e as demais terminam nesta thread
+     */
+    static void schedule(const std::shared_ptr<State>& state);
+
+    /**
+     * @brief Executa um lote de tarefas do strand (corpo da drenagem)
+     * @param state Strand drenado
+     */
+    static void drain(const std::shared_ptr<State>& state);
+
+    /**
+     * @brief Embrulha uma tarefa de post() para registrar exceções
+     */
+    template<class F>
+    static TaskQueue::Task wrap_post(F&& f);
+
+    /**
+     * @brief Empacota uma tarefa de submit() ligada a um future
+     */
+    template<class F, class... Args>
+    static auto package(F&& f, Args&&... args) {
+        return ThreadPool::package(std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Registra a exceção de uma tarefa postada
+     */
+    static void report(std::exception_ptr error) noexcept;
+
+    std::shared_ptr<State> state;               ///< Fila compartilhada
+};
+
+/**
+ * @class StrandMap
+ * @brief Strands por chave sobre um ThreadPool, chaveados como o ResourceManager
+ *
+ * Substitui a serialização com get_write_access(key) dentro de tarefas: as
+ * tarefas de uma mesma chave executam em ordem e sem concorrência entre si,
+ * sem worker esperando em lock, e chaves diferentes executam em paralelo.
+ * O strand de uma chave é criado na primeira tarefa e descartado quando sua
+ * fila esvazia, então o mapa só guarda chaves com trabalho pendente. O mapa
+ * é dividido em shards para que chaves diferentes não disputem o mesmo lock.
+ * O destrutor espera as tarefas pendentes terminarem.
+ *
+ * @tparam Key Tipo da chave
+ * @tparam Hash Hash da chave
+ */
+template<typename Key, typename Hash = std::hash<Key>>
+class StrandMap {
+public:
+    static constexpr size_t SHARDS = 16;        ///< Número de shards do mapa
+
+    /**
+     * @brief Construtor do mapa
+     * @param pool Pool que executa as tarefas
+     * @param priority Classe de prioridade das drenagens no pool
+     */
+    explicit StrandMap(ThreadPool& pool, TaskPriority priority = TaskPriority::Normal)
+        : pool(pool), priority(priority) {}
+
+    /**
+     * @brief Destrutor que espera todas as chaves esvaziarem
+     */
+    ~StrandMap() {
+        std::unique_lock lock(idle_mutex);
+        idle_cv.wait(lock, [this]() { return busy == 0; });
+    }
+
+    StrandMap(const StrandMap&) = delete;
+    StrandMap& operator=(const StrandMap&) = delete;
+
+    /**
+     * @brief Posta uma tarefa na fila da chave (exceções são registradas e descartadas)
+     * @param key Chave que serializa a tarefa
+     * @param f Função sem argumentos
+     * @throws std::runtime_error se o pool está parado
+     */
+    template<class F>
+    void post(const Key& key, F&& f) {
+        dispatch(key, Strand::wrap_post(std::forward<F>(f)));
+    }
+
+    /**
+     * @brief Submete uma tarefa à fila da chave
+     * @param key Chave que serializa a tarefa
+     * @param f Função a ser executada
+     * @param args Argumentos para a função
+     * @return Future com o resultado
+     * @throws std::runtime_error se o pool está parado
+     */
+    template<class F, class... Args>
+    auto submit(const Key& key, F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<F, Args...>> {
+        auto [task, result] = Strand::package(std::forward<F>(f), std::forward<Args>(args)...);
+        dispatch(key, std::move(task));
+        return std::move(result);
+    }
+
+    /**
+     * @brief Retorna o número de chaves com tarefas pendentes ou executando
+     * @return Chaves ativas
+     */
+    size_t active_keys() const {
+        size_t total = 0;
+        for (const auto& shard : shards) {
+            std::lock_guard lock(shard.mutex);
+            total += shard.strands.size();
+        }
+        return total;
+    }
+
+private:
+    using StatePtr = std::shared_ptr<Strand::State>;
+
+    /**
+     * @struct Shard
+     * @brief Parte do mapa com seu próprio lock, em linha de cache própria
+     */
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;               ///< Protege strands
+        std::unordered_map<Key, StatePtr, Hash> strands; ///< Strands ativos
+    };
+
+    Shard& shard_of(const Key& key) {
+        return shards[Hash{}(key) % SHARDS];
+    }
+
+    /**
+     * @brief Enfileira no strand da chave, criando-o se necessário
+     */
+    void dispatch(const Key& key, TaskQueue::Task task) {
+        Shard& shard = shard_of(key);
+        StatePtr state;
+        bool idle;
+        {
+            // Com o lock do shard, a remoção do strand ocioso não corre com o push
+            std::lock_guard lock(shard.mutex);
+            StatePtr& slot = shard.strands[key];
+            if (!slot) {
+                slot = std::allocate_shared<Strand::State>(PoolAllocator<Strand::State>(), pool, priority);
+                slot->on_idle = [this, &shard, key]() { retire(shard, key); };
+            }
+            state = slot;
+            idle = Strand::push(*state, std::move(task));
+            if (idle) {
+                std::lock_guard idle_lock(idle_mutex);
+                ++busy;
+            }
+        }
+        // A publicação no pool pode bloquear (fila limitada): fora do lock
+        if (idle) {
+            Strand::schedule(state);
+        }
+    }
+
+    /**
+     * @brief Remove o strand de uma chave que esvaziou (chamado pela drenagem)
+     */
+    void retire(Shard& shard, const Key& key) {
+        {
+            std::lock_guard lock(shard.mutex);
+            auto it = shard.strands.find(key);
+            if (it != shard.strands.end()) {
+                std::lock_guard state_lock(it->second->mutex);
+                // Um push pode ter reativado o strand entre a drenagem e este lock
+                if (!it->second->active) {
+                    shard.strands.erase(it);
+                }
+            }
+        }
+        std::lock_guard idle_lock(idle_mutex);
+        --busy;
+        idle_cv.notify_all();
+    }
+
+    ThreadPool& pool;                           ///< Pool que executa as tarefas
+    TaskPriority priority;                      ///< Prioridade das drenagens
+    std::array<Shard, SHARDS> shards;           ///< Mapa chave -> strand
+    std::mutex idle_mutex;                      ///< Protege busy
+    std::condition_variable idle_cv;            ///< Sinaliza busy == 0
+    size_t busy = 0;                            ///< Ativações de strand ainda sem retire
+};
+
+// Implementação dos templates
+template<class F>
+TaskQueue::Task Strand::wrap_post(F&& f) {
+    return TaskQueue::Task([function = std::forward<F>(f)]() mutable {
+        try {
+            function();
+        } catch (...) {
+            report(std::current_exception());
+        }
+    });
+}
+
+template<class F>
+void Strand::post(F&& f) {
+    if (push(*state, wrap_post(std::forward<F>(f)))) {
+        schedule(state);
+    }
+}
+
+template<class F, class... Args>
+auto Strand::submit(F&& f, Args&&... args)
+    -> std::future<std::invoke_result_t<F, Args...>> {
+    auto [task, result] = package(std::forward<F>(f), std::forward<Args>(args)...);
+    if (push(*state, std::move(task))) {
+        schedule(state);
+    }
+    return std::move(result);
+}
+
+#endif
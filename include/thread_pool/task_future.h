@@ -0,0 +1,583 @@
+#ifndef TASK_FUTURE_H
+#define TASK_FUTURE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "helping_wait.h"
+#include "inline_task.h"
+#include "slab_pool.h"
+
+template<class T>
+class TaskFuture;
+
+template<class T>
+class TaskPromise;
+
+/**
+ * @struct WhenAnyResult
+ * @brief Resultado de when_any: índice e valor do primeiro future pronto
+ */
+template<class T>
+struct WhenAnyResult {
+    size_t index;                               ///< Posição do future no vetor
+    T value;                                    ///< Valor dele
+};
+
+template<>
+struct WhenAnyResult<void> {
+    size_t index;                               ///< Posição do future no vetor
+};
+
+namespace detail {
+
+/**
+ * @struct Unit
+ * @brief Valor guardado por futures de void
+ */
+struct Unit {};
+
+template<class T>
+using FutureStored = std::conditional_t<std::is_void_v<T>, Unit, T>;
+
+/**
+ * @class FutureState
+ * @brief Estado compartilhado entre TaskPromise e TaskFuture
+ *
+ * Sem mutex: uma única transição atômica decide quem executa a continuação.
+ * Quem instala a continuação antes do resultado a deixa para o produtor;
+ * quem chega depois a executa na hora. Há lugar para uma continuação só,
+ * já que o future é consumido por then(), when_all() e when_any().
+ */
+template<class T>
+class FutureState {
+public:
+    /**
+     * @brief Guarda o valor e dispara a continuação
+     * @throws std::future_error se o resultado já foi definido
+     */
+    template<class... V>
+    void set_value(V&&... value) {
+        claim();
+        this->value.emplace(std::forward<V>(value)...);
+        publish();
+    }
+
+    /**
+     * @brief Guarda a exceção e dispara a continuação
+     * @throws std::future_error se o resultado já foi definido
+     */
+    void set_exception(std::exception_ptr failure) {
+        claim();
+        error = std::move(failure);
+        publish();
+    }
+
+    /**
+     * @brief Verifica se o resultado foi publicado
+     */
+    bool ready() const noexcept {
+        return phase.load(std::memory_order_acquire) == READY;
+    }
+
+    /**
+     * @brief Executa callback quando o resultado estiver pronto (agora, se já estiver)
+     * @param callback Função void() executada uma única vez
+     */
+    void on_ready(InlineTask callback) {
+        continuation = std::move(callback);
+        uint8_t expected = EMPTY;
+        if (!phase.compare_exchange_strong(expected, WAITING,
+                                           std::memory_order_acq_rel, std::memory_order_acquire)) {
+            run(continuation);
+        }
+    }
+
+    std::optional<FutureStored<T>> value;       ///< Valor (válido em READY sem erro)
+    std::exception_ptr error;                   ///< Exceção (válida em READY)
+
+private:
+    enum : uint8_t {
+        EMPTY,      ///< Sem resultado e sem continuação
+        WAITING,    ///< Continuação instalada, esperando o resultado
+        READY       ///< Resultado publicado
+    };
+
+    /**
+     * @brief Garante um único produtor do resultado
+     */
+    void claim() {
+        if (satisfied.exchange(true, std::memory_order_relaxed)) {
+            throw std::future_error(std::future_errc::promise_already_satisfied);
+        }
+    }
+
+    /**
+     * @brief Publica o resultado e executa a continuação, se instalada
+     */
+    void publish() {
+        if (phase.exchange(READY, std::memory_order_acq_rel) == WAITING) {
+            run(continuation);
+        }
+    }
+
+    /**
+     * @brief Executa e descarta a continuação (libera o que ela capturou)
+     */
+    static void run(InlineTask& slot) {
+        InlineTask callback = std::move(slot);
+        callback();
+    }
+
+    std::atomic<uint8_t> phase{EMPTY};          ///< Estado da transição
+    std::atomic<bool> satisfied{false};         ///< Resultado já reivindicado
+    InlineTask continuation;                    ///< Continuação instalada
+};
+
+/**
+ * @brief Chama function e entrega o resultado (ou a exceção) ao promise
+ */
+template<class T, class F, class... Args>
+void fulfil(TaskPromise<T>& promise, F&& function, Args&&... args) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            std::invoke(std::forward<F>(function), std::forward<Args>(args)...);
+            promise.set_value();
+        } else {
+            promise.set_value(std::invoke(std::forward<F>(function), std::forward<Args>(args)...));
+        }
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+}
+
+/**
+ * @brief Tipo do resultado de uma continuação de then()
+ */
+template<class T, class F>
+struct ThenResult {
+    using type = std::invoke_result_t<F, T>;
+};
+
+template<class F>
+struct ThenResult<void, F> {
+    using type = std::invoke_result_t<F>;
+};
+
+}
+
+/**
+ * @class TaskPromise
+ * @brief Lado produtor de um TaskFuture
+ *
+ * O estado compartilhado vem do SlabPool. Destruído sem resultado, entrega
+ * std::future_error(broken_promise) ao future, como std::promise.
+ */
+template<class T>
+class TaskPromise {
+public:
+    /**
+     * @brief Construtor que cria o estado compartilhado
+     */
+    TaskPromise()
+        : state(std::allocate_shared<detail::FutureState<T>>(PoolAllocator<detail::FutureState<T>>())) {}
+
+    TaskPromise(TaskPromise&&) noexcept = default;
+    TaskPromise& operator=(TaskPromise&& other) noexcept {
+        if (this != &other) {
+            abandon();
+            state = std::move(other.state);
+        }
+        return *this;
+    }
+
+    TaskPromise(const TaskPromise&) = delete;
+    TaskPromise& operator=(const TaskPromise&) = delete;
+
+    /**
+     * @brief Destrutor que quebra o promise se nenhum resultado foi definido
+     */
+    ~TaskPromise() {
+        abandon();
+    }
+
+    /**
+     * @brief Retorna o future ligado a este promise (uma vez)
+     * @return Future do resultado
+     */
+    TaskFuture<T> get_future() {
+        return TaskFuture<T>(state);
+    }
+
+    /**
+     * @brief Define o valor
+     * @param value Valor (nenhum para TaskPromise<void>)
+     * @throws std::future_error se o resultado já foi definido
+     */
+    template<class... V>
+    void set_value(V&&... value) {
+        state->set_value(std::forward<V>(value)...);
+    }
+
+    /**
+     * @brief Define a exceção
+     * @param error Exceção entregue em get()
+     * @throws std::future_error se o resultado já foi definido
+     */
+    void set_exception(std::exception_ptr error) {
+        state->set_exception(std::move(error));
+    }
+
+private:
+    void abandon() noexcept {
+        if (state && !state->ready()) {
+            try {
+                state->set_exception(std::make_exception_ptr(
+                    std::future_error(std::future_errc::broken_promise)));
+            } catch (const std::future_error&) {
+                // Outro produtor já reivindicou o resultado
+            }
+        }
+    }
+
+    std::shared_ptr<detail::FutureState<T>> state; ///< Estado compartilhado
+};
+
+/**
+ * @class TaskFuture
+ * @brief Future leve do pool com continuações e combinadores
+ *
+ * Alternativa ao std::future devolvida por ThreadPool::async: o estado vem do
+ * SlabPool e não tem mutex nem condition_variable. then() encadeia uma
+ * continuação e when_all()/when_any() combinam futures sem nenhuma thread
+ * parada esperando: quem publica o último (ou o primeiro) resultado dispara
+ * o combinador. Só get() e wait() bloqueiam; chamados de um worker,
+ * executam outras tarefas do pool enquanto esperam (HelpingWait). Como
+ * std::future, é move-only e get() consome o resultado; then() consome o
+ * próprio future.
+ */
+template<class T>
+class TaskFuture {
+public:
+    /**
+     * @brief Construtor de um future sem estado
+     */
+    TaskFuture() noexcept = default;
+
+    /**
+     * @brief Verifica se o future tem estado (não foi consumido)
+     * @return true se válido
+     */
+    bool valid() const noexcept {
+        return state != nullptr;
+    }
+
+    /**
+     * @brief Verifica, sem bloquear, se o resultado está pronto
+     * @return true se pronto
+     */
+    bool ready() const {
+        return state && state->ready();
+    }
+
+    /**
+     * @brief Bloqueia até o resultado ficar pronto
+     */
+    void wait() const;
+
+    /**
+     * @brief Espera e retorna o resultado, relançando a exceção da tarefa
+     * @return Valor da tarefa
+     * @throws std::future_error se o future não tem estado
+     */
+    T get();
+
+    /**
+     * @brief Encadeia uma continuação executada pela thread que publica o resultado
+     *
+     * A continuação recebe o valor (nada, para void). Se a tarefa falhou, ela
+     * não é chamada e a exceção passa adiante. Para continuações longas, use
+     * a versão com executor.
+     * @param f Continuação
+     * @return Future do resultado da continuação
+     */
+    template<class F>
+    auto then(F&& f) -> TaskFuture<typename detail::ThenResult<T, std::decay_t<F>&>::type>;
+
+    /**
+     * @brief Encadeia uma continuação publicada em um executor (ex.: ThreadPool)
+     * @param executor Objeto com execute(callable)
+     * @param f Continuação
+     * @return Future do resultado da continuação
+     */
+    template<class Executor, class F>
+    auto then(Executor& executor, F&& f) -> TaskFuture<typename detail::ThenResult<T, std::decay_t<F>&>::type>;
+
+private:
+    friend class TaskPromise<T>;
+
+    template<class U>
+    friend class TaskFuture;
+
+    template<class U>
+    friend auto when_all(std::vector<TaskFuture<U>> futures)
+        -> TaskFuture<std::conditional_t<std::is_void_v<U>, void, std::vector<U>>>;
+
+    template<class U>
+    friend TaskFuture<WhenAnyResult<U>> when_any(std::vector<TaskFuture<U>> futures);
+
+    explicit TaskFuture(std::shared_ptr<detail::FutureState<T>> state) noexcept
+        : state(std::move(state)) {}
+
+    /**
+     * @brief Retira o estado, falhando se o future já foi consumido
+     */
+    std::shared_ptr<detail::FutureState<T>> take();
+
+    std::shared_ptr<detail::FutureState<T>> state; ///< Estado compartilhado
+};
+
+/**
+ * @brief Future que fica pronto quando todos os futures ficarem prontos
+ *
+ * Os valores saem na ordem do vetor. Se algum falhar, o resultado recebe a
+ * primeira exceção registrada, mas só depois de todos terminarem.
+ * @param futures Futures consumidos
+ * @return Future dos valores (void para futures de void)
+ */
+template<class T>
+auto when_all(std::vector<TaskFuture<T>> futures)
+    -> TaskFuture<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>>;
+
+/**
+ * @brief Future que fica pronto com o primeiro future pronto
+ *
+ * Se o primeiro a terminar falhou, o resultado recebe a exceção dele.
+ * @param futures Futures consumidos (não vazio)
+ * @return Future do índice e do valor do primeiro
+ * @throws std::invalid_argument se o vetor é vazio
+ */
+template<class T>
+TaskFuture<WhenAnyResult<T>> when_any(std::vector<TaskFuture<T>> futures);
+
+// Implementação dos templates
+template<class T>
+std::shared_ptr<detail::FutureState<T>> TaskFuture<T>::take() {
+    if (!state) {
+        throw std::future_error(std::future_errc::no_state);
+    }
+    return std::move(state);
+}
+
+template<class T>
+void TaskFuture<T>::wait() const {
+    if (!state) {
+        throw std::future_error(std::future_errc::no_state);
+    }
+    if (state->ready()) return;
+
+    // Em um worker, executa outras tarefas em vez de dormir (evita travar o pool)
+    if (HelpingWait::in_worker()) {
+        HelpingWait::until([this]() { return state->ready(); });
+        return;
+    }
+
+    // A continuação acorda esta thread; o estado de espera vive na pilha
+    struct Waiter {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool done = false;
+    } waiter;
+    state->on_ready([&waiter]() {
+        std::lock_guard lock(waiter.mutex);
+        waiter.done = true;
+        waiter.condition.notify_one();
+    });
+    std::unique_lock lock(waiter.mutex);
+    waiter.condition.wait(lock, [&waiter]() { return waiter.done; });
+}
+
+template<class T>
+T TaskFuture<T>::get() {
+    wait();
+    auto ready_state = take();
+    if (ready_state->error) {
+        std::rethrow_exception(ready_state->error);
+    }
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*ready_state->value);
+    }
+}
+
+template<class T>
+template<class F>
+auto TaskFuture<T>::then(F&& f) -> TaskFuture<typename detail::ThenResult<T, std::decay_t<F>&>::type> {
+    using R = typename detail::ThenResult<T, std::decay_t<F>&>::type;
+
+    auto antecedent = take();
+    TaskPromise<R> promise;
+    TaskFuture<R> result = promise.get_future();
+
+    // O ponteiro cru basta: a continuação roda enquanto o produtor (ou esta
+    // função) ainda segura o estado
+    detail::FutureState<T>* source = antecedent.get();
+    source->on_ready([source, promise = std::move(promise), function = std::forward<F>(f)]() mutable {
+        if (source->error) {
+            promise.set_exception(source->error);
+        } else if constexpr (std::is_void_v<T>) {
+            detail::fulfil(promise, function);
+        } else {
+            detail::fulfil(promise, function, std::move(*source->value));
+        }
+    });
+    return result;
+}
+
+template<class T>
+template<class Executor, class F>
+auto TaskFuture<T>::then(Executor& executor, F&& f) -> TaskFuture<typename detail::ThenResult<T, std::decay_t<F>&>::type> {
+    using R = typename detail::ThenResult<T, std::decay_t<F>&>::type;
+
+    auto antecedent = take();
+    TaskPromise<R> promise;
+    TaskFuture<R> result = promise.get_future();
+
+    // A tarefa no executor sobrevive ao produtor: segura o estado por shared_ptr.
+    // O ciclo estado -> continuação -> estado se desfaz quando ela é executada
+    detail::FutureState<T>* source = antecedent.get();
+    source->on_ready([&executor, antecedent, promise = std::move(promise),
+                      function = std::forward<F>(f)]() mutable {
+        auto body = [antecedent = std::move(antecedent), promise = std::move(promise),
+                     function = std::move(function)]() mutable {
+            if (antecedent->error) {
+                promise.set_exception(antecedent->error);
+            } else if constexpr (std::is_void_v<T>) {
+                detail::fulfil(promise, function);
+            } else {
+                detail::fulfil(promise, function, std::move(*antecedent->value));
+            }
+        };
+        // Se o executor recusar a tarefa, o promise destruído com ela entrega broken_promise
+        executor.execute(std::move(body));
+    });
+    return result;
+}
+
+template<class T>
+auto when_all(std::vector<TaskFuture<T>> futures)
+    -> TaskFuture<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> {
+    using R = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+
+    /**
+     * @brief Contagem regressiva compartilhada pelas continuações
+     */
+    struct Join {
+        std::atomic<size_t> remaining;
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::vector<std::optional<detail::FutureStored<T>>> values;
+        TaskPromise<R> promise;
+
+        void finish() {
+            if (failed.load(std::memory_order_acquire)) {
+                promise.set_exception(error);
+            } else if constexpr (std::is_void_v<T>) {
+                promise.set_value();
+            } else {
+                std::vector<T> results;
+                results.reserve(values.size());
+                for (auto& value : values) {
+                    results.push_back(std::move(*value));
+                }
+                promise.set_value(std::move(results));
+            }
+        }
+    };
+
+    std::vector<std::shared_ptr<detail::FutureState<T>>> sources;
+    sources.reserve(futures.size());
+    for (auto& future : futures) {
+        sources.push_back(future.take());
+    }
+
+    auto join = std::allocate_shared<Join>(PoolAllocator<Join>());
+    join->remaining.store(sources.size() + 1, std::memory_order_relaxed);
+    if constexpr (!std::is_void_v<T>) {
+        join->values.resize(sources.size());
+    }
+    TaskFuture<R> result = join->promise.get_future();
+
+    // Cada continuação guarda seu valor; a última a terminar publica o lote
+    for (size_t i = 0; i < sources.size(); ++i) {
+        detail::FutureState<T>* source = sources[i].get();
+        source->on_ready([join, source, i]() {
+            if (source->error) {
+                if (!join->failed.exchange(true, std::memory_order_acq_rel)) {
+                    join->error = source->error;
+                }
+            } else if constexpr (!std::is_void_v<T>) {
+                join->values[i] = std::move(source->value);
+            }
+            if (join->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                join->finish();
+            }
+        });
+    }
+    // A referência extra impede a publicação antes de todas as instalações
+    if (join->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        join->finish();
+    }
+    return result;
+}
+
+template<class T>
+TaskFuture<WhenAnyResult<T>> when_any(std::vector<TaskFuture<T>> futures) {
+    if (futures.empty()) {
+        throw std::invalid_argument("when_any requer ao menos um future");
+    }
+
+    /**
+     * @brief Disputa compartilhada pelas continuações
+     */
+    struct Race {
+        std::atomic<bool> decided{false};
+        TaskPromise<WhenAnyResult<T>> promise;
+    };
+
+    std::vector<std::shared_ptr<detail::FutureState<T>>> sources;
+    sources.reserve(futures.size());
+    for (auto& future : futures) {
+        sources.push_back(future.take());
+    }
+
+    auto race = std::allocate_shared<Race>(PoolAllocator<Race>());
+    TaskFuture<WhenAnyResult<T>> result = race->promise.get_future();
+
+    // Só a primeira continuação publica; as demais apenas soltam a referência
+    for (size_t i = 0; i < sources.size(); ++i) {
+        detail::FutureState<T>* source = sources[i].get();
+        source->on_ready([race, source, i]() {
+            if (race->decided.exchange(true, std::memory_order_acq_rel)) return;
+            if (source->error) {
+                race->promise.set_exception(source->error);
+            } else if constexpr (std::is_void_v<T>) {
+                race->promise.set_value(WhenAnyResult<void>{i});
+            } else {
+                race->promise.set_value(WhenAnyResult<T>{i, std::move(*source->value)});
+            }
+        });
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "inline_task.h"
+#include "join_handle.h"
+#include "thread_pool.h"
+
+/**
+ * @class TaskGraph
+ * @brief Grafo acíclico de tarefas executado sobre um ThreadPool
+ *
+ * Cada nó declara seus predecessores; um nó só é liberado para o pool quando
+ * todos eles terminaram, então nenhum worker bloqueia esperando outro. O
+ * worker que termina um nó executa em seguida um sucessor liberado por ele
+ * (mantém o cache quente) e enfileira os demais. Se um nó lança exceção,
+ * seus descendentes não executam e recebem a mesma exceção.
+ *
+ * O grafo deve continuar vivo durante a execução; o destrutor espera a
+ * execução em andamento terminar.
+ */
+class TaskGraph {
+    struct NodeState;
+
+public:
+    /**
+     * @class Node
+     * @brief Referência não tipada a um nó, usada para declarar dependências
+     */
+    class Node {
+    public:
+        /**
+         * @brief Declara que este nó precede outro
+         * @param successor Nó que só executa depois deste
+         * @return Este nó (encadeável)
+         */
+        Node& precede(const Node& successor);
+
+        /**
+         * @brief Declara que este nó depende de outros
+         * @param predecessors Nós que precisam terminar antes deste
+         * @return Este nó (encadeável)
+         */
+        template<class... Nodes>
+        Node& succeed(const Nodes&... predecessors);
+
+    protected:
+        friend class TaskGraph;
+
+        Node(TaskGraph* graph, NodeState* state)
+            : graph(graph), state(state) {}
+
+        TaskGraph* graph;                       ///< Grafo dono do nó
+        NodeState* state;                       ///< Estado do nó
+    };
+
+    /**
+     * @class TaskNode
+     * @brief Nó com resultado tipado
+     * @tparam R Tipo retornado pela função do nó
+     */
+    template<class R>
+    class TaskNode : public Node {
+    public:
+        /**
+         * @brief Cria um sucessor que recebe o resultado deste nó
+         * @param f Função chamada com o resultado (ou sem argumentos se R é void)
+         * @return Nó do sucessor
+         */
+        template<class F>
+        auto then(F&& f);
+
+        /**
+         * @brief Retorna o resultado após a execução do grafo
+         *
+         * Só pode ser chamado depois que o handle de run() concluiu.
+         * @return Referência ao resultado (void se R é void)
+         */
+        decltype(auto) get() const;
+
+    private:
+        friend class TaskGraph;
+
+        /**
+         * @struct Slot
+         * @brief Armazenamento do resultado do nó
+         */
+        struct Slot {
+            std::conditional_t<std::is_void_v<R>, bool, std::optional<R>> value{}; ///< Resultado
+        };
+
+        TaskNode(TaskGraph* graph, NodeState* state, std::shared_ptr<Slot> slot)
+            : Node(graph, state), slot(std::move(slot)) {}
+
+        std::shared_ptr<Slot> slot;             ///< Resultado compartilhado com a tarefa
+    };
+
+    TaskGraph() = default;
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    /**
+     * @brief Destrutor que espera a execução em andamento
+     */
+    ~TaskGraph();
+
+    /**
+     * @brief Adiciona um nó sem dependências
+     * @param f Função sem argumentos executada pelo nó
+     * @return Nó tipado pelo retorno de f
+     */
+    template<class F>
+    auto emplace(F&& f);
+
+    /**
+     * @brief Libera os nós sem predecessores no pool e retorna imediatamente
+     *
+     * O grafo pode ser executado de novo depois que o handle anterior concluiu.
+     * @param pool Pool onde os nós executam
+     * @return Handle que conclui quando todos os nós terminaram
+     * @throws std::logic_error se o grafo tem ciclo ou já está em execução
+     */
+    JoinHandle run(ThreadPool& pool);
+
+    /**
+     * @brief Retorna o número de nós
+     * @return Número de nós
+     */
+    size_t size() const;
+
+private:
+    /**
+     * @struct NodeState
+     * @brief Estado de execução de um nó
+     */
+    struct NodeState {
+        InlineTask work;                        ///< Função do nó (grava o resultado no Slot)
+        std::vector<NodeState*> successors;     ///< Nós liberados por este
+        size_t predecessors = 0;                ///< Número de predecessores declarados
+        std::atomic<size_t> remaining{0};       ///< Predecessores ainda não concluídos
+        std::atomic<bool> upstream_failed{false}; ///< Algum predecessor falhou
+        std::exception_ptr error;               ///< Falha própria ou herdada
+    };
+
+    /**
+     * @brief Cria um nó com a função dada
+     */
+    NodeState* add_node(InlineTask work);
+
+    /**
+     * @brief Registra a aresta from -> to
+     */
+    void add_edge(NodeState* from, NodeState* to);
+
+    /**
+     * @brief Enfileira um nó liberado no pool
+     */
+    void schedule(NodeState* node);
+
+    /**
+     * @brief Executa um nó e, em sequência, um sucessor liberado por ele
+     */
+    void execute(NodeState* node);
+
+    std::vector<std::unique_ptr<NodeState>> nodes; ///< Nós do grafo
+    ThreadPool* pool = nullptr;                 ///< Pool da execução corrente
+    JoinHandle running;                         ///< Handle da execução corrente
+};
+
+// Implementação dos templates
+template<class... Nodes>
+TaskGraph::Node& TaskGraph::Node::succeed(const Nodes&... predecessors) {
+    (graph->add_edge(predecessors.state, state), ...);
+    return *this;
+}
+
+template<class F>
+auto TaskGraph::emplace(F&& f) {
+    using R = std::decay_t<std::invoke_result_t<std::decay_t<F>&>>;
+    using Slot = typename TaskNode<R>::Slot;
+
+    auto slot = std::make_shared<Slot>();
+    NodeState* state = add_node(InlineTask([function = std::forward<F>(f), result = slot]() mutable {
+        if constexpr (std::is_void_v<R>) {
+            function();
+            result->value = true;
+        } else {
+            result->value.emplace(function());
+        }
+    }));
+    return TaskNode<R>(this, state, std::move(slot));
+}
+
+template<class R>
+template<class F>
+auto TaskGraph::TaskNode<R>::then(F&& f) {
+    // O sucessor só executa depois deste nó, então o resultado já está pronto
+    auto continuation = [function = std::forward<F>(f), parent = slot]() mutable {
+        if constexpr (std::is_void_v<R>) {
+            return function();
+        } else {
+            return function(*parent->value);
+        }
+    };
+    auto child = graph->emplace(std::move(continuation));
+    child.succeed(*this);
+    return child;
+}
+
+template<class R>
+decltype(auto) TaskGraph::TaskNode<R>::get() const {
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+    if constexpr (!std::is_void_v<R>) {
+        return static_cast<R&>(*slot->value);
+    }
+}
+
+#endif
@@ -1,63 +1,176 @@
 #ifndef TASK_QUEUE_H
 #define TASK_QUEUE_H
 
-#include <queue>
-#include <mutex>
-#include <condition_variable>
-#include <functional>
+#include <chrono>
+#include <vector>
+#include "inline_task.h"
+
+/**
+ * @enum TaskPriority
+ * @brief Classe de prioridade de uma tarefa (menor valor = mais urgente)
+ */
+enum class TaskPriority {
+    High = 0,       ///< Sensível à latência (ex.: atendimento de requisições)
+    Normal = 1,     ///< Padrão de submit sem prioridade
+    Low = 2         ///< Trabalho de fundo (ex.: compactação)
+};
+
+constexpr size_t NUM_TASK_PRIORITIES = 3; ///< Número de classes de prioridade
 
 /**
  * @class TaskQueue
- * @brief Fila thread-safe para armazenamento de tarefas
+ * @brief Contrato de fila thread-safe para armazenamento de tarefas
  *
- * Implementa uma fila bloqueante que permite produção e consumo seguro
- * de tarefas entre múltiplas threads.
+ * Define a interface bloqueante usada por WorkerThread e ThreadPool.
+ * As implementações concretas são MutexTaskQueue (fila protegida por mutex,
+ * ilimitada ou com capacidade) e RingBufferTaskQueue (anel limitado lock-free).
+ * Em filas limitadas, push espera por espaço; try_push e push_for são as
+ * variantes sem espera e com prazo.
  */
 class TaskQueue {
 public:
-    using Task = std::function<void()>; ///< Tipo da tarefa (função sem retorno)
+    using Task = InlineTask;            ///< Tipo da tarefa (callable move-only sem retorno)
 
     /**
-     * @brief Construtor padrão
+     * @brief Destrutor virtual
      */
-    TaskQueue();
+    virtual ~TaskQueue() = default;
 
     /**
      * @brief Adiciona uma tarefa à fila
      * @param task Tarefa a ser adicionada
      * @return true se bem-sucedido, false se a fila está parada
      */
-    bool push(Task task);
+    virtual bool push(Task task) = 0;
+
+    /**
+     * @brief Adiciona uma tarefa com classe de prioridade
+     *
+     * A implementação padrão ignora a prioridade (fila FIFO única).
+     * @param task Tarefa a ser adicionada
+     * @param priority Classe de prioridade
+     * @return true se bem-sucedido, false se a fila está parada
+     */
+    virtual bool push(Task task, TaskPriority priority);
+
+    /**
+     * @brief Adiciona um lote de tarefas em uma única operação
+     *
+     * Acorda no máximo tantos consumidores adormecidos quanto tarefas no lote.
+     * @param tasks Tarefas a serem adicionadas (movidas; o vetor é esvaziado)
+     * @return true se bem-sucedido, false se a fila está parada
+     */
+    virtual bool push_bulk(std::vector<Task>& tasks) = 0;
+
+    /**
+     * @brief Tenta adicionar uma tarefa sem esperar por espaço
+     *
+     * A implementação padrão (fila ilimitada) equivale a push.
+     * @param task Tarefa a ser adicionada (só é movida em caso de sucesso)
+     * @param priority Classe de prioridade
+     * @return true se adicionou, false se a fila está cheia ou parada
+     */
+    virtual bool try_push(Task& task, TaskPriority priority);
+
+    /**
+     * @brief Adiciona uma tarefa esperando por espaço no máximo timeout
+     *
+     * A implementação padrão (fila ilimitada) equivale a push.
+     * @param task Tarefa a ser adicionada (só é movida em caso de sucesso)
+     * @param priority Classe de prioridade
+     * @param timeout Tempo máximo de espera com a fila cheia
+     * @return true se adicionou, false se expirou ou a fila está parada
+     */
+    virtual bool push_for(Task& task, TaskPriority priority, std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief Remove a tarefa mais antiga da classe menos urgente (descarte)
+     *
+     * A implementação padrão equivale a try_pop.
+     * @param task Referência para armazenar a tarefa removida
+     * @return true se removeu, false se a fila está vazia
+     */
+    virtual bool pop_oldest(Task& task);
 
     /**
      * @brief Remove e retorna uma tarefa da fila (bloqueante)
      * @param task Referência para armazenar a tarefa removida
      * @return true se obteve tarefa, false se a fila está parada e vazia
      */
-    bool pop(Task& task);
+    virtual bool pop(Task& task) = 0;
+
+    /**
+     * @brief Remove uma tarefa da fila sem bloquear
+     * @param task Referência para armazenar a tarefa removida
+     * @return true se obteve tarefa, false se a fila está vazia
+     */
+    virtual bool try_pop(Task& task) = 0;
+
+    /**
+     * @brief Remove até max tarefas da fila sem bloquear
+     * @param tasks Vetor ao qual as tarefas removidas são anexadas
+     * @param max Número máximo de tarefas a remover
+     * @return Número de tarefas removidas
+     */
+    virtual size_t try_pop_bulk(std::vector<Task>& tasks, size_t max) = 0;
 
     /**
      * @brief Para a fila, acordando todas as threads bloqueadas
      */
-    void stop();
+    virtual void stop() = 0;
 
     /**
      * @brief Verifica se a fila está parada
      * @return true se parada, false caso contrário
      */
-    bool stopped() const;
+    virtual bool stopped() const = 0;
 
     /**
      * @brief Retorna o tamanho atual da fila
      * @return Número de tarefas na fila
      */
-    size_t size() const;
+    virtual size_t size() const = 0;
 
-private:
-    mutable std::mutex mutex;                   ///< Mutex para sincronização
-    std::condition_variable condition;          ///< Variável de condição para espera
-    std::queue<Task> queue;                     ///< Fila interna de tarefas
-    bool stop_flag;                             ///< Flag de parada
+    /**
+     * @brief Retorna o número de tarefas de uma classe de prioridade
+     *
+     * A implementação padrão contabiliza todas as tarefas como Normal.
+     * @param priority Classe de prioridade
+     * @return Número de tarefas na fila com essa prioridade
+     */
+    virtual size_t size(TaskPriority priority) const;
+
+    /**
+     * @brief Retorna a capacidade da fila
+     * @return Número máximo de tarefas, ou 0 se ilimitada
+     */
+    virtual size_t capacity() const;
 };
 
+// Implementações padrão para filas sem níveis de prioridade
+inline bool TaskQueue::push(Task task, TaskPriority) {
+    return push(std::move(task));
+}
+
+inline size_t TaskQueue::size(TaskPriority priority) const {
+    return priority == TaskPriority::Normal ? size() : 0;
+}
+
+// Implementações padrão para filas ilimitadas
+inline bool TaskQueue::try_push(Task& task, TaskPriority priority) {
+    return push(std::move(task), priority);
+}
+
+inline bool TaskQueue::push_for(Task& task, TaskPriority priority, std::chrono::nanoseconds) {
+    return push(std::move(task), priority);
+}
+
+inline bool TaskQueue::pop_oldest(Task& task) {
+    return try_pop(task);
+}
+
+inline size_t TaskQueue::capacity() const {
+    return 0;
+}
+
 #endif
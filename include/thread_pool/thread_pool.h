@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <queue>
+#include <deque>
+#include <cstdint>
 #include <memory>
 #include <thread>
 #include <mutex>
@@ -10,8 +12,42 @@
 #include <future>
 #include <functional>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <iterator>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <utility>
 #include "task_queue.h"
+#include "cancellation.h"
+#include "task_future.h"
+#include "event_count.h"
+#include "slab_pool.h"
+#include "join_handle.h"
+#include "helping_wait.h"
 #include "worker_thread.h"
+#include "work_stealing_scheduler.h"
+#include "thread_pool_options.h"
+#include "thread_pool_stats.h"
+#include "timer_wheel.h"
+#include "trace_recorder.h"
+
+// Interface de corrotinas: só existe quando compilado em C++20 (ENABLE_COROUTINES)
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define THREAD_POOL_HAS_COROUTINES 1
+#endif
+
+/**
+ * @class QueueFullError
+ * @brief Lançada por submit quando a fila está cheia e a política é Fail
+ */
+class QueueFullError : public std::runtime_error {
+public:
+    QueueFullError() : std::runtime_error("Fila do ThreadPool cheia, tarefa rejeitada") {}
+};
 
 /**
  * @class ThreadPool
@@ -19,7 +55,9 @@
  *
  * Esta classe gerencia um conjunto de threads workers que processam tarefas
  * de forma assíncrona. Oferece interface para submeter tarefas e recuperar
- * seus resultados via futures.
+ * seus resultados via futures. Configurado com min_threads < max_threads,
+ * cresce sob backlog e aposenta workers ociosos. Com fila limitada, submit
+ * aplica a RejectionPolicy quando a fila está cheia.
  */
 class ThreadPool {
 public:
@@ -29,6 +67,12 @@ public:
      */
     explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency());
 
+    /**
+     * @brief Construtor que inicializa o pool a partir de opções
+     * @param options Número de threads, modo de escalonamento e backend da fila
+     */
+    explicit ThreadPool(const ThreadPoolOptions& options);
+
     /**
      * @brief Destrutor que para todas as threads e espera conclusão
      */
@@ -44,46 +88,713 @@ public:
      */
     template<class F, class... Args>
     auto submit(F&& f, Args&&... args)
-        -> std::future<typename std::result_of<F(Args...)>::type>;
+        -> std::future<std::invoke_result_t<F, Args...>>;
+
+    /**
+     * @brief Submete uma tarefa com classe de prioridade
+     *
+     * Tarefas High passam à frente de Normal e Low; uma tarefa de nível
+     * inferior que esperou mais que ThreadPoolOptions::priority_aging por
+     * nível de diferença é servida mesmo com níveis superiores ocupados.
+     * @param priority Classe de prioridade
+     * @param f Função a ser executada
+     * @param args Argumentos para a função
+     * @return Future com o resultado da execução
+     */
+    template<class F, class... Args>
+    auto submit(TaskPriority priority, F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<F, Args...>>;
+
+    /**
+     * @brief Submete uma tarefa cancelável
+     *
+     * Se o grupo do token for cancelado antes de a tarefa começar, o worker
+     * a descarta sem executar f e o future recebe TaskCancelledError. Depois
+     * de começar, a tarefa só para se consultar o token (capturado por f).
+     * @param token Token do grupo da tarefa (CancellationSource::token())
+     * @param f Função a ser executada
+     * @param args Argumentos para a função
+     * @return Future com o resultado ou TaskCancelledError
+     */
+    template<class F, class... Args>
+    auto submit(const CancellationToken& token, F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<F, Args...>>;
+
+    /**
+     * @brief Submete uma tarefa cancelável com classe de prioridade
+     * @param token Token do grupo da tarefa
+     * @param priority Classe de prioridade
+     * @param f Função a ser executada
+     * @param args Argumentos para a função
+     * @return Future com o resultado ou TaskCancelledError
+     */
+    template<class F, class... Args>
+    auto submit(const CancellationToken& token, TaskPriority priority, F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<F, Args...>>;
+
+    /**
+     * @brief Submete uma tarefa devolvendo um TaskFuture em vez de std::future
+     *
+     * O TaskFuture aceita continuações (then) e combinadores (when_all,
+     * when_any) sem thread bloqueada; a fila e a RejectionPolicy são as de submit.
+     * @param f Função a ser executada
+     * @param args Argumentos para a função
+     * @return TaskFuture com o resultado
+     */
+    template<class F, class... Args>
+    auto async(F&& f, Args&&... args)
+        -> TaskFuture<std::invoke_result_t<F, Args...>>;
+
+    /**
+     * @brief Submete uma tarefa devolvendo um TaskFuture, com classe de prioridade
+     * @param priority Classe de prioridade
+     * @param f Função a ser executada
+     * @param args Argumentos para a função
+     * @return TaskFuture com o resultado
+     */
+    template<class F, class... Args>
+    auto async(TaskPriority priority, F&& f, Args&&... args)
+        -> TaskFuture<std::invoke_result_t<F, Args...>>;
+
+    /**
+     * @brief Submete uma tarefa apenas se houver espaço na fila, sem esperar
+     *
+     * Não aplica a RejectionPolicy; com fila ilimitada sempre aceita.
+     * @param f Função a ser executada
+     * @param args Argumentos para a função
+     * @return Future com o resultado, ou vazio se a fila está cheia
+     * @throws std::runtime_error se o pool está parado
+     */
+    template<class F, class... Args>
+    auto try_submit(F&& f, Args&&... args)
+        -> std::optional<std::future<std::invoke_result_t<F, Args...>>>;
+
+    /**
+     * @brief Submete uma tarefa esperando por espaço no máximo timeout
+     *
+     * Não aplica a RejectionPolicy; com fila ilimitada sempre aceita.
+     * @param timeout Tempo máximo de espera com a fila cheia
+     * @param f Função a ser executada
+     * @param args Argumentos para a função
+     * @return Future com o resultado, ou vazio se o prazo expirou
+     * @throws std::runtime_error se o pool está parado
+     */
+    template<class Rep, class Period, class F, class... Args>
+    auto submit_for(const std::chrono::duration<Rep, Period>& timeout, F&& f, Args&&... args)
+        -> std::optional<std::future<std::invoke_result_t<F, Args...>>>;
+
+    /**
+     * @brief Submete uma tarefa sem future (fire-and-forget)
+     *
+     * Evita o estado de promise/future quando o resultado é entregue por
+     * outro caminho (ex.: TaskGraph). Exceções que escapam da tarefa são
+     * registradas pelo worker e descartadas.
+     * @param f Callable sem argumentos
+     * @param priority Classe de prioridade
+     */
+    template<class F>
+    void execute(F&& f, TaskPriority priority = TaskPriority::Normal);
+
+    /**
+     * @brief Submete uma tarefa cancelável sem future
+     *
+     * Se o grupo do token for cancelado antes de a tarefa começar, ela é
+     * descartada sem executar.
+     * @param token Token do grupo da tarefa
+     * @param f Callable sem argumentos
+     * @param priority Classe de prioridade
+     */
+    template<class F>
+    void execute(const CancellationToken& token, F&& f, TaskPriority priority = TaskPriority::Normal);
+
+    /**
+     * @brief Executa uma tarefa no pool depois de um atraso
+     *
+     * O prazo é vigiado pela thread do TimerWheel (criada no primeiro
+     * agendamento); nenhum worker fica ocupado esperando. No vencimento a
+     * tarefa entra na fila como em execute().
+     * @param delay Atraso mínimo
+     * @param f Callable sem argumentos
+     * @return Id para cancel_timer
+     */
+    template<class Rep, class Period, class F>
+    TimerId schedule_after(const std::chrono::duration<Rep, Period>& delay, F&& f);
+
+    /**
+     * @brief Executa uma tarefa no pool a partir de um instante
+     * @param when Instante mínimo de execução
+     * @param f Callable sem argumentos
+     * @return Id para cancel_timer
+     */
+    template<class F>
+    TimerId schedule_at(std::chrono::steady_clock::time_point when, F&& f);
+
+    /**
+     * @brief Executa uma tarefa no pool a cada período
+     *
+     * O primeiro disparo ocorre após um período; um disparo é pulado se a
+     * execução anterior ainda não terminou.
+     * @param period Intervalo entre disparos
+     * @param f Callable sem argumentos (chamado várias vezes)
+     * @return Id para cancel_timer
+     */
+    template<class Rep, class Period, class F>
+    TimerId schedule_every(const std::chrono::duration<Rep, Period>& period, F&& f);
+
+    /**
+     * @brief Cancela um timer pendente (ou os próximos disparos de um periódico)
+     * @param id Id retornado pelo agendamento
+     * @return true se o timer estava pendente
+     */
+    bool cancel_timer(TimerId id);
+
+#ifdef THREAD_POOL_HAS_COROUTINES
+    /**
+     * @class ScheduleAwaiter
+     * @brief Awaitable que retoma a corrotina em um worker do pool
+     *
+     * A retomada é enfileirada como uma InlineTask que guarda só o
+     * coroutine_handle: sem packaged_task, promise ou future.
+     */
+    class ScheduleAwaiter {
+    public:
+        ScheduleAwaiter(ThreadPool& pool, TaskPriority priority)
+            : pool(pool), priority(priority) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        /**
+         * @brief Enfileira a retomada; lança se o pool está parado
+         */
+        void await_suspend(std::coroutine_handle<> handle) {
+            pool.execute([handle]() { handle.resume(); }, priority);
+        }
+
+        void await_resume() const noexcept {}
+
+    private:
+        ThreadPool& pool;                       ///< Pool onde a corrotina continua
+        TaskPriority priority;                  ///< Classe de prioridade da retomada
+    };
+
+    /**
+     * @brief Transfere a corrotina atual para um worker: co_await pool.schedule()
+     * @param priority Classe de prioridade da retomada
+     * @return Awaitable que enfileira a retomada
+     */
+    ScheduleAwaiter schedule(TaskPriority priority = TaskPriority::Normal) {
+        return ScheduleAwaiter(*this, priority);
+    }
+#endif
+
+    /**
+     * @brief Executa fn(i) para cada i em [begin, end) em paralelo
+     *
+     * Enfileira no máximo um pedaço por worker em uma única operação de fila.
+     * Cada pedaço reivindica sub-intervalos de forma adaptativa (guided
+     * scheduling): blocos grandes no início e nunca menores que grain no fim,
+     * equilibrando a carga sem uma tarefa por índice.
+     * @param begin Primeiro índice
+     * @param end Índice após o último
+     * @param grain Menor número de índices processados por reivindicação
+     * @param fn Função chamada com cada índice (pode ser chamada concorrentemente)
+     * @return Handle único para aguardar o laço inteiro
+     */
+    template<class Begin, class End, class F>
+    JoinHandle parallel_for(Begin begin, End end, size_t grain, F&& fn);
+
+    /**
+     * @brief Executa fn(part, lo, hi) sobre sub-intervalos de [begin, end) em paralelo
+     *
+     * Mesmo escalonamento adaptativo de parallel_for, mas o corpo recebe
+     * cada sub-intervalo reivindicado e o índice do pedaço que o executa.
+     * Um pedaço roda em um único worker, do início ao fim, então acumuladores
+     * indexados por part dispensam sincronização.
+     * @param begin Primeiro índice
+     * @param end Índice após o último
+     * @param grain Menor número de índices por reivindicação
+     * @param parts Número de pedaços (0: um por worker); limitado ao número de blocos de grain
+     * @param fn Função chamada com (part, lo, hi), part em [0, parts)
+     * @return Handle único para aguardar o laço inteiro
+     */
+    template<class Begin, class End, class F>
+    JoinHandle parallel_chunks(Begin begin, End end, size_t grain, size_t parts, F&& fn);
+
+    /**
+     * @brief Executa fn(elemento) para cada elemento de um range em paralelo
+     *
+     * O range deve ter iteradores de acesso aleatório e continuar vivo até
+     * o handle ser aguardado.
+     * @param range Container ou range com std::begin/std::end
+     * @param fn Função chamada com cada elemento
+     * @return Handle único para aguardar o lote inteiro
+     */
+    template<class Range, class F>
+    JoinHandle submit_bulk(Range& range, F&& fn);
 
     /**
-     * @brief Retorna o número de threads ativas no pool
+     * @brief Retorna o número de threads vivas no pool (leitura sem lock)
      * @return Número de threads
      */
     size_t size() const;
 
+    /**
+     * @brief Retorna um retrato do pool, incluindo os eventos de redimensionamento
+     *
+     * Os contadores de cada worker (tarefas, tempo ocupado e ocioso,
+     * histogramas de espera na fila e de execução) são lidos sem parar os
+     * workers nem travar a fila; os de workers aposentados continuam nos totais.
+     * @return Estatísticas do pool
+     */
+    ThreadPoolStats stats() const;
+
+    /**
+     * @brief Liga a gravação da linha do tempo (submissão, início e fim de cada tarefa)
+     *
+     * Nomes vêm do TraceLabel em vigor na thread que submete. Desligada, a
+     * gravação custa um teste de bool por submissão.
+     */
+    void start_tracing();
+
+    /**
+     * @brief Desliga a gravação; os eventos gravados continuam disponíveis
+     */
+    void stop_tracing();
+
+    /**
+     * @brief Escreve os eventos gravados como Chrome trace JSON (abre no Perfetto)
+     *
+     * Pode ser chamado com a gravação ligada; eventos concorrentes podem
+     * ficar de fora.
+     * @param out Destino do JSON
+     */
+    void write_trace(std::ostream& out) const;
+
     /**
      * @brief Verifica se o pool está parado
      * @return true se parado, false caso contrário
      */
     bool stopped() const;
 
+    /**
+     * @brief Retorna o modo de escalonamento do pool
+     * @return Modo escolhido na construção
+     */
+    SchedulerMode scheduler_mode() const;
+
+    /**
+     * @brief Retorna a profundidade de fila de uma classe de prioridade
+     * @param priority Classe de prioridade
+     * @return Número de tarefas aguardando execução (leitura sem lock)
+     */
+    size_t queue_depth(TaskPriority priority) const;
+
 private:
+    friend class Strand;
+
+    /**
+     * @brief Empacota função e argumentos em uma tarefa ligada a um future
+     */
+    template<class F, class... Args>
+    static auto package(F&& f, Args&&... args)
+        -> std::pair<TaskQueue::Task, std::future<std::invoke_result_t<F, Args...>>>;
+
+    /**
+     * @brief Empacota como package, mas descarta a tarefa se o token foi cancelado ao começar
+     */
+    template<class F, class... Args>
+    static auto package_cancellable(const CancellationToken& token, F&& f, Args&&... args)
+        -> std::pair<TaskQueue::Task, std::future<std::invoke_result_t<F, Args...>>>;
+
+    /**
+     * @brief Enfileira uma tarefa, aplicando a RejectionPolicy se a fila está cheia
+     * @param task Tarefa a ser enfileirada
+     * @param priority Classe de prioridade
+     * @return true se bem-sucedido, false se o pool está parado
+     * @throws QueueFullError com a fila cheia e política Fail
+     */
+    bool enqueue(TaskQueue::Task task, TaskPriority priority = TaskPriority::Normal);
+
+    /**
+     * @brief Enfileira uma tarefa esperando por espaço no máximo timeout
+     * @param task Tarefa (só é movida em caso de sucesso)
+     * @param priority Classe de prioridade
+     * @param timeout Tempo máximo de espera (zero: não espera)
+     * @return true se enfileirou, false se a fila está cheia ou o pool parado
+     */
+    bool enqueue_for(TaskQueue::Task& task, TaskPriority priority, std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief Publica na fila compartilhada ou no escalonador e acorda um worker
+     * @param task Tarefa (só é movida em caso de sucesso, exceto na espera sem prazo)
+     * @param priority Classe de prioridade
+     * @param timeout Zero: não espera; nanoseconds::max(): espera sem prazo
+     * @return true se publicou
+     */
+    bool publish(TaskQueue::Task& task, TaskPriority priority, std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief Verifica se a fila (ou o escalonador) já foi parada
+     */
+    bool queue_stopped() const;
+
+    /**
+     * @brief Retorna a roda de timers, criando-a (e sua thread) no primeiro uso
+     */
+    TimerWheel& timers();
+
+    /**
+     * @brief Enfileira um lote de tarefas em uma única operação
+     * @param tasks Tarefas a serem enfileiradas (o vetor é esvaziado)
+     * @return true se bem-sucedido, false se o pool está parado
+     */
+    bool enqueue_bulk(std::vector<TaskQueue::Task>& tasks);
+
+    /**
+     * @brief Cresce o pool se a fila acumulou trabalho sem worker ocioso
+     */
+    void maybe_grow();
+
+    /**
+     * @brief Cria um worker se o pool está abaixo do máximo
+     * @param reason Motivo do crescimento
+     */
+    void grow(ResizeReason reason);
+
+    /**
+     * @brief Decide se um worker ocioso pode se aposentar (chamado pelo worker)
+     * @return true se o worker deve sair
+     */
+    bool retire_worker();
+
+    /**
+     * @brief Cria e registra um worker (requer resize_mutex)
+     */
+    void add_worker();
+
+    /**
+     * @brief Junta workers aposentados e libera seus índices (requer resize_mutex)
+     */
+    void reap_workers();
+
+    /**
+     * @brief Registra um evento de redimensionamento (requer resize_mutex)
+     */
+    void record_resize(size_t from, size_t to, ResizeReason reason);
+
     std::vector<std::unique_ptr<WorkerThread>> workers; ///< Vetor de threads workers
-    std::shared_ptr<TaskQueue> task_queue;              ///< Fila compartilhada de tarefas
-    bool stop;                                          ///< Flag de parada
+    std::shared_ptr<TaskQueue> task_queue;              ///< Fila compartilhada (modo SharedQueue)
+    std::shared_ptr<WorkStealingScheduler> scheduler;   ///< Escalonador (modo WorkStealing)
+    std::shared_ptr<EventCount> idle;                   ///< Espera dos ociosos (modo SharedQueue)
+    SchedulerMode mode;                                 ///< Modo de escalonamento
+    std::atomic<bool> stop;                             ///< Flag de parada
+    bool bounded = false;                               ///< Fila limitada (aplica rejection_policy)
+    std::atomic<size_t> rejected_count{0};              ///< Submissões rejeitadas, executadas pelo chamador ou descartadas
+    std::atomic<size_t> blocked_count{0};               ///< Submissões que esperaram por espaço
+
+    ThreadPoolOptions config;                           ///< Opções usadas ao criar workers
+    size_t min_threads;                                 ///< Limite inferior de threads vivas
+    size_t max_threads;                                 ///< Limite superior de threads vivas
+    std::atomic<size_t> live{0};                        ///< Threads vivas
+    std::atomic<int64_t> backlog_since{0};              ///< Início do backlog atual em ns (0: sem backlog)
+    mutable std::mutex resize_mutex;                    ///< Protege workers, índices livres e eventos
+    std::vector<size_t> free_indices;                   ///< Deques locais sem dono (modo WorkStealing)
+    std::deque<ResizeEvent> resize_events;              ///< Últimos eventos de redimensionamento
+    size_t peak_threads = 0;                            ///< Maior número de threads vivas
+    size_t grow_events = 0;                             ///< Total de crescimentos
+    size_t shrink_events = 0;                           ///< Total de aposentadorias
+    WorkerStats retired_stats;                          ///< Contadores somados dos workers já juntados
+    TraceRecorder tracer;                               ///< Linha do tempo das tarefas (desligada por padrão)
+    std::vector<int> placement;                         ///< CPU de cada posição de worker (vazio: sem fixação)
+    std::vector<size_t> placement_domains;              ///< Domínio de LLC de cada posição
+    size_t next_placement = 0;                          ///< Próxima posição (modo SharedQueue)
+    std::once_flag timers_once;                         ///< Criação preguiçosa da roda de timers
+    std::unique_ptr<TimerWheel> timer_wheel;            ///< Timers pendentes (nullptr até o primeiro uso)
 };
 
 // Implementação do template (deve estar no header)
 template<class F, class... Args>
 auto ThreadPool::submit(F&& f, Args&&... args)
-    -> std::future<typename std::result_of<F(Args...)>::type> {
-
-    using return_type = typename std::result_of<F(Args...)>::type;
+    -> std::future<std::invoke_result_t<F, Args...>> {
+    return submit(TaskPriority::Normal, std::forward<F>(f), std::forward<Args>(args)...);
+}
 
-    // Cria um packaged_task com a função e argumentos
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-    );
+template<class F, class... Args>
+auto ThreadPool::submit(TaskPriority priority, F&& f, Args&&... args)
+    -> std::future<std::invoke_result_t<F, Args...>> {
 
-    std::future<return_type> result = task->get_future();
+    auto [task, result] = package(std::forward<F>(f), std::forward<Args>(args)...);
 
     // Adiciona tarefa à fila
-    if (!task_queue->push([task](){ (*task)(); })) {
+    if (!enqueue(std::move(task), priority)) {
+        throw std::runtime_error("ThreadPool está parado, não pode aceitar tarefas");
+    }
+
+    return std::move(result);
+}
+
+template<class F, class... Args>
+auto ThreadPool::submit(const CancellationToken& token, F&& f, Args&&... args)
+    -> std::future<std::invoke_result_t<F, Args...>> {
+    return submit(token, TaskPriority::Normal, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template<class F, class... Args>
+auto ThreadPool::submit(const CancellationToken& token, TaskPriority priority, F&& f, Args&&... args)
+    -> std::future<std::invoke_result_t<F, Args...>> {
+
+    auto [task, result] = package_cancellable(token, std::forward<F>(f), std::forward<Args>(args)...);
+
+    if (!enqueue(std::move(task), priority)) {
+        throw std::runtime_error("ThreadPool está parado, não pode aceitar tarefas");
+    }
+
+    return std::move(result);
+}
+
+template<class F, class... Args>
+auto ThreadPool::async(F&& f, Args&&... args)
+    -> TaskFuture<std::invoke_result_t<F, Args...>> {
+    return async(TaskPriority::Normal, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template<class F, class... Args>
+auto ThreadPool::async(TaskPriority priority, F&& f, Args&&... args)
+    -> TaskFuture<std::invoke_result_t<F, Args...>> {
+
+    using return_type = std::invoke_result_t<F, Args...>;
+
+    TaskPromise<return_type> promise;
+    TaskFuture<return_type> result = promise.get_future();
+
+    // Tarefa descartada pela RejectionPolicy destrói o promise: broken_promise
+    auto task = [promise = std::move(promise),
+                 function = std::forward<F>(f),
+                 arguments = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+        std::apply([&promise, &function](auto&... values) {
+            detail::fulfil(promise, function, values...);
+        }, arguments);
+    };
+
+    if (!enqueue(TaskQueue::Task(std::move(task)), priority)) {
         throw std::runtime_error("ThreadPool está parado, não pode aceitar tarefas");
     }
 
     return result;
 }
 
+template<class F, class... Args>
+auto ThreadPool::try_submit(F&& f, Args&&... args)
+    -> std::optional<std::future<std::invoke_result_t<F, Args...>>> {
+    return submit_for(std::chrono::nanoseconds::zero(), std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template<class Rep, class Period, class F, class... Args>
+auto ThreadPool::submit_for(const std::chrono::duration<Rep, Period>& timeout, F&& f, Args&&... args)
+    -> std::optional<std::future<std::invoke_result_t<F, Args...>>> {
+
+    auto [task, result] = package(std::forward<F>(f), std::forward<Args>(args)...);
+
+    if (!enqueue_for(task, TaskPriority::Normal,
+                     std::chrono::duration_cast<std::chrono::nanoseconds>(timeout))) {
+        if (queue_stopped()) {
+            throw std::runtime_error("ThreadPool está parado, não pode aceitar tarefas");
+        }
+        return std::nullopt;
+    }
+
+    return std::move(result);
+}
+
+template<class F, class... Args>
+auto ThreadPool::package(F&& f, Args&&... args)
+    -> std::pair<TaskQueue::Task, std::future<std::invoke_result_t<F, Args...>>> {
+
+    using return_type = std::invoke_result_t<F, Args...>;
+
+    // Estado compartilhado do promise/future vem do SlabPool, não do heap
+    std::promise<return_type> promise(std::allocator_arg, PoolAllocator<return_type>());
+    std::future<return_type> result = promise.get_future();
+
+    // Função e argumentos são capturados por valor, como faria std::bind;
+    // a lambda costuma caber no buffer inline da InlineTask
+    auto task = [promise = std::move(promise),
+                 function = std::forward<F>(f),
+                 arguments = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+        try {
+            if constexpr (std::is_void_v<return_type>) {
+                std::apply(function, arguments);
+                promise.set_value();
+            } else {
+                promise.set_value(std::apply(function, arguments));
+            }
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    };
+
+    return {TaskQueue::Task(std::move(task)), std::move(result)};
+}
+
+template<class F, class... Args>
+auto ThreadPool::package_cancellable(const CancellationToken& token, F&& f, Args&&... args)
+    -> std::pair<TaskQueue::Task, std::future<std::invoke_result_t<F, Args...>>> {
+
+    using return_type = std::invoke_result_t<F, Args...>;
+
+    std::promise<return_type> promise(std::allocator_arg, PoolAllocator<return_type>());
+    std::future<return_type> result = promise.get_future();
+
+    // O token é consultado quando o worker tira a tarefa da fila: cancelada,
+    // o corpo nem é chamado e o future recebe TaskCancelledError sem throw
+    auto task = [promise = std::move(promise),
+                 token,
+                 function = std::forward<F>(f),
+                 arguments = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+        if (token.cancelled()) {
+            promise.set_exception(std::make_exception_ptr(TaskCancelledError()));
+            return;
+        }
+        try {
+            if constexpr (std::is_void_v<return_type>) {
+                std::apply(function, arguments);
+                promise.set_value();
+            } else {
+                promise.set_value(std::apply(function, arguments));
+            }
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    };
+
+    return {TaskQueue::Task(std::move(task)), std::move(result)};
+}
+
+template<class F>
+void ThreadPool::execute(F&& f, TaskPriority priority) {
+    if (!enqueue(TaskQueue::Task(std::forward<F>(f)), priority)) {
+        throw std::runtime_error("ThreadPool está parado, não pode aceitar tarefas");
+    }
+}
+
+template<class F>
+void ThreadPool::execute(const CancellationToken& token, F&& f, TaskPriority priority) {
+    execute([token, function = std::forward<F>(f)]() mutable {
+        if (!token.cancelled()) function();
+    }, priority);
+}
+
+template<class Rep, class Period, class F>
+TimerId ThreadPool::schedule_after(const std::chrono::duration<Rep, Period>& delay, F&& f) {
+    auto when = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay);
+    return timers().schedule_at(when, TaskQueue::Task(std::forward<F>(f)));
+}
+
+template<class F>
+TimerId ThreadPool::schedule_at(std::chrono::steady_clock::time_point when, F&& f) {
+    return timers().schedule_at(when, TaskQueue::Task(std::forward<F>(f)));
+}
+
+template<class Rep, class Period, class F>
+TimerId ThreadPool::schedule_every(const std::chrono::duration<Rep, Period>& period, F&& f) {
+    auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+    return timers().schedule_every(std::chrono::steady_clock::now() + interval, interval,
+                                   TaskQueue::Task(std::forward<F>(f)));
+}
+
+template<class Begin, class End, class F>
+JoinHandle ThreadPool::parallel_for(Begin begin, End end, size_t grain, F&& fn) {
+    using Index = std::common_type_t<Begin, End>;
+    static_assert(std::is_integral_v<Index>, "parallel_for requer índices inteiros");
+
+    return parallel_chunks(begin, end, grain, 0,
+        [body = std::forward<F>(fn)](size_t, Index lo, Index hi) mutable {
+            for (Index i = lo; i < hi; ++i) {
+                body(i);
+            }
+        });
+}
+
+template<class Begin, class End, class F>
+JoinHandle ThreadPool::parallel_chunks(Begin begin, End end, size_t grain, size_t parts, F&& fn) {
+    using Index = std::common_type_t<Begin, End>;
+    static_assert(std::is_integral_v<Index>, "parallel_chunks requer índices inteiros");
+
+    Index first = static_cast<Index>(begin);
+    Index last = static_cast<Index>(end);
+    if (last <= first) return JoinHandle();
+
+    /**
+     * @struct Loop
+     * @brief Estado compartilhado pelos pedaços do laço
+     */
+    struct Loop {
+        Loop(F&& fn, Index first, size_t total, size_t grain, size_t parts)
+            : body(std::forward<F>(fn)), first(first), total(total), grain(grain), parts(parts) {}
+
+        std::decay_t<F> body;                   ///< Corpo do laço
+        Index first;                            ///< Primeiro índice
+        size_t total;                           ///< Número de índices
+        size_t grain;                           ///< Menor bloco reivindicado
+        size_t parts;                           ///< Número de pedaços enfileirados
+        std::atomic<size_t> next{0};            ///< Próximo índice não reivindicado
+    };
+
+    size_t total = static_cast<size_t>(last - first);
+    grain = std::max<size_t>(grain, 1);
+    size_t chunks = (total + grain - 1) / grain;
+    parts = std::min(chunks, parts ? parts : std::max<size_t>(size(), 1));
+
+    auto loop = std::allocate_shared<Loop>(PoolAllocator<Loop>(),
+        std::forward<F>(fn), first, total, grain, parts);
+    JoinHandle handle(parts);
+
+    std::vector<TaskQueue::Task> tasks;
+    tasks.reserve(parts);
+    for (size_t part = 0; part < parts; ++part) {
+        tasks.emplace_back([loop, part, state = handle.shared_state()]() {
+            try {
+                while (!state->failed()) {
+                    // Reivindica uma fração do que resta, nunca menos que grain
+                    size_t claimed = loop->next.load(std::memory_order_relaxed);
+                    if (claimed >= loop->total) break;
+                    size_t chunk = std::max(loop->grain, (loop->total - claimed) / (2 * loop->parts));
+
+                    size_t start = loop->next.fetch_add(chunk, std::memory_order_relaxed);
+                    if (start >= loop->total) break;
+                    size_t stop = std::min(loop->total, start + chunk);
+
+                    loop->body(part, static_cast<Index>(loop->first + static_cast<Index>(start)),
+                               static_cast<Index>(loop->first + static_cast<Index>(stop)));
+                }
+            } catch (...) {
+                state->fail(std::current_exception());
+            }
+            state->complete();
+        });
+    }
+
+    if (!enqueue_bulk(tasks)) {
+        throw std::runtime_error("ThreadPool está parado, não pode aceitar tarefas");
+    }
+
+    return handle;
+}
+
+template<class Range, class F>
+JoinHandle ThreadPool::submit_bulk(Range& range, F&& fn) {
+    auto first = std::begin(range);
+    using Iterator = decltype(first);
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                      typename std::iterator_traits<Iterator>::iterator_category>,
+                  "submit_bulk requer iteradores de acesso aleatório");
+
+    size_t count = static_cast<size_t>(std::distance(first, std::end(range)));
+    return parallel_for(size_t{0}, count, 1,
+        [first, body = std::forward<F>(fn)](size_t i) mutable {
+            body(first[static_cast<typename std::iterator_traits<Iterator>::difference_type>(i)]);
+        });
+}
+
 #endif
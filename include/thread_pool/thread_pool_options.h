@@ -0,0 +1,108 @@
+#ifndef THREAD_POOL_OPTIONS_H
+#define THREAD_POOL_OPTIONS_H
+
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @enum SchedulerMode
+ * @brief Estratégia de distribuição de tarefas entre os workers
+ */
+enum class SchedulerMode {
+    SharedQueue,    ///< Uma única TaskQueue compartilhada por todos os workers
+    WorkStealing    ///< Deque local por worker com roubo de tarefas entre workers
+};
+
+/**
+ * @enum QueueBackend
+ * @brief Implementação de TaskQueue usada pelo pool
+ */
+enum class QueueBackend {
+    Mutex,          ///< MutexTaskQueue: fila ilimitada protegida por mutex
+    RingBuffer      ///< RingBufferTaskQueue: anel limitado lock-free
+};
+
+/**
+ * @enum RejectionPolicy
+ * @brief O que submit faz quando a fila limitada está cheia
+ *
+ * Vale para submit e execute; try_submit e submit_for nunca aplicam a
+ * política (retornam vazio). Lotes de parallel_for sempre esperam por espaço.
+ */
+enum class RejectionPolicy {
+    Block,          ///< Espera por espaço (contado como submissão bloqueada)
+    CallerRuns,     ///< Executa a tarefa na thread que submeteu
+    DropOldest,     ///< Descarta a tarefa mais antiga da classe menos urgente; o future dela recebe broken_promise
+    Fail            ///< Lança QueueFullError
+};
+
+/**
+ * @enum AffinityMode
+ * @brief Fixação dos workers em CPUs (ver CpuTopology::placement)
+ */
+enum class AffinityMode {
+    None,           ///< Sem fixação: o kernel migra as threads livremente
+    Compact,        ///< Preenche um domínio de LLC antes de passar ao próximo
+    Scatter         ///< Alterna entre domínios de LLC
+};
+
+/**
+ * @struct WaitStrategy
+ * @brief Como um worker ocioso espera por trabalho
+ *
+ * O worker primeiro tenta spin_iterations vezes com pausa de CPU, depois
+ * yield_iterations vezes cedendo a vez ao sistema e só então dorme em um
+ * EventCount. Com os dois contadores em zero, dorme imediatamente.
+ */
+struct WaitStrategy {
+    size_t spin_iterations = 0;                 ///< Tentativas com pausa de CPU
+    size_t yield_iterations = 0;                ///< Tentativas com std::this_thread::yield
+
+    /**
+     * @brief Estratégia que dorme assim que a fila esvazia
+     */
+    static WaitStrategy park() { return WaitStrategy{}; }
+
+    /**
+     * @brief Estratégia híbrida: gira, cede a vez e então dorme
+     * @param spins Tentativas com pausa de CPU
+     * @param yields Tentativas com yield
+     */
+    static WaitStrategy spin_then_park(size_t spins = 2000, size_t yields = 50) {
+        return WaitStrategy{spins, yields};
+    }
+};
+
+/**
+ * @struct ThreadPoolOptions
+ * @brief Opções de construção do ThreadPool
+ *
+ * Com max_threads maior que min_threads o pool é elástico: começa com
+ * num_threads (limitado a [min_threads, max_threads]), cresce quando a fila
+ * acumula grow_queue_depth tarefas sem worker ocioso ou fica com backlog por
+ * grow_wait_time, e aposenta workers ociosos por idle_timeout até min_threads.
+ */
+struct ThreadPoolOptions {
+    size_t num_threads = std::thread::hardware_concurrency(); ///< Número de threads no pool
+    SchedulerMode scheduler = SchedulerMode::SharedQueue;     ///< Modo de escalonamento
+    QueueBackend queue_backend = QueueBackend::Mutex;         ///< Implementação da fila
+    size_t queue_capacity = 4096;                             ///< Capacidade do anel (RingBuffer)
+    size_t queue_limit = 0;                                   ///< Capacidade da fila Mutex (0: ilimitada)
+    RejectionPolicy rejection_policy = RejectionPolicy::Block; ///< Reação de submit à fila cheia
+    std::chrono::milliseconds priority_aging{10};             ///< Atraso efetivo por nível abaixo de High
+    WaitStrategy wait_strategy{};                             ///< Espera dos workers ociosos
+    size_t min_threads = 0;                                   ///< Mínimo de threads vivas (0: num_threads)
+    size_t max_threads = 0;                                   ///< Máximo de threads vivas (0: num_threads)
+    std::chrono::milliseconds idle_timeout{5000};             ///< Ociosidade que aposenta um worker excedente
+    size_t grow_queue_depth = 16;                             ///< Profundidade de fila que dispara crescimento
+    std::chrono::milliseconds grow_wait_time{10};             ///< Duração de backlog que dispara crescimento
+    AffinityMode affinity = AffinityMode::None;               ///< Fixação dos workers em CPUs
+    std::vector<int> cpu_set{};                               ///< CPUs permitidas (vazio: todas as online)
+    std::chrono::milliseconds timer_resolution{1};            ///< Tick da roda de timers (schedule_after/every)
+    bool task_metrics = true;                                 ///< Mede espera na fila e execução de cada tarefa (stats())
+    bool tracing = false;                                     ///< Começa gravando a linha do tempo (start_tracing())
+};
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef THREAD_POOL_STATS_H
+#define THREAD_POOL_STATS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @enum ResizeReason
+ * @brief Motivo de uma mudança no número de threads do pool
+ */
+enum class ResizeReason {
+    QueueDepth,     ///< Fila acumulou tarefas sem worker ocioso
+    QueueWait,      ///< Fila ficou com backlog por tempo demais
+    IdleTimeout     ///< Worker excedente ficou ocioso e se aposentou
+};
+
+/**
+ * @struct ResizeEvent
+ * @brief Registro de um crescimento ou encolhimento do pool
+ */
+struct ResizeEvent {
+    std::chrono::steady_clock::time_point when; ///< Instante da mudança
+    size_t from;                                ///< Threads vivas antes
+    size_t to;                                  ///< Threads vivas depois
+    ResizeReason reason;                        ///< Motivo
+};
+
+/**
+ * @struct LatencyHistogram
+ * @brief Histograma de durações com baldes logarítmicos (potências de dois em ns)
+ *
+ * O balde 0 conta durações de 0ns; o balde b > 0 conta durações em
+ * [2^(b-1), 2^b) ns. O último balde absorve tudo acima (cerca de 39 horas).
+ * Percentis são aproximados pelo limite superior do balde, com erro de no
+ * máximo 2x.
+ */
+struct LatencyHistogram {
+    static constexpr size_t BUCKETS = 48;       ///< Número de baldes
+
+    std::array<uint64_t, BUCKETS> buckets{};    ///< Contagem por balde
+    uint64_t count = 0;                         ///< Total de amostras
+    std::chrono::nanoseconds total{0};          ///< Soma das durações
+
+    /**
+     * @brief Retorna o balde de uma duração
+     * @param nanoseconds Duração em ns
+     * @return Índice do balde
+     */
+    static size_t bucket_of(uint64_t nanoseconds);
+
+    /**
+     * @brief Retorna o limite superior (exclusivo) de um balde
+     * @param bucket Índice do balde
+     * @return Limite em ns
+     */
+    static std::chrono::nanoseconds bucket_limit(size_t bucket);
+
+    /**
+     * @brief Estima um percentil
+     * @param fraction Fração em [0, 1] (ex.: 0.99 para p99)
+     * @return Limite superior do balde que contém o percentil (0 se vazio)
+     */
+    std::chrono::nanoseconds percentile(double fraction) const;
+
+    /**
+     * @brief Retorna a duração média
+     * @return Média (0 se vazio)
+     */
+    std::chrono::nanoseconds mean() const;
+
+    /**
+     * @brief Soma as amostras de outro histograma a este
+     * @param other Histograma somado
+     */
+    void merge(const LatencyHistogram& other);
+};
+
+/**
+ * @struct WorkerStats
+ * @brief Contadores de um worker
+ */
+struct WorkerStats {
+    size_t index = 0;                           ///< Deque local (work-stealing) ou posição no retrato (fila compartilhada)
+    uint64_t tasks_executed = 0;                ///< Tarefas executadas
+    std::chrono::nanoseconds busy_time{0};      ///< Tempo executando tarefas
+    std::chrono::nanoseconds idle_time{0};      ///< Tempo procurando ou esperando tarefas
+    LatencyHistogram queue_wait;                ///< Espera de cada tarefa na fila
+    LatencyHistogram run_time;                  ///< Execução de cada tarefa
+
+    /**
+     * @brief Soma os contadores de outro worker a este
+     * @param other Contadores somados
+     */
+    void merge(const WorkerStats& other);
+
+    /**
+     * @brief Fração do tempo medido gasta executando tarefas
+     * @return Valor em [0, 1] (0 se nada foi medido)
+     */
+    double utilization() const;
+};
+
+/**
+ * @struct ThreadPoolStats
+ * @brief Retrato do estado do pool em um instante
+ */
+struct ThreadPoolStats {
+    size_t live_threads = 0;                    ///< Threads vivas
+    size_t min_threads = 0;                     ///< Limite inferior configurado
+    size_t max_threads = 0;                     ///< Limite superior configurado
+    size_t peak_threads = 0;                    ///< Maior número de threads vivas já visto
+    size_t grow_events = 0;                     ///< Total de crescimentos
+    size_t shrink_events = 0;                   ///< Total de aposentadorias
+    size_t rejected_submissions = 0;            ///< Submissões recusadas, executadas pelo chamador ou descartadas
+    size_t blocked_submissions = 0;             ///< Submissões que esperaram por espaço na fila
+    std::vector<ResizeEvent> recent_resizes;    ///< Últimos eventos, do mais antigo ao mais recente
+    size_t queued_tasks = 0;                    ///< Tarefas aguardando na fila (leitura sem lock)
+    WorkerStats totals;                         ///< Soma de todos os workers, inclusive aposentados
+    std::vector<WorkerStats> workers;           ///< Contadores de cada worker vivo
+};
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "inline_task.h"
+
+/**
+ * @struct TimerId
+ * @brief Identificador de um timer pendente (índice do nó + geração)
+ *
+ * A geração muda quando o nó é reutilizado, então um id antigo nunca
+ * cancela o timer de outra pessoa.
+ */
+struct TimerId {
+    uint32_t index = UINT32_MAX;                ///< Nó do timer
+    uint32_t generation = 0;                    ///< Geração do nó quando o timer foi criado
+};
+
+/**
+ * @class TimerWheel
+ * @brief Roda de timers hierárquica atendida por uma única thread
+ *
+ * Quatro níveis de 64 posições cobrem 64^4 ticks (cerca de 4,6 horas com
+ * resolução de 1ms); prazos além disso ficam em uma lista de excedentes
+ * revista a cada volta completa. Inserir e cancelar custam O(1): cada nível
+ * tem listas duplamente encadeadas por índice e um mapa de bits de posições
+ * ocupadas. Com o mapa de bits a thread dorme direto até o próximo tick com
+ * trabalho (disparo ou cascata), sem acordar a cada tick.
+ *
+ * Tarefas vencidas não executam na thread do timer: são entregues ao sink
+ * (no ThreadPool, a fila de tarefas). Nenhum timer dispara antes do prazo;
+ * o atraso máximo é de uma resolução mais o tempo de entrega.
+ */
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Sink = std::function<void(InlineTask)>; ///< Destino das tarefas vencidas
+
+    /**
+     * @brief Construtor que inicia a thread do timer
+     * @param sink Recebe cada tarefa vencida (chamado sem lock, na thread do timer)
+     * @param resolution Duração de um tick
+     */
+    explicit TimerWheel(Sink sink, Clock::duration resolution = std::chrono::milliseconds(1));
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief Destrutor que para a thread; timers pendentes são descartados
+     */
+    ~TimerWheel();
+
+    /**
+     * @brief Agenda uma tarefa para um instante
+     * @param when Instante mínimo de disparo (no passado: próximo tick)
+     * @param task Tarefa entregue ao sink no vencimento
+     * @return Id para cancelamento
+     */
+    TimerId schedule_at(Clock::time_point when, InlineTask task);
+
+    /**
+     * @brief Agenda uma tarefa periódica
+     *
+     * Os disparos seguem a grade first, first + period, ... sem acumular
+     * atraso. Se a execução anterior ainda não terminou, o disparo é pulado,
+     * então execuções da mesma tarefa nunca se sobrepõem.
+     * @param first Instante do primeiro disparo
+     * @param period Intervalo entre disparos (no mínimo um tick)
+     * @param task Tarefa executada a cada disparo
+     * @return Id para cancelamento
+     */
+    TimerId schedule_every(Clock::time_point first, Clock::duration period, InlineTask task);
+
+    /**
+     * @brief Cancela um timer pendente
+     *
+     * Uma execução já entregue ao sink não é interrompida.
+     * @param id Id retornado no agendamento
+     * @return true se o timer estava pendente
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * @brief Retorna o número de timers pendentes
+     * @return Número de timers
+     */
+    size_t pending() const;
+
+private:
+    static constexpr size_t LEVELS = 4;                 ///< Níveis da roda
+    static constexpr size_t SLOT_BITS = 6;              ///< log2 das posições por nível
+    static constexpr size_t SLOTS = size_t{1} << SLOT_BITS; ///< Posições por nível
+    static constexpr uint32_t NIL = UINT32_MAX;         ///< Fim de lista
+    static constexpr uint32_t OVERFLOW_LIST = LEVELS * SLOTS; ///< Lista de excedentes
+    static constexpr uint32_t NO_LIST = OVERFLOW_LIST + 1;    ///< Nó livre
+
+    /**
+     * @struct Periodic
+     * @brief Corpo de uma tarefa periódica, compartilhado entre os disparos
+     */
+    struct Periodic {
+        InlineTask body;                        ///< Tarefa do usuário
+        std::atomic<bool> running{false};       ///< Uma execução está na fila ou rodando
+    };
+
+    /**
+     * @struct Node
+     * @brief Timer pendente, encadeado na lista de uma posição
+     */
+    struct Node {
+        InlineTask task;                        ///< Tarefa (timer único)
+        std::shared_ptr<Periodic> periodic;     ///< Corpo (timer periódico)
+        uint64_t expiry = 0;                    ///< Tick de vencimento
+        uint64_t period = 0;                    ///< Período em ticks (0: único)
+        uint32_t generation = 0;                ///< Geração do nó
+        uint32_t prev = NIL;                    ///< Anterior na lista
+        uint32_t next = NIL;                    ///< Próximo na lista
+        uint32_t list = NO_LIST;                ///< Lista onde está encadeado
+    };
+
+    /**
+     * @brief Loop da thread do timer
+     */
+    void run();
+
+    /**
+     * @brief Cria um nó e o encadeia (requer lock)
+     */
+    TimerId add(uint64_t expiry, uint64_t period, InlineTask task, std::shared_ptr<Periodic> periodic);
+
+    /**
+     * @brief Encadeia um nó na lista do seu vencimento (requer lock)
+     */
+    void link(uint32_t index);
+
+    /**
+     * @brief Remove um nó da sua lista (requer lock)
+     */
+    void unlink(uint32_t index);
+
+    /**
+     * @brief Devolve um nó à lista livre (requer lock)
+     */
+    void release(uint32_t index);
+
+    /**
+     * @brief Retira e reencadeia todos os nós de uma lista (requer lock)
+     */
+    void cascade(uint32_t list);
+
+    /**
+     * @brief Avança a roda até o tick target, coletando tarefas vencidas (requer lock)
+     */
+    void advance(uint64_t target, std::vector<InlineTask>& expired);
+
+    /**
+     * @brief Próximo tick com disparo ou cascata, ou UINT64_MAX se a roda está vazia (requer lock)
+     */
+    uint64_t next_event() const;
+
+    /**
+     * @brief Converte um instante no primeiro tick que não é anterior a ele
+     */
+    uint64_t tick_at(Clock::time_point when) const;
+
+    /**
+     * @brief Converte um instante no último tick já iniciado
+     */
+    uint64_t tick_now(Clock::time_point now) const;
+
+    Sink sink;                                  ///< Destino das tarefas vencidas
+    const Clock::duration resolution;           ///< Duração de um tick
+    const Clock::time_point origin;             ///< Instante do tick zero
+
+    mutable std::mutex mutex;                   ///< Protege a roda
+    std::condition_variable wakeup;             ///< Acorda a thread para um prazo mais cedo
+    std::vector<Node> nodes;                    ///< Nós (livres ou encadeados)
+    std::vector<uint32_t> free_nodes;           ///< Índices de nós livres
+    std::array<uint32_t, OVERFLOW_LIST + 1> heads; ///< Cabeça de cada lista
+    std::array<uint64_t, LEVELS> occupied{};    ///< Posições não vazias por nível
+    uint64_t current = 0;                       ///< Último tick processado
+    uint64_t wake_tick = 0;                     ///< Tick em que a thread dorme até (0: acordada)
+    size_t count = 0;                           ///< Timers pendentes
+    bool stop_flag = false;                     ///< Flag de parada
+    std::thread thread;                         ///< Thread do timer
+};
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+#include "inline_task.h"
+
+/**
+ * @struct TraceEvent
+ * @brief Evento do ciclo de vida de uma tarefa
+ */
+struct TraceEvent {
+    /**
+     * @enum Kind
+     * @brief Momento registrado
+     */
+    enum class Kind : uint8_t {
+        Submit,     ///< Tarefa publicada na fila (thread de quem submeteu)
+        Start,      ///< Worker começou a executar a tarefa
+        Finish      ///< Worker terminou a tarefa
+    };
+
+    int64_t timestamp = 0;                      ///< Instante em ns de steady_clock
+    uint64_t task = 0;                          ///< Id da tarefa, comum aos três eventos
+    const char* name = nullptr;                 ///< Nome da tarefa (duração estática)
+    Kind kind = Kind::Submit;                   ///< Momento registrado
+};
+
+/**
+ * @class TraceLabel
+ * @brief Nomeia as tarefas submetidas pela thread corrente enquanto está vivo
+ *
+ * Vale para qualquer forma de submissão (submit, execute, parallel_for...);
+ * disparos de timers são publicados pela thread do timer e ficam sem nome.
+ * O nome não é copiado e deve ter duração estática, como um literal.
+ * Escopos podem ser aninhados.
+ */
+class TraceLabel {
+public:
+    /**
+     * @brief Passa a nomear as tarefas desta thread
+     * @param name Nome exibido no trace
+     */
+    explicit TraceLabel(const char* name) noexcept;
+
+    /**
+     * @brief Restaura o nome anterior
+     */
+    ~TraceLabel();
+
+    TraceLabel(const TraceLabel&) = delete;
+    TraceLabel& operator=(const TraceLabel&) = delete;
+
+    /**
+     * @brief Retorna o nome em vigor na thread corrente
+     * @return Nome, ou nullptr fora de qualquer escopo
+     */
+    static const char* current() noexcept;
+
+private:
+    const char* previous;                       ///< Nome do escopo externo
+};
+
+/**
+ * @class TraceRecorder
+ * @brief Linha do tempo das tarefas de um pool, exportável como Chrome trace
+ *
+ * Desligado, o custo é a leitura relaxada de um bool por publicação. Ligado,
+ * cada tarefa publicada recebe um id e é embrulhada para registrar início e
+ * fim; cada thread escreve em seu próprio buffer, sem lock, em blocos que
+ * nunca são movidos, então write_json() lê enquanto os workers registram.
+ * Os buffers só crescem enquanto a gravação está ligada.
+ */
+class TraceRecorder {
+public:
+    TraceRecorder();
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    /**
+     * @brief Liga ou desliga a gravação
+     * @param on true para gravar
+     */
+    void enable(bool on) noexcept {
+        recording.store(on, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Verifica se a gravação está ligada
+     * @return true se ligada
+     */
+    bool enabled() const noexcept {
+        return recording.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Registra a submissão e embrulha a tarefa para registrar início e fim
+     *
+     * Só deve ser chamada com a gravação ligada.
+     * @param task Tarefa a ser publicada
+     * @return Tarefa embrulhada
+     */
+    InlineTask wrap(InlineTask task);
+
+    /**
+     * @brief Registra um evento no buffer da thread corrente
+     * @param kind Momento registrado
+     * @param task Id da tarefa
+     * @param name Nome da tarefa
+     */
+    void record(TraceEvent::Kind kind, uint64_t task, const char* name);
+
+    /**
+     * @brief Retorna o número de eventos gravados
+     * @return Total de eventos em todos os buffers
+     */
+    size_t event_count() const;
+
+    /**
+     * @brief Escreve os eventos no formato JSON do Chrome trace (abre no Perfetto)
+     *
+     * Cada tarefa vira uma fatia na thread que a executou, ligada por uma
+     * seta (flow) ao instante da submissão na thread de origem.
+     * @param out Destino do JSON
+     */
+    void write_json(std::ostream& out) const;
+
+private:
+    static constexpr size_t CHUNK_EVENTS = 1024; ///< Eventos por bloco
+
+    /**
+     * @struct Chunk
+     * @brief Bloco de eventos de uma thread; publicado pelo contador used
+     */
+    struct Chunk {
+        std::array<TraceEvent, CHUNK_EVENTS> events; ///< Eventos
+        std::atomic<size_t> used{0};            ///< Eventos publicados
+        std::atomic<Chunk*> next{nullptr};      ///< Bloco seguinte
+    };
+
+    /**
+     * @struct ThreadBuffer
+     * @brief Lista de blocos escrita por uma única thread
+     */
+    struct ThreadBuffer {
+        std::thread::id owner;                  ///< Thread que escreve
+        size_t thread_number = 0;               ///< Número da thread no trace
+        Chunk* head = nullptr;                  ///< Primeiro bloco (dono da lista)
+        Chunk* tail = nullptr;                  ///< Bloco em escrita
+    };
+
+    /**
+     * @brief Retorna o buffer da thread corrente, registrando-o no primeiro uso
+     */
+    ThreadBuffer& local_buffer();
+
+    const uint64_t identity;                    ///< Id único do gravador (cache por thread)
+    std::atomic<bool> recording{false};         ///< Gravação ligada
+    std::atomic<uint64_t> next_task{1};         ///< Próximo id de tarefa
+    mutable std::mutex registry_mutex;          ///< Protege buffers
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers; ///< Um buffer por thread que registrou
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef WORK_STEALING_QUEUE_H
+#define WORK_STEALING_QUEUE_H
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include "task_queue.h"
+#include "slab_pool.h"
+
+/**
+ * @class WorkStealingQueue
+ * @brief Deque local de um worker com suporte a roubo de tarefas
+ *
+ * O dono empilha e desempilha pelo fundo (LIFO, melhor localidade de cache)
+ * enquanto outros workers roubam pelo topo (FIFO, tarefas mais antigas).
+ * Alinhada em linha de cache para que deques vizinhas não compartilhem linhas.
+ */
+class alignas(64) WorkStealingQueue {
+public:
+    using Task = TaskQueue::Task;
+
+    /**
+     * @brief Adiciona uma tarefa no fundo da deque (uso do dono)
+     * @param task Tarefa a ser adicionada
+     */
+    void push(Task task);
+
+    /**
+     * @brief Adiciona um lote no fundo da deque sob um único lock
+     * @param tasks Tarefas a serem adicionadas (o vetor é esvaziado)
+     */
+    void push_bulk(std::vector<Task>& tasks);
+
+    /**
+     * @brief Remove a tarefa mais recente do fundo da deque (uso do dono)
+     * @param task Referência para armazenar a tarefa removida
+     * @return true se obteve tarefa, false se a deque está vazia
+     */
+    bool pop(Task& task);
+
+    /**
+     * @brief Rouba a tarefa mais antiga do topo da deque (uso de outros workers)
+     * @param task Referência para armazenar a tarefa roubada
+     * @return true se obteve tarefa, false se a deque está vazia
+     */
+    bool steal(Task& task);
+
+    /**
+     * @brief Verifica, sem travar, se a deque parece vazia
+     * @return true se vazia no momento da leitura
+     */
+    bool empty() const;
+
+    /**
+     * @brief Retorna o tamanho aproximado da deque (sem travar)
+     * @return Número de tarefas na deque
+     */
+    size_t size() const;
+
+private:
+    mutable std::mutex mutex;                   ///< Mutex da deque (raramente disputado)
+    std::deque<Task, PoolAllocator<Task>> deque; ///< Tarefas do worker
+    std::atomic<size_t> count{0};               ///< Tamanho publicado para leitura sem lock
+};
+
+#endif
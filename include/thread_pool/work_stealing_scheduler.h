@@ -0,0 +1,200 @@
+#ifndef WORK_STEALING_SCHEDULER_H
+#define WORK_STEALING_SCHEDULER_H
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include "task_queue.h"
+#include "event_count.h"
+#include "work_stealing_queue.h"
+
+/**
+ * @class WorkStealingScheduler
+ * @brief Escalonador com deque local por worker e roubo de tarefas
+ *
+ * Tarefas submetidas de dentro de um worker vão para a deque desse worker;
+ * tarefas submetidas de fora vão para uma fila de injeção compartilhada.
+ * Um worker sem trabalho local busca lotes na fila de injeção e, depois,
+ * rouba das deques dos outros workers antes de dormir no EventCount de
+ * ociosidade. Tarefas com prioridade
+ * diferente de Normal sempre passam pela fila de injeção, e tarefas High nela
+ * são buscadas antes da deque local. Com domínios de LLC definidos, o roubo
+ * tenta primeiro os workers do mesmo domínio.
+ */
+class WorkStealingScheduler {
+public:
+    using Task = TaskQueue::Task;
+
+    /**
+     * @brief Construtor que cria uma deque local por worker
+     * @param num_workers Número de workers atendidos pelo escalonador
+     * @param injection_queue Fila para tarefas submetidas de fora do pool
+     */
+    WorkStealingScheduler(size_t num_workers, std::shared_ptr<TaskQueue> injection_queue);
+
+    /**
+     * @brief Adiciona uma tarefa (deque local se chamado de um worker)
+     * @param task Tarefa a ser adicionada
+     * @return true se bem-sucedido, false se o escalonador está parado
+     */
+    bool push(Task task);
+
+    /**
+     * @brief Adiciona uma tarefa com classe de prioridade
+     * @param task Tarefa a ser adicionada
+     * @param priority Classe de prioridade (não Normal vai para a fila de injeção)
+     * @return true se bem-sucedido, false se o escalonador está parado
+     */
+    bool push(Task task, TaskPriority priority);
+
+    /**
+     * @brief Adiciona um lote, acordando no máximo um worker por tarefa
+     * @param tasks Tarefas a serem adicionadas (o vetor é esvaziado)
+     * @return true se bem-sucedido, false se o escalonador está parado
+     */
+    bool push_bulk(std::vector<Task>& tasks);
+
+    /**
+     * @brief Tenta adicionar uma tarefa sem esperar por espaço
+     *
+     * Só a fila de injeção é limitada; a deque local de um worker sempre aceita.
+     * @param task Tarefa a ser adicionada (só é movida em caso de sucesso)
+     * @param priority Classe de prioridade
+     * @return true se adicionou, false se a fila de injeção está cheia ou parada
+     */
+    bool try_push(Task& task, TaskPriority priority);
+
+    /**
+     * @brief Adiciona uma tarefa esperando por espaço no máximo timeout
+     * @param task Tarefa a ser adicionada (só é movida em caso de sucesso)
+     * @param priority Classe de prioridade
+     * @param timeout Tempo máximo de espera com a fila de injeção cheia
+     * @return true se adicionou, false se expirou ou o escalonador está parado
+     */
+    bool push_for(Task& task, TaskPriority priority, std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief Remove da fila de injeção a tarefa mais antiga da classe menos urgente
+     * @param task Referência para armazenar a tarefa removida
+     * @return true se removeu, false se a fila de injeção está vazia
+     */
+    bool pop_oldest(Task& task);
+
+    /**
+     * @brief Retorna a capacidade da fila de injeção
+     * @return Número máximo de tarefas, ou 0 se ilimitada
+     */
+    size_t capacity() const;
+
+    /**
+     * @brief Obtém a próxima tarefa para um worker (bloqueante)
+     * @param index Índice do worker
+     * @param task Referência para armazenar a tarefa obtida
+     * @return true se obteve tarefa, false se parado e sem tarefas pendentes
+     */
+    bool pop(size_t index, Task& task);
+
+    /**
+     * @brief Tenta obter tarefa sem bloquear: deque local, injeção e roubo
+     * @param index Índice do worker
+     * @param task Referência para armazenar a tarefa obtida
+     * @return true se obteve tarefa
+     */
+    bool try_pop(size_t index, Task& task);
+
+    /**
+     * @brief Ponto de espera dos workers ociosos, notificado a cada push
+     * @return EventCount do escalonador
+     */
+    EventCount& idle_event();
+
+    /**
+     * @brief Associa a thread corrente ao worker de índice dado
+     * @param index Índice do worker
+     */
+    void bind(size_t index);
+
+    /**
+     * @brief Define o domínio de LLC de um worker (roubo prefere o mesmo domínio)
+     * @param index Índice do worker
+     * @param domain Domínio de LLC da CPU em que o worker está fixado
+     */
+    void set_domain(size_t index, size_t domain);
+
+    /**
+     * @brief Para o escalonador, acordando todos os workers
+     */
+    void stop();
+
+    /**
+     * @brief Verifica se o escalonador está parado
+     * @return true se parado, false caso contrário
+     */
+    bool stopped() const;
+
+    /**
+     * @brief Retorna o número de tarefas pendentes em todas as filas
+     * @return Número de tarefas pendentes
+     */
+    size_t size() const;
+
+    /**
+     * @brief Retorna o número de tarefas pendentes de uma classe de prioridade
+     * @param priority Classe de prioridade
+     * @return Número de tarefas (Normal inclui tudo que já está nas deques locais)
+     */
+    size_t size(TaskPriority priority) const;
+
+private:
+    /**
+     * @brief Tenta obter tarefa sem bloquear: local, injeção e roubo
+     */
+    bool try_acquire(size_t index, Task& task);
+
+    /**
+     * @brief Tenta obter um lote da fila de injeção
+     */
+    bool try_acquire_injected(size_t index, Task& task);
+
+    /**
+     * @brief Tenta roubar uma tarefa de outro worker
+     */
+    bool try_steal(size_t index, Task& task);
+
+    /**
+     * @brief Verifica se a thread corrente publica na própria deque local
+     */
+    bool pushes_locally(TaskPriority priority) const;
+
+    /**
+     * @brief Contabiliza tarefas que vão ser publicadas na fila de injeção
+     */
+    void reserve_injected(size_t count);
+
+    /**
+     * @brief Desfaz a contabilização de tarefas recusadas pela fila de injeção
+     */
+    void cancel_injected(size_t count);
+
+    /**
+     * @brief Acorda um worker adormecido, se houver
+     */
+    void notify();
+
+    /**
+     * @brief Acorda até count workers adormecidos
+     */
+    void notify(size_t count);
+
+    std::vector<std::unique_ptr<WorkStealingQueue>> local_queues; ///< Deques locais dos workers
+    std::shared_ptr<TaskQueue> injection_queue; ///< Fila de tarefas vindas de fora do pool
+    std::vector<std::atomic<size_t>> domains;   ///< Domínio de LLC de cada worker
+
+    alignas(64) std::atomic<size_t> pending{0}; ///< Tarefas enfileiradas em qualquer fila
+    alignas(64) std::atomic<size_t> injected{0};///< Tarefas na fila de injeção
+    std::atomic<bool> stop_flag{false};         ///< Flag de parada
+
+    EventCount idle;                            ///< Espera dos workers ociosos
+};
+
+#endif
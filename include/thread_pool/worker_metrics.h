@@ -0,0 +1,96 @@
+#ifndef WORKER_METRICS_H
+#define WORKER_METRICS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "thread_pool_stats.h"
+
+/**
+ * @class WorkerMetrics
+ * @brief Contadores vivos de um worker, escritos só pela thread dele
+ *
+ * Com um único escritor, cada atualização é um load e um store relaxados
+ * (sem instrução com lock) e qualquer thread pode ler um retrato a qualquer
+ * momento sem parar o worker. O objeto começa e termina em linhas de cache
+ * próprias, então workers vizinhos não disputam as mesmas linhas. Um
+ * retrato pode misturar contadores de tarefas consecutivas, mas cada
+ * contador é lido inteiro.
+ */
+class alignas(64) WorkerMetrics {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Instante corrente em ns de steady_clock (escala de InlineTask::stamp)
+     * @return Nanossegundos desde a época do relógio
+     */
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Registra uma tarefa executada sem medição de tempo
+     */
+    void count_task() {
+        bump(tasks, 1);
+    }
+
+    /**
+     * @brief Registra uma tarefa executada com seus tempos
+     * @param idle_ns Tempo ocioso antes de obter a tarefa
+     * @param wait_ns Espera na fila (negativo: tarefa sem marca de enfileiramento)
+     * @param run_ns Tempo de execução
+     */
+    void record_task(int64_t idle_ns, int64_t wait_ns, int64_t run_ns) {
+        bump(tasks, 1);
+        bump(idle, static_cast<uint64_t>(std::max<int64_t>(idle_ns, 0)));
+        bump(busy, static_cast<uint64_t>(std::max<int64_t>(run_ns, 0)));
+        if (wait_ns >= 0) {
+            add_sample(wait_buckets, wait_total, static_cast<uint64_t>(wait_ns));
+        }
+        add_sample(run_buckets, run_total, static_cast<uint64_t>(std::max<int64_t>(run_ns, 0)));
+    }
+
+    /**
+     * @brief Lê os contadores sem bloquear o escritor
+     * @param index Índice reportado no retrato
+     * @return Retrato dos contadores
+     */
+    WorkerStats snapshot(size_t index) const;
+
+private:
+    using Buckets = std::array<std::atomic<uint64_t>, LatencyHistogram::BUCKETS>;
+
+    /**
+     * @brief Soma em um contador de escritor único
+     */
+    static void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Registra uma amostra em um histograma
+     */
+    static void add_sample(Buckets& buckets, std::atomic<uint64_t>& total, uint64_t nanoseconds) {
+        bump(buckets[LatencyHistogram::bucket_of(nanoseconds)], 1);
+        bump(total, nanoseconds);
+    }
+
+    /**
+     * @brief Copia um histograma vivo para o retrato
+     */
+    static void read(const Buckets& buckets, const std::atomic<uint64_t>& total, LatencyHistogram& out);
+
+    std::atomic<uint64_t> tasks{0};             ///< Tarefas executadas
+    std::atomic<uint64_t> busy{0};              ///< Tempo executando (ns)
+    std::atomic<uint64_t> idle{0};              ///< Tempo ocioso (ns)
+    std::atomic<uint64_t> wait_total{0};        ///< Soma das esperas na fila (ns)
+    std::atomic<uint64_t> run_total{0};         ///< Soma das execuções (ns)
+    Buckets wait_buckets{};                     ///< Histograma de espera na fila
+    Buckets run_buckets{};                      ///< Histograma de execução
+};
+
+#endif
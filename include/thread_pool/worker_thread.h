@@ -1,24 +1,62 @@
 #ifndef WORKER_THREAD_H
 #define WORKER_THREAD_H
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <thread>
 #include <memory>
 #include "task_queue.h"
+#include "event_count.h"
+#include "work_stealing_scheduler.h"
+#include "thread_pool_options.h"
+#include "worker_metrics.h"
+
+/**
+ * @struct WorkerRetirement
+ * @brief Política de aposentadoria de um worker ocioso (pool elástico)
+ */
+struct WorkerRetirement {
+    std::chrono::milliseconds idle_timeout{0};  ///< Ociosidade antes de pedir para sair (0: nunca)
+    std::function<bool()> may_retire;           ///< Retorna true se o worker pode sair
+};
 
 /**
  * @class WorkerThread
  * @brief Thread worker que processa tarefas da fila
  *
  * Cada worker thread fica em loop esperando por tarefas na fila
- * e as executa quando disponíveis.
+ * e as executa quando disponíveis. Sem trabalho, segue a WaitStrategy:
+ * gira, cede a vez e por fim dorme no EventCount de ociosidade.
  */
 class WorkerThread {
 public:
     /**
      * @brief Construtor que inicia a thread worker
      * @param task_queue Fila compartilhada de tarefas
+     * @param idle EventCount notificado pelos produtores (nulo: bloqueia em pop)
+     * @param strategy Estratégia de espera quando a fila está vazia
+     * @param retirement Política de aposentadoria por ociosidade
+     * @param timed Mede ociosidade, espera na fila e execução de cada tarefa
+     */
+    explicit WorkerThread(std::shared_ptr<TaskQueue> task_queue,
+                          std::shared_ptr<EventCount> idle = nullptr,
+                          WaitStrategy strategy = WaitStrategy::park(),
+                          WorkerRetirement retirement = {},
+                          bool timed = true);
+
+    /**
+     * @brief Construtor que inicia a thread worker em modo work-stealing
+     * @param scheduler Escalonador com as deques locais dos workers
+     * @param index Índice da deque local deste worker
+     * @param strategy Estratégia de espera quando não há trabalho
+     * @param retirement Política de aposentadoria por ociosidade
+     * @param timed Mede ociosidade, espera na fila e execução de cada tarefa
      */
-    explicit WorkerThread(std::shared_ptr<TaskQueue> task_queue);
+    WorkerThread(std::shared_ptr<WorkStealingScheduler> scheduler, size_t index,
+                 WaitStrategy strategy = WaitStrategy::park(),
+                 WorkerRetirement retirement = {},
+                 bool timed = true);
 
     /**
      * @brief Destrutor que para a thread
@@ -35,15 +73,96 @@ public:
      */
     void join();
 
+    /**
+     * @brief Verifica se o loop do worker terminou (parada ou aposentadoria)
+     * @return true se a thread já saiu do loop
+     */
+    bool finished() const;
+
+    /**
+     * @brief Retorna o índice da deque local no escalonador
+     * @return Índice do worker
+     */
+    size_t worker_index() const;
+
+    /**
+     * @brief Lê os contadores do worker sem interrompê-lo
+     * @return Retrato dos contadores, com o índice do worker
+     */
+    WorkerStats stats() const;
+
+    /**
+     * @brief Retorna o worker cuja thread é a corrente
+     * @return Worker, ou nullptr fora de qualquer pool
+     */
+    static WorkerThread* current() noexcept;
+
+    /**
+     * @brief Executa uma tarefa pendente na thread corrente, sem bloquear
+     *
+     * Usado pelas esperas cooperativas (HelpingWait): só pode ser chamado
+     * pela própria thread do worker, dentro de uma tarefa.
+     * @return true se executou uma tarefa, false se não havia nenhuma
+     */
+    bool run_one();
+
+    /**
+     * @brief Fixa a thread do worker em uma CPU
+     * @param cpu Número da CPU lógica
+     * @return true se a afinidade foi aplicada (apenas Linux)
+     */
+    bool pin_to_cpu(int cpu);
+
 private:
     /**
      * @brief Loop principal da thread worker
      */
     void run();
 
+    /**
+     * @brief Executa uma tarefa e registra seus tempos
+     * @param task Tarefa obtida da fonte
+     * @param idle_since Início da ociosidade anterior (atualizado para o fim da tarefa)
+     */
+    void run_task(TaskQueue::Task& task, int64_t& idle_since);
+
+    /**
+     * @brief Obtém a próxima tarefa da fonte configurada (bloqueante)
+     * @param task Referência para armazenar a tarefa
+     * @return true se obteve tarefa, false se a fonte está parada e vazia
+     */
+    bool next_task(TaskQueue::Task& task);
+
+    /**
+     * @brief Tenta obter uma tarefa sem bloquear
+     * @param task Referência para armazenar a tarefa
+     * @return true se obteve tarefa
+     */
+    bool try_next_task(TaskQueue::Task& task);
+
+    /**
+     * @brief Verifica, sem travar, se a fonte parece ter tarefas
+     * @return true se há tarefas pendentes
+     */
+    bool has_pending() const;
+
+    /**
+     * @brief Verifica se a fonte de tarefas foi parada
+     * @return true se parada
+     */
+    bool source_stopped() const;
+
     std::shared_ptr<TaskQueue> task_queue;      ///< Fila compartilhada de tarefas
+    std::shared_ptr<WorkStealingScheduler> scheduler; ///< Escalonador work-stealing (opcional)
+    std::shared_ptr<EventCount> idle;           ///< Ponto de espera dos ociosos (fila compartilhada)
+    WaitStrategy strategy;                      ///< Estratégia de espera
+    WorkerRetirement retirement;                ///< Política de aposentadoria
+    bool timed;                                 ///< Mede os tempos de cada tarefa
+    size_t index;                               ///< Índice da deque local no escalonador
     std::thread thread;                         ///< Thread associada
-    bool running;                               ///< Flag de execução
+    std::atomic<bool> running;                  ///< Flag de execução
+    std::atomic<bool> done{false};              ///< Loop terminado
+    WorkerMetrics metrics;                      ///< Contadores escritos só por esta thread
 };
 
 #endif
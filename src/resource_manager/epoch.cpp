@@ -0,0 +1,159 @@
+#include "resource_manager/epoch.h"
+#include <algorithm>
+
+/**
+ * @struct EpochRecordHolder
+ * @brief Dono thread_local do registro da thread, devolvido quando ela termina
+ */
+struct EpochRecordHolder {
+    EpochDomain::Record* record;                ///< Registro da thread
+
+    EpochRecordHolder() : record(EpochDomain::instance().acquire_record()) {}
+
+    ~EpochRecordHolder() {
+        record->epoch.store(EpochDomain::QUIESCENT, std::memory_order_release);
+        record->depth = 0;
+        record->in_use.store(false, std::memory_order_release);
+    }
+};
+
+/**
+ * @brief Domínio global do processo
+ * @return Instância única
+ */
+EpochDomain& EpochDomain::instance() {
+    static EpochDomain domain;
+    return domain;
+}
+
+/**
+ * @brief Apaga os objetos pendentes e os registros (sem leitores no encerramento)
+ */
+EpochDomain::~EpochDomain() {
+    for (auto& item : retired) {
+        item.deleter(item.pointer);
+    }
+    Record* record = records.load(std::memory_order_acquire);
+    while (record) {
+        Record* next = record->next;
+        delete record;
+        record = next;
+    }
+}
+
+/**
+ * @brief Registro da thread atual
+ */
+EpochDomain::Record* EpochDomain::local_record() {
+    thread_local EpochRecordHolder holder;
+    return holder.record;
+}
+
+/**
+ * @brief Reaproveita o registro de uma thread encerrada ou publica um novo
+ */
+EpochDomain::Record* EpochDomain::acquire_record() {
+    for (Record* record = records.load(std::memory_order_acquire); record; record = record->next) {
+        bool expected = false;
+        if (!record->in_use.load(std::memory_order_relaxed) &&
+            record->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return record;
+        }
+    }
+    Record* record = new Record();
+    record->in_use.store(true, std::memory_order_relaxed);
+    Record* head = records.load(std::memory_order_relaxed);
+    do {
+        record->next = head;
+    } while (!records.compare_exchange_weak(head, record, std::memory_order_release,
+                                            std::memory_order_relaxed));
+    return record;
+}
+
+/**
+ * @brief Entra na época atual
+ *
+ * Publica a época e a confirma depois de uma barreira seq_cst: se a época
+ * global mudou no meio, republica para não segurar o avanço sem necessidade.
+ */
+void EpochDomain::enter() {
+    Record* record = local_record();
+    if (record->depth++ > 0) return;
+
+    uint64_t epoch = global_epoch.load(std::memory_order_relaxed);
+    while (true) {
+        record->epoch.store(epoch, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t current = global_epoch.load(std::memory_order_relaxed);
+        if (current == epoch) break;
+        epoch = current;
+    }
+}
+
+/**
+ * @brief Sai da época; as leituras feitas acontecem antes de qualquer liberação
+ */
+void EpochDomain::leave() {
+    Record* record = local_record();
+    if (--record->depth > 0) return;
+    record->epoch.store(QUIESCENT, std::memory_order_release);
+}
+
+/**
+ * @brief Registra o objeto para liberação e tenta liberar os antigos
+ * @param pointer Objeto retirado
+ * @param deleter Função de destruição
+ */
+void EpochDomain::retire(void* pointer, void (*deleter)(void*)) {
+    {
+        std::lock_guard lock(retired_mutex);
+        retired.push_back({pointer, deleter, global_epoch.load(std::memory_order_acquire)});
+    }
+    collect();
+}
+
+/**
+ * @brief Avança a época se nenhum leitor ativo está em uma época anterior
+ * @return true se avançou
+ */
+bool EpochDomain::try_advance() {
+    uint64_t epoch = global_epoch.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (Record* record = records.load(std::memory_order_acquire); record; record = record->next) {
+        uint64_t observed = record->epoch.load(std::memory_order_acquire);
+        if (observed != QUIESCENT && observed != epoch) return false;
+    }
+    global_epoch.store(epoch + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Avança a época (até duas vezes) e apaga o que foi retirado há duas épocas
+ */
+void EpochDomain::collect() {
+    std::vector<Retired> ready;
+    {
+        std::lock_guard lock(retired_mutex);
+        if (retired.empty()) return;
+        for (int i = 0; i < 2 && try_advance(); ++i) {}
+
+        uint64_t epoch = global_epoch.load(std::memory_order_relaxed);
+        auto still_visible = std::partition(retired.begin(), retired.end(),
+            [epoch](const Retired& item) { return item.epoch + 2 > epoch; });
+        ready.assign(still_visible, retired.end());
+        retired.erase(still_visible, retired.end());
+    }
+    // Destrutores rodam fora do lock
+    for (auto& item : ready) {
+        item.deleter(item.pointer);
+    }
+}
+
+/**
+ * @brief Retorna o número de objetos pendentes
+ * @return Objetos retirados ainda não apagados
+ */
+size_t EpochDomain::pending() const {
+    std::lock_guard lock(retired_mutex);
+    return retired.size();
+}
@@ -1,3 +1,3 @@
-#include "lock_types.h"
+#include "resource_manager/lock_types.h"
 
-// No implementation needed for enum class
+// ReadLock e WriteLock são templates, implementados inteiramente no header
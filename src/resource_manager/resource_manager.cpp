@@ -0,0 +1,9 @@
+#include "resource_manager/resource_manager.h"
+
+/**
+ * @brief Lança o erro de recurso não encontrado
+ * @param key Descrição da chave procurada
+ */
+void detail::throw_resource_not_found(const std::string& key) {
+    throw std::runtime_error("Recurso não encontrado: " + key);
+}
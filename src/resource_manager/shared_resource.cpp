@@ -0,0 +1,3 @@
+#include "resource_manager/shared_resource.h"
+
+// SharedResource é um template, implementado inteiramente no header
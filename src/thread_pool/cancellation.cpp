@@ -0,0 +1,49 @@
+#include "thread_pool/cancellation.h"
+#include "thread_pool/slab_pool.h"
+
+/**
+ * @brief Lança TaskCancelledError se o grupo foi cancelado
+ */
+void CancellationToken::throw_if_cancelled() const {
+    if (cancelled()) {
+        throw TaskCancelledError();
+    }
+}
+
+/**
+ * @brief Construtor de um grupo independente
+ */
+CancellationSource::CancellationSource()
+    : state(std::allocate_shared<detail::CancellationState>(PoolAllocator<detail::CancellationState>())) {}
+
+/**
+ * @brief Construtor de um subgrupo
+ * @param parent Token do grupo pai
+ */
+CancellationSource::CancellationSource(const CancellationToken& parent)
+    : CancellationSource() {
+    state->parent = parent.state;
+}
+
+/**
+ * @brief Retorna um token do grupo
+ * @return Token
+ */
+CancellationToken CancellationSource::token() const noexcept {
+    return CancellationToken(state);
+}
+
+/**
+ * @brief Cancela o grupo
+ */
+void CancellationSource::cancel() noexcept {
+    state->cancelled.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief Verifica se o grupo foi cancelado
+ * @return true se cancelado
+ */
+bool CancellationSource::cancelled() const noexcept {
+    return token().cancelled();
+}
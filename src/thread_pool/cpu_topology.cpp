@@ -0,0 +1,233 @@
+#include "thread_pool/cpu_topology.h"
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Lê a primeira linha de um arquivo do sysfs
+ * @return true se o arquivo existe e foi lido
+ */
+bool read_line(const std::string& path, std::string& line) {
+    std::ifstream file(path);
+    return static_cast<bool>(std::getline(file, line));
+}
+
+/**
+ * @brief Lê um inteiro de um arquivo do sysfs
+ */
+int read_int(const std::string& path, int fallback) {
+    std::string line;
+    if (!read_line(path, line)) return fallback;
+    try {
+        return std::stoi(line);
+    } catch (const std::exception&) {
+        return fallback;
+    }
+}
+
+/**
+ * @brief Retorna a lista de CPUs que divide o cache de maior nível de uma CPU
+ */
+std::string llc_shared_list(const std::string& cpu_dir, int cpu) {
+    int best_level = -1;
+    std::string best = std::to_string(cpu);
+    for (int index = 0; ; ++index) {
+        std::string cache_dir = cpu_dir + "/cache/index" + std::to_string(index);
+        int level = read_int(cache_dir + "/level", -1);
+        if (level < 0) break;
+
+        std::string type;
+        read_line(cache_dir + "/type", type);
+        std::string shared;
+        if (type != "Instruction" && level > best_level && read_line(cache_dir + "/shared_cpu_list", shared)) {
+            best_level = level;
+            best = shared;
+        }
+    }
+    return best;
+}
+
+}
+
+/**
+ * @brief Lê a topologia das CPUs online
+ * @param sysfs_root Diretório equivalente a /sys/devices/system/cpu
+ * @return Topologia detectada
+ */
+CpuTopology CpuTopology::detect(const std::string& sysfs_root) {
+    CpuTopology topology;
+
+    std::string online;
+    std::vector<int> ids;
+    if (read_line(sysfs_root + "/online", online)) {
+        ids = parse_cpu_list(online);
+    }
+
+    if (ids.empty()) {
+        // Sem sysfs: CPUs independentes em um único domínio
+        size_t count = std::max(1u, std::thread::hardware_concurrency());
+        for (size_t i = 0; i < count; ++i) {
+            CpuInfo info;
+            info.id = static_cast<int>(i);
+            info.core = static_cast<int>(i);
+            topology.cpu_list.push_back(info);
+        }
+        return topology;
+    }
+
+    std::map<std::string, size_t> domains;      // lista de CPUs da LLC -> índice denso
+    std::map<std::pair<int, int>, int> threads_per_core;
+    for (int id : ids) {
+        std::string cpu_dir = sysfs_root + "/cpu" + std::to_string(id);
+        CpuInfo info;
+        info.id = id;
+        info.package = read_int(cpu_dir + "/topology/physical_package_id", 0);
+        info.core = read_int(cpu_dir + "/topology/core_id", id);
+
+        // Domínios numerados na ordem em que aparecem
+        std::string shared = llc_shared_list(cpu_dir, id);
+        auto found = domains.find(shared);
+        if (found == domains.end()) {
+            found = domains.emplace(shared, domains.size()).first;
+        }
+        info.llc = found->second;
+
+        // CPUs vêm em ordem crescente; a primeira de cada núcleo tem rank 0
+        info.smt_rank = threads_per_core[{info.package, info.core}]++;
+        topology.cpu_list.push_back(info);
+    }
+    topology.llc_count = std::max<size_t>(domains.size(), 1);
+    return topology;
+}
+
+/**
+ * @brief Interpreta uma lista de CPUs no formato do kernel
+ * @param text Texto da lista ("0-3,8")
+ * @return CPUs em ordem crescente
+ */
+std::vector<int> CpuTopology::parse_cpu_list(const std::string& text) {
+    std::vector<int> result;
+    std::stringstream stream(text);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n") continue;
+        try {
+            size_t dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                result.push_back(cpu);
+            }
+        } catch (const std::exception&) {
+            // Trecho malformado: ignora
+        }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+/**
+ * @brief Retorna as CPUs online
+ * @return Lista de CPUs
+ */
+const std::vector<CpuInfo>& CpuTopology::cpus() const {
+    return cpu_list;
+}
+
+/**
+ * @brief Retorna o número de núcleos físicos
+ * @return Número de núcleos
+ */
+size_t CpuTopology::num_cores() const {
+    return static_cast<size_t>(std::count_if(cpu_list.begin(), cpu_list.end(),
+        [](const CpuInfo& info) { return info.smt_rank == 0; }));
+}
+
+/**
+ * @brief Retorna o número de domínios de LLC
+ * @return Número de domínios
+ */
+size_t CpuTopology::num_llc_domains() const {
+    return llc_count;
+}
+
+/**
+ * @brief Retorna o domínio de LLC de uma CPU
+ * @param cpu CPU lógica
+ * @return Índice do domínio
+ */
+size_t CpuTopology::llc_domain(int cpu) const {
+    for (const auto& info : cpu_list) {
+        if (info.id == cpu) return info.llc;
+    }
+    return 0;
+}
+
+/**
+ * @brief Retorna as irmãs SMT de uma CPU
+ * @param cpu CPU lógica
+ * @return CPUs do mesmo núcleo físico
+ */
+std::vector<int> CpuTopology::smt_siblings(int cpu) const {
+    std::vector<int> result;
+    auto self = std::find_if(cpu_list.begin(), cpu_list.end(),
+        [cpu](const CpuInfo& info) { return info.id == cpu; });
+    if (self == cpu_list.end()) return result;
+
+    for (const auto& info : cpu_list) {
+        if (info.package == self->package && info.core == self->core) {
+            result.push_back(info.id);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Ordena CPUs para fixação de workers
+ * @param mode Compact ou Scatter
+ * @param allowed CPUs permitidas (vazio: todas)
+ * @return Ordem de fixação
+ */
+std::vector<int> CpuTopology::placement(AffinityMode mode, const std::vector<int>& allowed) const {
+    std::vector<int> result;
+    if (mode == AffinityMode::None) return result;
+
+    // Por domínio: primeiro as threads 0 de cada núcleo, depois as irmãs SMT
+    std::vector<std::vector<CpuInfo>> per_domain(llc_count);
+    for (const auto& info : cpu_list) {
+        if (allowed.empty() || std::find(allowed.begin(), allowed.end(), info.id) != allowed.end()) {
+            per_domain[info.llc].push_back(info);
+        }
+    }
+    for (auto& domain : per_domain) {
+        std::stable_sort(domain.begin(), domain.end(), [](const CpuInfo& a, const CpuInfo& b) {
+            return a.smt_rank < b.smt_rank;
+        });
+    }
+
+    if (mode == AffinityMode::Compact) {
+        for (const auto& domain : per_domain) {
+            for (const auto& info : domain) {
+                result.push_back(info.id);
+            }
+        }
+    } else {
+        for (size_t position = 0; ; ++position) {
+            bool any = false;
+            for (const auto& domain : per_domain) {
+                if (position < domain.size()) {
+                    result.push_back(domain[position].id);
+                    any = true;
+                }
+            }
+            if (!any) break;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,153 @@
+#include "thread_pool/event_count.h"
+#include <climits>
+#include <ctime>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#if defined(__linux__)
+/**
+ * @brief Dorme enquanto *address == expected
+ */
+void futex_wait(std::atomic<EventCount::Key>* address, EventCount::Key expected,
+                const timespec* timeout = nullptr) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), FUTEX_WAIT_PRIVATE, expected,
+            timeout, nullptr, 0);
+}
+
+/**
+ * @brief Acorda até count threads dormindo em address
+ */
+void futex_wake(std::atomic<EventCount::Key>* address, int count) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), FUTEX_WAKE_PRIVATE, count,
+            nullptr, nullptr, 0);
+}
+#endif
+
+}
+
+/**
+ * @brief Anuncia a espera e captura a época atual
+ * @return Chave da espera
+ */
+EventCount::Key EventCount::prepare_wait() {
+    // seq_cst: o anúncio precisa ser visível antes da nova verificação de trabalho
+    waiting.fetch_add(1, std::memory_order_seq_cst);
+    return epoch.load(std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Desiste da espera anunciada
+ */
+void EventCount::cancel_wait() {
+    waiting.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Dorme até a época mudar
+ * @param key Chave retornada por prepare_wait
+ */
+void EventCount::wait(Key key) {
+#if defined(__linux__)
+    // O futex retorna de imediato se a época já mudou; repete em despertares espúrios
+    while (epoch.load(std::memory_order_acquire) == key) {
+        futex_wait(&epoch, key);
+    }
+#else
+    {
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [this, key]() {
+            return epoch.load(std::memory_order_acquire) != key;
+        });
+    }
+#endif
+    waiting.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Dorme até a época mudar ou o prazo expirar
+ * @param key Chave retornada por prepare_wait
+ * @param timeout Tempo máximo de espera
+ * @return true se notificado, false se expirou
+ */
+bool EventCount::wait_for(Key key, std::chrono::nanoseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    bool notified = true;
+#if defined(__linux__)
+    while (epoch.load(std::memory_order_acquire) == key) {
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds::zero()) {
+            notified = false;
+            break;
+        }
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+        timespec relative{};
+        relative.tv_sec = static_cast<time_t>(seconds.count());
+        relative.tv_nsec = static_cast<long>((remaining - seconds).count());
+        futex_wait(&epoch, key, &relative);
+    }
+#else
+    {
+        std::unique_lock lock(mutex);
+        notified = condition.wait_until(lock, deadline, [this, key]() {
+            return epoch.load(std::memory_order_acquire) != key;
+        });
+    }
+#endif
+    // seq_cst: quem desiste por timeout precisa verificar a fila depois de sair
+    waiting.fetch_sub(1, std::memory_order_seq_cst);
+    return notified;
+}
+
+/**
+ * @brief Acorda até count threads, sem chamada de sistema se ninguém espera
+ * @param count Número de threads a acordar
+ */
+void EventCount::notify(size_t count) {
+    if (count == 0) return;
+
+    // Ordena a publicação do trabalho antes da leitura do contador de espera
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed) == 0) return;
+
+#if defined(__linux__)
+    epoch.fetch_add(1, std::memory_order_release);
+    futex_wake(&epoch, count >= static_cast<size_t>(INT_MAX) ? INT_MAX : static_cast<int>(count));
+#else
+    {
+        std::lock_guard lock(mutex);
+        epoch.fetch_add(1, std::memory_order_release);
+    }
+    if (count == 1) {
+        condition.notify_one();
+    } else {
+        condition.notify_all();
+    }
+#endif
+}
+
+/**
+ * @brief Acorda uma thread adormecida
+ */
+void EventCount::notify_one() {
+    notify(1);
+}
+
+/**
+ * @brief Acorda todas as threads adormecidas
+ */
+void EventCount::notify_all() {
+    notify(SIZE_MAX);
+}
+
+/**
+ * @brief Retorna o número de threads esperando
+ * @return Número de threads
+ */
+size_t EventCount::waiters() const {
+    return waiting.load(std::memory_order_relaxed);
+}
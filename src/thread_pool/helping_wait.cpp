@@ -0,0 +1,36 @@
+#include "thread_pool/helping_wait.h"
+#include "thread_pool/worker_thread.h"
+#include <algorithm>
+#include <thread>
+
+/**
+ * @brief Verifica se a thread corrente é um worker
+ * @return true dentro de um worker
+ */
+bool HelpingWait::in_worker() noexcept {
+    return WorkerThread::current() != nullptr;
+}
+
+/**
+ * @brief Executa uma tarefa pendente do worker corrente
+ * @return true se executou uma tarefa
+ */
+bool HelpingWait::run_one() {
+    WorkerThread* worker = WorkerThread::current();
+    return worker && worker->run_one();
+}
+
+/**
+ * @brief Recua sem tarefa para executar: cede a vez e depois dorme cada vez mais
+ * @param round Rodadas seguidas sem tarefa
+ */
+void HelpingWait::back_off(unsigned round) {
+    constexpr unsigned YIELD_ROUNDS = 16;
+    if (round < YIELD_ROUNDS) {
+        std::this_thread::yield();
+        return;
+    }
+    // A dependência está em execução em outro worker: 1us, 2us... até 1ms
+    unsigned shift = std::min(round - YIELD_ROUNDS, 10u);
+    std::this_thread::sleep_for(std::chrono::microseconds(1u << shift));
+}
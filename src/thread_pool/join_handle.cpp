@@ -0,0 +1,95 @@
+#include "thread_pool/join_handle.h"
+#include "thread_pool/slab_pool.h"
+#include "thread_pool/helping_wait.h"
+
+/**
+ * @brief Construtor do estado do lote
+ * @param parts Número de partes pendentes
+ */
+JoinHandle::State::State(size_t parts)
+    : remaining(parts) {}
+
+/**
+ * @brief Marca uma parte como concluída, acordando quem espera na última
+ */
+void JoinHandle::State::complete() {
+    if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard lock(mutex);
+        condition.notify_all();
+    }
+}
+
+/**
+ * @brief Registra a primeira falha do lote
+ * @param failure Exceção capturada
+ */
+void JoinHandle::State::fail(std::exception_ptr failure) {
+    std::lock_guard lock(mutex);
+    if (!has_error.load(std::memory_order_relaxed)) {
+        error = std::move(failure);
+        has_error.store(true, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief Verifica se alguma parte falhou
+ * @return true se houve falha
+ */
+bool JoinHandle::State::failed() const {
+    return has_error.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Verifica se todas as partes terminaram
+ * @return true se concluído
+ */
+bool JoinHandle::State::done() const {
+    return remaining.load(std::memory_order_acquire) == 0;
+}
+
+/**
+ * @brief Construtor do JoinHandle para um lote
+ * @param parts Número de partes
+ */
+JoinHandle::JoinHandle(size_t parts)
+    : state(std::allocate_shared<State>(PoolAllocator<State>(), parts)) {}
+
+/**
+ * @brief Espera todas as partes terminarem
+ */
+void JoinHandle::wait() const {
+    if (!state || state->done()) return;
+    if (HelpingWait::in_worker()) {
+        // Lote esperado de dentro de uma tarefa: ajuda a executá-lo
+        HelpingWait::until([this]() { return state->done(); });
+        return;
+    }
+    std::unique_lock lock(state->mutex);
+    state->condition.wait(lock, [this]() { return state->done(); });
+}
+
+/**
+ * @brief Espera o lote e relança a primeira exceção
+ */
+void JoinHandle::get() const {
+    wait();
+    if (state && state->failed()) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+/**
+ * @brief Verifica se o lote terminou
+ * @return true se concluído
+ */
+bool JoinHandle::ready() const {
+    return !state || state->done();
+}
+
+/**
+ * @brief Acesso ao estado compartilhado
+ * @return Estado do lote
+ */
+const std::shared_ptr<JoinHandle::State>& JoinHandle::shared_state() const {
+    return state;
+}
@@ -0,0 +1,329 @@
+#include "thread_pool/mutex_task_queue.h"
+
+namespace {
+
+/**
+ * @brief Converte a prioridade em índice de nível
+ */
+size_t level_index(TaskPriority priority) {
+    return static_cast<size_t>(priority);
+}
+
+}
+
+/**
+ * @brief Construtor da MutexTaskQueue
+ * @param aging_threshold Atraso efetivo por nível abaixo de High
+ * @param capacity Máximo de tarefas (0: ilimitada)
+ */
+MutexTaskQueue::MutexTaskQueue(Clock::duration aging_threshold, size_t capacity)
+    : aging_threshold(aging_threshold)
+    , limit(capacity)
+    , waiting(0)
+    , producers_waiting(0)
+    , stop_flag(false) {}
+
+/**
+ * @brief Adiciona tarefa à fila com prioridade normal
+ * @param task Tarefa a ser adicionada
+ * @return true se bem-sucedido, false se fila parada
+ */
+bool MutexTaskQueue::push(Task task) {
+    return push(std::move(task), TaskPriority::Normal);
+}
+
+/**
+ * @brief Adiciona tarefa no nível de prioridade indicado
+ * @param task Tarefa a ser adicionada
+ * @param priority Classe de prioridade
+ * @return true se bem-sucedido, false se fila parada
+ */
+bool MutexTaskQueue::push(Task task, TaskPriority priority) {
+    size_t index = level_index(priority);
+    Clock::time_point now = Clock::now();
+    {
+        std::unique_lock lock(mutex);
+        if (full() && !stop_flag) {
+            // Fila cheia: espera um consumidor liberar espaço
+            ++producers_waiting;
+            not_full.wait(lock, [this]() { return !full() || stop_flag; });
+            --producers_waiting;
+            now = Clock::now();
+        }
+        if (stop_flag) return false;
+
+        insert(index, task, now);
+    }
+    condition.notify_one();  // Notifica uma thread waiting
+    return true;
+}
+
+/**
+ * @brief Tenta adicionar tarefa sem esperar por espaço
+ * @param task Tarefa a ser adicionada
+ * @param priority Classe de prioridade
+ * @return true se adicionou, false se cheia ou parada
+ */
+bool MutexTaskQueue::try_push(Task& task, TaskPriority priority) {
+    size_t index = level_index(priority);
+    Clock::time_point now = Clock::now();
+    {
+        std::unique_lock lock(mutex);
+        if (stop_flag || full()) return false;
+
+        insert(index, task, now);
+    }
+    condition.notify_one();
+    return true;
+}
+
+/**
+ * @brief Adiciona tarefa esperando por espaço até o prazo
+ * @param task Tarefa a ser adicionada
+ * @param priority Classe de prioridade
+ * @param timeout Tempo máximo de espera
+ * @return true se adicionou, false se expirou ou parada
+ */
+bool MutexTaskQueue::push_for(Task& task, TaskPriority priority, std::chrono::nanoseconds timeout) {
+    size_t index = level_index(priority);
+    Clock::time_point now = Clock::now();
+    {
+        std::unique_lock lock(mutex);
+        if (full() && !stop_flag) {
+            ++producers_waiting;
+            bool space = not_full.wait_for(lock, timeout, [this]() { return !full() || stop_flag; });
+            --producers_waiting;
+            if (!space) return false;
+            now = Clock::now();
+        }
+        if (stop_flag) return false;
+
+        insert(index, task, now);
+    }
+    condition.notify_one();
+    return true;
+}
+
+/**
+ * @brief Adiciona um lote de tarefas sob um único lock
+ * @param tasks Tarefas a serem adicionadas
+ * @return true se bem-sucedido, false se fila parada
+ */
+bool MutexTaskQueue::push_bulk(std::vector<Task>& tasks) {
+    size_t index = level_index(TaskPriority::Normal);
+    Clock::time_point now = Clock::now();
+    size_t next = 0;
+
+    std::unique_lock lock(mutex);
+    if (stop_flag) return false;
+
+    while (true) {
+        // Publica o que couber (tudo, se a fila é ilimitada)
+        size_t first = next;
+        while (next < tasks.size() && !full()) {
+            levels[index].push_back(Entry{std::move(tasks[next++]), now});
+            depth[index].fetch_add(1, std::memory_order_relaxed);
+        }
+        size_t count = next - first;
+        size_t sleepers = waiting;
+        bool done = next == tasks.size();
+        if (!done) ++producers_waiting;
+        lock.unlock();
+
+        // Acorda apenas quantos workers forem necessários para o lote
+        if (count >= sleepers) {
+            condition.notify_all();
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                condition.notify_one();
+            }
+        }
+        if (done) break;
+
+        // Fila cheia no meio do lote: espera espaço para o restante
+        lock.lock();
+        not_full.wait(lock, [this]() { return !full() || stop_flag; });
+        --producers_waiting;
+        if (stop_flag) {
+            tasks.clear();
+            return false;
+        }
+        now = Clock::now();
+    }
+    tasks.clear();
+    return true;
+}
+
+/**
+ * @brief Remove tarefa da fila (bloqueante)
+ * @param task Referência para armazenar a tarefa
+ * @return true se obteve tarefa, false se fila parada
+ */
+bool MutexTaskQueue::pop(Task& task) {
+    std::unique_lock lock(mutex);
+
+    // Espera até que haja tarefas ou a fila seja parada
+    ++waiting;
+    condition.wait(lock, [this]() {
+        return !empty() || stop_flag;
+    });
+    --waiting;
+
+    if (stop_flag && empty()) return false;
+
+    take(task);
+    return true;
+}
+
+/**
+ * @brief Remove tarefa da fila sem bloquear
+ * @param task Referência para armazenar a tarefa
+ * @return true se obteve tarefa, false se fila vazia
+ */
+bool MutexTaskQueue::try_pop(Task& task) {
+    std::unique_lock lock(mutex);
+    if (empty()) return false;
+
+    take(task);
+    return true;
+}
+
+/**
+ * @brief Remove um lote de tarefas sob um único lock
+ * @param tasks Vetor de destino das tarefas
+ * @param max Número máximo de tarefas a remover
+ * @return Número de tarefas removidas
+ */
+size_t MutexTaskQueue::try_pop_bulk(std::vector<Task>& tasks, size_t max) {
+    std::unique_lock lock(mutex);
+    size_t count = 0;
+    while (count < max && !empty()) {
+        tasks.emplace_back();
+        take(tasks.back());
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief Remove a tarefa mais antiga do nível menos urgente
+ * @param task Referência para armazenar a tarefa
+ * @return true se removeu, false se fila vazia
+ */
+bool MutexTaskQueue::pop_oldest(Task& task) {
+    std::unique_lock lock(mutex);
+    for (size_t i = NUM_TASK_PRIORITIES; i > 0; --i) {
+        if (!levels[i - 1].empty()) {
+            remove(i - 1, task);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Para a fila e notifica todas as threads
+ */
+void MutexTaskQueue::stop() {
+    {
+        std::unique_lock lock(mutex);
+        stop_flag = true;
+    }
+    condition.notify_all();  // Notifica todas as threads waiting
+    not_full.notify_all();
+}
+
+/**
+ * @brief Verifica se a fila está parada
+ * @return true se parada, false caso contrário
+ */
+bool MutexTaskQueue::stopped() const {
+    std::unique_lock lock(mutex);
+    return stop_flag;
+}
+
+/**
+ * @brief Retorna tamanho atual da fila
+ * @return Número de tarefas em todos os níveis
+ */
+size_t MutexTaskQueue::size() const {
+    size_t total = 0;
+    for (const auto& level_depth : depth) {
+        total += level_depth.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ * @brief Retorna a profundidade de um nível de prioridade
+ * @param priority Classe de prioridade
+ * @return Número de tarefas no nível
+ */
+size_t MutexTaskQueue::size(TaskPriority priority) const {
+    return depth[level_index(priority)].load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Retorna a capacidade da fila
+ * @return Máximo de tarefas, ou 0 se ilimitada
+ */
+size_t MutexTaskQueue::capacity() const {
+    return limit;
+}
+
+/**
+ * @brief Verifica se todos os níveis estão vazios
+ */
+bool MutexTaskQueue::empty() const {
+    for (const auto& level : levels) {
+        if (!level.empty()) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Remove a próxima tarefa segundo prioridade e aging
+ */
+void MutexTaskQueue::take(Task& task) {
+    // Cada nível abaixo de High soma um limite de aging ao instante de entrada;
+    // vence a cabeça com o menor instante efetivo (empate favorece o nível mais alto)
+    size_t chosen = NUM_TASK_PRIORITIES;
+    Clock::time_point best{};
+    for (size_t i = 0; i < NUM_TASK_PRIORITIES; ++i) {
+        if (levels[i].empty()) continue;
+        Clock::time_point effective = levels[i].front().enqueued + aging_threshold * i;
+        if (chosen == NUM_TASK_PRIORITIES || effective < best) {
+            chosen = i;
+            best = effective;
+        }
+    }
+
+    remove(chosen, task);
+}
+
+/**
+ * @brief Verifica se a fila atingiu a capacidade
+ */
+bool MutexTaskQueue::full() const {
+    return limit != 0 && size() >= limit;
+}
+
+/**
+ * @brief Insere a tarefa no fim de um nível
+ */
+void MutexTaskQueue::insert(size_t index, Task& task, Clock::time_point now) {
+    levels[index].push_back(Entry{std::move(task), now});
+    depth[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Remove a cabeça de um nível, liberando um produtor que espera espaço
+ */
+void MutexTaskQueue::remove(size_t index, Task& task) {
+    task = std::move(levels[index].front().task);
+    levels[index].pop_front();
+    depth[index].fetch_sub(1, std::memory_order_relaxed);
+    if (producers_waiting > 0) {
+        not_full.notify_one();
+    }
+}
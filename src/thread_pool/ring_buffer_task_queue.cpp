@@ -0,0 +1,321 @@
+#include "thread_pool/ring_buffer_task_queue.h"
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief Arredonda para a próxima potência de dois (mínimo 2)
+ */
+size_t round_up_pow2(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+}
+
+/**
+ * @brief Construtor da RingBufferTaskQueue
+ * @param capacity Capacidade desejada
+ */
+RingBufferTaskQueue::RingBufferTaskQueue(size_t capacity)
+    : mask(round_up_pow2(capacity) - 1)
+    , cells(new Cell[mask + 1]) {
+
+    if (capacity == 0) {
+        throw std::invalid_argument("RingBufferTaskQueue requer capacidade maior que zero");
+    }
+
+    // Cada célula começa livre para a escrita da volta zero
+    for (size_t i = 0; i <= mask; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Escreve tarefa em uma célula livre (sem notificar)
+ * @param task Tarefa a ser adicionada
+ * @return true se adicionou, false se cheio
+ */
+bool RingBufferTaskQueue::enqueue(Task& task) {
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    while (true) {
+        cell = &cells[pos & mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+        if (diff == 0) {
+            // Célula livre nesta volta: reserva a posição
+            if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // Anel cheio
+        } else {
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->task = std::move(task);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Lê tarefa de uma célula publicada (sem notificar)
+ * @param task Referência para armazenar a tarefa
+ * @return true se obteve tarefa, false se vazio
+ */
+bool RingBufferTaskQueue::dequeue(Task& task) {
+    size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    while (true) {
+        cell = &cells[pos & mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+
+        if (diff == 0) {
+            // Célula publicada nesta volta: reserva a leitura
+            if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // Anel vazio
+        } else {
+            pos = dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    task = std::move(cell->task);
+    cell->task = nullptr;  // Libera capturas da tarefa imediatamente
+    cell->sequence.store(pos + mask + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Tenta adicionar tarefa sem bloquear
+ * @param task Tarefa a ser adicionada
+ * @return true se adicionou, false se cheio ou parado
+ */
+bool RingBufferTaskQueue::try_push(Task& task, TaskPriority) {
+    if (stop_flag.load(std::memory_order_acquire) || !enqueue(task)) return false;
+    notify(pop_waiters, not_empty);
+    return true;
+}
+
+/**
+ * @brief Adiciona tarefa esperando por espaço até o prazo
+ * @param task Tarefa a ser adicionada
+ * @param timeout Tempo máximo de espera
+ * @return true se adicionou, false se expirou ou parada
+ */
+bool RingBufferTaskQueue::push_for(Task& task, TaskPriority, std::chrono::nanoseconds timeout) {
+    if (stop_flag.load(std::memory_order_acquire)) return false;
+
+    if (!enqueue(task)) {
+        // Caminho lento: como push, mas desiste no prazo
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::unique_lock lock(mutex);
+        push_waiters.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool pushed = enqueue(task);
+        while (!pushed && !stop_flag.load()) {
+            bool expired = not_full.wait_until(lock, deadline) == std::cv_status::timeout;
+            pushed = enqueue(task);
+            if (expired) break;
+        }
+        push_waiters.fetch_sub(1);
+        if (!pushed) return false;
+    }
+
+    notify(pop_waiters, not_empty);
+    return true;
+}
+
+/**
+ * @brief Remove tarefa sem bloquear
+ * @param task Referência para armazenar a tarefa
+ * @return true se obteve tarefa, false se vazio
+ */
+bool RingBufferTaskQueue::try_pop(Task& task) {
+    if (!dequeue(task)) return false;
+    notify(push_waiters, not_full);
+    return true;
+}
+
+/**
+ * @brief Adiciona tarefa, bloqueando apenas com o anel cheio
+ * @param task Tarefa a ser adicionada
+ * @return true se bem-sucedido, false se parada
+ */
+bool RingBufferTaskQueue::push(Task task) {
+    if (stop_flag.load(std::memory_order_acquire)) return false;
+
+    if (!enqueue(task)) {
+        // Caminho lento: anel cheio, dorme até um consumidor liberar espaço
+        std::unique_lock lock(mutex);
+        push_waiters.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!enqueue(task)) {
+            if (stop_flag.load()) {
+                push_waiters.fetch_sub(1);
+                return false;
+            }
+            not_full.wait(lock);
+        }
+        push_waiters.fetch_sub(1);
+    }
+
+    notify(pop_waiters, not_empty);
+    return true;
+}
+
+/**
+ * @brief Adiciona um lote de tarefas
+ * @param tasks Tarefas a serem adicionadas
+ * @return true se bem-sucedido, false se parada
+ */
+bool RingBufferTaskQueue::push_bulk(std::vector<Task>& tasks) {
+    if (stop_flag.load(std::memory_order_acquire)) return false;
+
+    size_t published = 0;
+    for (auto& task : tasks) {
+        if (enqueue(task)) {
+            ++published;
+            continue;
+        }
+
+        // Anel cheio: acorda consumidores das tarefas já publicadas antes de esperar
+        notify_consumers(published);
+        published = 0;
+        if (!push(std::move(task))) {
+            tasks.clear();
+            return false;
+        }
+    }
+    tasks.clear();
+
+    notify_consumers(published);
+    return true;
+}
+
+/**
+ * @brief Remove tarefa, bloqueando apenas com o anel vazio
+ * @param task Referência para armazenar a tarefa
+ * @return true se obteve tarefa, false se parada e vazia
+ */
+bool RingBufferTaskQueue::pop(Task& task) {
+    if (try_pop(task)) return true;
+
+    {
+        // Caminho lento: anel vazio, dorme até um produtor publicar uma tarefa
+        std::unique_lock lock(mutex);
+        pop_waiters.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!dequeue(task)) {
+            if (stop_flag.load()) {
+                pop_waiters.fetch_sub(1);
+                return false;
+            }
+            not_empty.wait(lock);
+        }
+        pop_waiters.fetch_sub(1);
+    }
+
+    notify(push_waiters, not_full);
+    return true;
+}
+
+/**
+ * @brief Remove até max tarefas sem bloquear
+ * @param tasks Vetor de destino das tarefas
+ * @param max Número máximo de tarefas
+ * @return Número de tarefas removidas
+ */
+size_t RingBufferTaskQueue::try_pop_bulk(std::vector<Task>& tasks, size_t max) {
+    size_t count = 0;
+    Task task;
+    while (count < max && try_pop(task)) {
+        tasks.push_back(std::move(task));
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief Para a fila e acorda todas as threads bloqueadas
+ */
+void RingBufferTaskQueue::stop() {
+    {
+        std::lock_guard lock(mutex);
+        stop_flag.store(true);
+    }
+    not_empty.notify_all();
+    not_full.notify_all();
+}
+
+/**
+ * @brief Verifica se a fila está parada
+ * @return true se parada
+ */
+bool RingBufferTaskQueue::stopped() const {
+    return stop_flag.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Retorna o tamanho aproximado sem travar
+ * @return Número de tarefas
+ */
+size_t RingBufferTaskQueue::size() const {
+    size_t tail = dequeue_pos.load(std::memory_order_relaxed);
+    size_t head = enqueue_pos.load(std::memory_order_relaxed);
+    // Leituras independentes podem se cruzar; limita ao intervalo válido
+    if (head <= tail) return 0;
+    return std::min(head - tail, mask + 1);
+}
+
+/**
+ * @brief Retorna a capacidade do anel
+ * @return Capacidade
+ */
+size_t RingBufferTaskQueue::capacity() const {
+    return mask + 1;
+}
+
+/**
+ * @brief Acorda até count consumidores adormecidos
+ */
+void RingBufferTaskQueue::notify_consumers(size_t count) {
+    if (count == 0) return;
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    size_t sleepers = pop_waiters.load(std::memory_order_relaxed);
+    if (sleepers == 0) return;
+
+    { std::lock_guard lock(mutex); }
+    if (count >= sleepers) {
+        not_empty.notify_all();
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            not_empty.notify_one();
+        }
+    }
+}
+
+/**
+ * @brief Acorda uma thread adormecida do lado indicado, se houver
+ */
+void RingBufferTaskQueue::notify(const std::atomic<size_t>& waiters, std::condition_variable& condition) {
+    // Ordena a publicação da célula antes da leitura do contador de espera
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) == 0) return;
+
+    { std::lock_guard lock(mutex); }
+    condition.notify_one();
+}
@@ -0,0 +1,225 @@
+#include "thread_pool/slab_pool.h"
+#include <mutex>
+#include <vector>
+
+namespace {
+
+constexpr size_t MIN_BLOCK_SIZE = 64;           // Menor classe de tamanho
+constexpr size_t NUM_CLASSES = 5;               // 64, 128, 256, 512, 1024
+constexpr size_t SLAB_SIZE = 64 * 1024;         // Bytes recortados por slab
+constexpr size_t THREAD_CACHE_LIMIT = 256;      // Blocos por classe na lista local
+constexpr size_t TRANSFER_BATCH = 64;           // Blocos movidos por lote
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+/**
+ * @brief Índice da classe de tamanho que atende size bytes
+ */
+size_t class_index(size_t size) {
+    size_t index = 0;
+    size_t block = MIN_BLOCK_SIZE;
+    while (block < size) {
+        block <<= 1;
+        ++index;
+    }
+    return index;
+}
+
+/**
+ * @class GlobalPool
+ * @brief Listas livres compartilhadas e dono dos slabs
+ */
+class GlobalPool {
+public:
+    static GlobalPool& instance() {
+        static GlobalPool pool;
+        return pool;
+    }
+
+    /**
+     * @brief Retira até TRANSFER_BATCH blocos da classe, recortando um slab se preciso
+     */
+    FreeBlock* fetch(size_t index, size_t& count) {
+        SizeClass& size_class = classes[index];
+        std::lock_guard lock(size_class.mutex);
+
+        if (!size_class.head) {
+            carve_slab(index, size_class);
+        }
+
+        FreeBlock* head = size_class.head;
+        FreeBlock* tail = head;
+        count = 1;
+        while (count < TRANSFER_BATCH && tail->next) {
+            tail = tail->next;
+            ++count;
+        }
+        size_class.head = tail->next;
+        tail->next = nullptr;
+        return head;
+    }
+
+    /**
+     * @brief Devolve uma cadeia de blocos à classe
+     */
+    void release(size_t index, FreeBlock* head, FreeBlock* tail) {
+        SizeClass& size_class = classes[index];
+        std::lock_guard lock(size_class.mutex);
+        tail->next = size_class.head;
+        size_class.head = head;
+    }
+
+    ~GlobalPool() {
+        for (void* slab : slabs) {
+            ::operator delete(slab);
+        }
+    }
+
+private:
+    struct SizeClass {
+        std::mutex mutex;
+        FreeBlock* head = nullptr;
+    };
+
+    void carve_slab(size_t index, SizeClass& size_class) {
+        size_t block_size = MIN_BLOCK_SIZE << index;
+        auto* slab = static_cast<unsigned char*>(::operator new(SLAB_SIZE));
+        {
+            std::lock_guard lock(slabs_mutex);
+            slabs.push_back(slab);
+        }
+
+        for (size_t offset = 0; offset + block_size <= SLAB_SIZE; offset += block_size) {
+            auto* block = reinterpret_cast<FreeBlock*>(slab + offset);
+            block->next = size_class.head;
+            size_class.head = block;
+        }
+    }
+
+    SizeClass classes[NUM_CLASSES];
+    std::mutex slabs_mutex;
+    std::vector<void*> slabs;
+};
+
+/**
+ * @struct ThreadCache
+ * @brief Listas livres locais da thread (sem sincronização)
+ */
+struct ThreadCache {
+    FreeBlock* heads[NUM_CLASSES] = {};
+    size_t counts[NUM_CLASSES] = {};
+
+    ~ThreadCache();
+};
+
+/**
+ * @enum CacheState
+ * @brief Ciclo de vida do cache local (destrutores tardios de thread_local)
+ */
+enum class CacheState : unsigned char { Uninitialized, Alive, Destroyed };
+
+thread_local CacheState cache_state = CacheState::Uninitialized;
+thread_local ThreadCache cache;
+
+ThreadCache::~ThreadCache() {
+    cache_state = CacheState::Destroyed;
+    for (size_t i = 0; i < NUM_CLASSES; ++i) {
+        if (!heads[i]) continue;
+        FreeBlock* tail = heads[i];
+        while (tail->next) {
+            tail = tail->next;
+        }
+        GlobalPool::instance().release(i, heads[i], tail);
+    }
+}
+
+/**
+ * @brief Move metade da lista local para a lista global
+ */
+void spill(size_t index) {
+    FreeBlock* head = cache.heads[index];
+    FreeBlock* tail = head;
+    size_t moved = 1;
+    while (moved < THREAD_CACHE_LIMIT / 2) {
+        tail = tail->next;
+        ++moved;
+    }
+    cache.heads[index] = tail->next;
+    cache.counts[index] -= moved;
+    GlobalPool::instance().release(index, head, tail);
+}
+
+}
+
+/**
+ * @brief Aloca um bloco do pool
+ * @param size Tamanho em bytes
+ * @return Ponteiro para o bloco
+ */
+void* SlabPool::allocate(size_t size) {
+    if (size > MAX_BLOCK_SIZE) {
+        return ::operator new(size);
+    }
+
+    size_t index = class_index(size);
+    if (cache_state != CacheState::Alive) {
+        if (cache_state == CacheState::Destroyed) {
+            // Thread em finalização: pega um bloco direto da lista global
+            size_t count = 0;
+            FreeBlock* head = GlobalPool::instance().fetch(index, count);
+            if (head->next) {
+                FreeBlock* tail = head->next;
+                while (tail->next) {
+                    tail = tail->next;
+                }
+                GlobalPool::instance().release(index, head->next, tail);
+            }
+            return head;
+        }
+        // Primeiro uso na thread: o acesso registra o destrutor do cache
+        cache_state = CacheState::Alive;
+        (void)cache;
+    }
+
+    if (!cache.heads[index]) {
+        size_t count = 0;
+        cache.heads[index] = GlobalPool::instance().fetch(index, count);
+        cache.counts[index] = count;
+    }
+
+    FreeBlock* block = cache.heads[index];
+    cache.heads[index] = block->next;
+    cache.counts[index]--;
+    return block;
+}
+
+/**
+ * @brief Devolve um bloco ao pool
+ * @param pointer Bloco a ser devolvido
+ * @param size Tamanho usado na alocação
+ */
+void SlabPool::deallocate(void* pointer, size_t size) noexcept {
+    if (!pointer) return;
+    if (size > MAX_BLOCK_SIZE) {
+        ::operator delete(pointer);
+        return;
+    }
+
+    size_t index = class_index(size);
+    auto* block = static_cast<FreeBlock*>(pointer);
+
+    if (cache_state != CacheState::Alive) {
+        // Thread sem cache ativo: devolve direto para a lista global
+        block->next = nullptr;
+        GlobalPool::instance().release(index, block, block);
+        return;
+    }
+
+    block->next = cache.heads[index];
+    cache.heads[index] = block;
+    if (++cache.counts[index] > THREAD_CACHE_LIMIT) {
+        spill(index);
+    }
+}
@@ -0,0 +1,139 @@
+#include "thread_pool/strand.h"
+#include <iostream>
+
+namespace {
+
+/**
+ * @brief Strand cuja tarefa a thread corrente está executando
+ */
+thread_local const void* current_strand = nullptr;
+
+}
+
+/**
+ * @brief Construtor de um strand sobre o pool
+ * @param pool Pool que executa as tarefas
+ * @param priority Classe de prioridade das drenagens
+ */
+Strand::Strand(ThreadPool& pool, TaskPriority priority)
+    : state(std::allocate_shared<State>(PoolAllocator<State>(), pool, priority)) {}
+
+/**
+ * @brief Verifica se a thread corrente está executando uma tarefa deste strand
+ * @return true dentro de uma tarefa do strand
+ */
+bool Strand::running_in_this_thread() const noexcept {
+    return current_strand == state.get();
+}
+
+/**
+ * @brief Retorna o número de tarefas aguardando
+ * @return Tarefas ainda não iniciadas
+ */
+size_t Strand::pending() const {
+    std::lock_guard lock(state->mutex);
+    return state->tasks.size();
+}
+
+/**
+ * @brief Enfileira uma tarefa no estado
+ * @param state Strand de destino
+ * @param task Tarefa
+ * @return true se o strand estava ocioso (quem chamou publica a drenagem)
+ */
+bool Strand::push(State& state, TaskQueue::Task task) {
+    std::lock_guard lock(state.mutex);
+    state.tasks.push_back(std::move(task));
+    if (state.active) {
+        return false;
+    }
+    state.active = true;
+    return true;
+}
+
+/**
+ * @brief Publica a drenagem de um strand recém-ativado
+ * @param state Strand ativado por push
+ */
+void Strand::schedule(const std::shared_ptr<State>& state) {
+    try {
+        state->pool.execute([state]() { drain(state); }, state->priority);
+    } catch (...) {
+        // Pool parado ou fila cheia (RejectionPolicy::Fail). O strand estava
+        // ocioso, então a primeira tarefa é a de quem chamou, que volta
+        // rejeitada; as postadas por outras threads depois do push já foram
+        // aceitas e terminam nesta thread, como na drenagem com o pool parando
+        TaskQueue::Task rejected;
+        bool accepted;
+        {
+            std::lock_guard lock(state->mutex);
+            rejected = std::move(state->tasks.front());
+            state->tasks.pop_front();
+            accepted = !state->tasks.empty();
+            if (!accepted) state->active = false;
+        }
+        if (accepted) {
+            drain(state);
+        } else if (state->on_idle) {
+            state->on_idle();
+        }
+        throw;
+    }
+}
+
+/**
+ * @brief Executa um lote de tarefas e republica a drenagem se sobrou trabalho
+ * @param state Strand drenado
+ */
+void Strand::drain(const std::shared_ptr<State>& state) {
+    const void* outer = current_strand;
+    current_strand = state.get();
+
+    for (;;) {
+        bool idle = false;
+        for (size_t done = 0; done < DRAIN_BATCH && !idle; ++done) {
+            TaskQueue::Task task;
+            {
+                std::lock_guard lock(state->mutex);
+                if (state->tasks.empty()) {
+                    // Depois daqui, um push publica uma nova drenagem
+                    state->active = false;
+                    idle = true;
+                    continue;
+                }
+                task = std::move(state->tasks.front());
+                state->tasks.pop_front();
+            }
+            task();
+        }
+
+        if (idle) {
+            current_strand = outer;
+            if (state->on_idle) state->on_idle();
+            return;
+        }
+
+        // Lote esgotado: devolve o worker e continua no fim da fila do pool
+        try {
+            state->pool.execute([state]() { drain(state); }, state->priority);
+            current_strand = outer;
+            return;
+        } catch (...) {
+            // Pool parando: termina a fila nesta thread para não perder tarefas
+        }
+    }
+}
+
+/**
+ * @brief Registra a exceção de uma tarefa postada
+ * @param error Exceção capturada
+ */
+void Strand::report(std::exception_ptr error) noexcept {
+    try {
+        std::rethrow_exception(error);
+    } catch (const std::exception& e) {
+        std::cerr << "Exceção em Strand: " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "Exceção desconhecida em Strand" << std::endl;
+    }
+}
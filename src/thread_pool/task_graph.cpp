@@ -0,0 +1,142 @@
+#include "thread_pool/task_graph.h"
+#include <stdexcept>
+
+/**
+ * @brief Declara que este nó precede outro
+ * @param successor Nó sucessor
+ * @return Este nó
+ */
+TaskGraph::Node& TaskGraph::Node::precede(const Node& successor) {
+    graph->add_edge(state, successor.state);
+    return *this;
+}
+
+/**
+ * @brief Destrutor que espera a execução em andamento
+ */
+TaskGraph::~TaskGraph() {
+    running.wait();
+}
+
+/**
+ * @brief Libera os nós sem predecessores no pool
+ * @param pool Pool de execução
+ * @return Handle da execução
+ */
+JoinHandle TaskGraph::run(ThreadPool& pool) {
+    if (!running.ready()) {
+        throw std::logic_error("TaskGraph já está em execução");
+    }
+
+    // Kahn: um ciclo deixaria nós para sempre pendentes
+    std::vector<size_t> indegree;
+    std::vector<NodeState*> ready;
+    indegree.reserve(nodes.size());
+    for (auto& node : nodes) {
+        node->remaining.store(node->predecessors, std::memory_order_relaxed);
+        node->upstream_failed.store(false, std::memory_order_relaxed);
+        node->error = nullptr;
+        indegree.push_back(node->predecessors);
+    }
+    std::vector<NodeState*> order;
+    for (auto& node : nodes) {
+        if (node->predecessors == 0) order.push_back(node.get());
+    }
+    ready = order;
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (NodeState* successor : order[i]->successors) {
+            if (--successor->remaining == 0) order.push_back(successor);
+        }
+    }
+    if (order.size() != nodes.size()) {
+        throw std::logic_error("TaskGraph contém ciclo");
+    }
+    for (auto& node : nodes) {
+        node->remaining.store(node->predecessors, std::memory_order_relaxed);
+    }
+
+    this->pool = &pool;
+    running = JoinHandle(nodes.size());
+    for (NodeState* root : ready) {
+        schedule(root);
+    }
+    return running;
+}
+
+/**
+ * @brief Retorna o número de nós
+ * @return Número de nós
+ */
+size_t TaskGraph::size() const {
+    return nodes.size();
+}
+
+/**
+ * @brief Cria um nó
+ * @param work Função do nó
+ * @return Estado do nó
+ */
+TaskGraph::NodeState* TaskGraph::add_node(InlineTask work) {
+    if (!running.ready()) {
+        throw std::logic_error("TaskGraph não pode ser alterado durante a execução");
+    }
+    nodes.push_back(std::make_unique<NodeState>());
+    nodes.back()->work = std::move(work);
+    return nodes.back().get();
+}
+
+/**
+ * @brief Registra a aresta from -> to
+ */
+void TaskGraph::add_edge(NodeState* from, NodeState* to) {
+    if (!running.ready()) {
+        throw std::logic_error("TaskGraph não pode ser alterado durante a execução");
+    }
+    from->successors.push_back(to);
+    ++to->predecessors;
+}
+
+/**
+ * @brief Enfileira um nó liberado
+ */
+void TaskGraph::schedule(NodeState* node) {
+    pool->execute([this, node]() { execute(node); });
+}
+
+/**
+ * @brief Executa um nó e segue pelo primeiro sucessor que ele liberar
+ */
+void TaskGraph::execute(NodeState* node) {
+    // Cópia própria: o grafo (e seu handle) pode ser destruído logo após o último complete
+    std::shared_ptr<JoinHandle::State> state = running.shared_state();
+    while (node) {
+        // Nó com predecessor falho herda a falha sem executar
+        if (!node->error) {
+            try {
+                node->work();
+            } catch (...) {
+                node->error = std::current_exception();
+            }
+        }
+        if (node->error) {
+            state->fail(node->error);
+        }
+
+        NodeState* next = nullptr;
+        for (NodeState* successor : node->successors) {
+            if (node->error && !successor->upstream_failed.exchange(true)) {
+                successor->error = node->error;
+            }
+            if (successor->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                if (next) {
+                    schedule(next);
+                }
+                next = successor;
+            }
+        }
+
+        // Depois do último complete o grafo pode ser destruído: não toca mais em this
+        state->complete();
+        node = next;
+    }
+}
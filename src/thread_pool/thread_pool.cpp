@@ -1,41 +1,161 @@
 #include "thread_pool/thread_pool.h"
+#include "thread_pool/mutex_task_queue.h"
+#include "thread_pool/ring_buffer_task_queue.h"
+#include "thread_pool/cpu_topology.h"
+
+namespace {
+
+/**
+ * @brief Cria a fila de tarefas conforme o backend escolhido
+ */
+std::shared_ptr<TaskQueue> make_task_queue(const ThreadPoolOptions& options) {
+    if (options.queue_backend == QueueBackend::RingBuffer) {
+        return std::make_shared<RingBufferTaskQueue>(options.queue_capacity);
+    }
+    return std::make_shared<MutexTaskQueue>(options.priority_aging, options.queue_limit);
+}
+
+}
 
 /**
  * @brief Construtor do ThreadPool
  * @param num_threads Número de threads a serem criadas
  */
 ThreadPool::ThreadPool(size_t num_threads)
-    : task_queue(std::make_shared<TaskQueue>())
-    , stop(false) {
+    : ThreadPool(ThreadPoolOptions{num_threads, SchedulerMode::SharedQueue}) {}
 
-    // Cria as threads workers
-    for (size_t i = 0; i < num_threads; ++i) {
-        workers.emplace_back(std::make_unique<WorkerThread>(task_queue));
+/**
+ * @brief Construtor do ThreadPool a partir de opções
+ * @param options Número de threads, modo de escalonamento, backend da fila e espera
+ */
+ThreadPool::ThreadPool(const ThreadPoolOptions& options)
+    : mode(options.scheduler)
+    , stop(false)
+    , config(options)
+    , min_threads(std::max<size_t>(options.min_threads ? options.min_threads : options.num_threads, 1))
+    , max_threads(std::max(options.max_threads ? options.max_threads : options.num_threads, min_threads)) {
+
+    // Cria a fonte de tarefas conforme o modo de escalonamento; no modo
+    // work-stealing há uma deque local para cada worker que pode existir
+    if (mode == SchedulerMode::WorkStealing) {
+        scheduler = std::make_shared<WorkStealingScheduler>(max_threads, make_task_queue(options));
+        for (size_t i = max_threads; i > 0; --i) {
+            free_indices.push_back(i - 1);
+        }
+    } else {
+        task_queue = make_task_queue(options);
+        idle = std::make_shared<EventCount>();
+    }
+    bounded = (scheduler ? scheduler->capacity() : task_queue->capacity()) != 0;
+    tracer.enable(options.tracing);
+
+    // Ordem de fixação dos workers segundo a topologia lida de /sys
+    if (options.affinity != AffinityMode::None) {
+        CpuTopology topology = CpuTopology::detect();
+        placement = topology.placement(options.affinity, options.cpu_set);
+        for (int cpu : placement) {
+            placement_domains.push_back(topology.llc_domain(cpu));
+        }
     }
+
+    size_t initial = std::clamp(options.num_threads, min_threads, max_threads);
+    std::lock_guard lock(resize_mutex);
+    for (size_t i = 0; i < initial; ++i) {
+        add_worker();
+    }
+    live.store(initial);
+    peak_threads = initial;
 }
 
 /**
  * @brief Destrutor do ThreadPool
  */
 ThreadPool::~ThreadPool() {
+    // Para os timers primeiro: nenhum disparo chega a uma fila parada
+    timer_wheel.reset();
+
     // Para a fila de tarefas
-    task_queue->stop();
+    if (scheduler) {
+        scheduler->stop();
+    } else {
+        task_queue->stop();
+        idle->notify_all();
+    }
+
+    // Impede novos crescimentos e assume os workers (aposentados ou não)
+    std::vector<std::unique_ptr<WorkerThread>> remaining;
+    {
+        std::lock_guard lock(resize_mutex);
+        stop = true;
+        remaining.swap(workers);
+    }
 
     // Para e junta todas as threads workers
-    for (auto& worker : workers) {
+    for (auto& worker : remaining) {
         worker->stop();
     }
-    for (auto& worker : workers) {
+    for (auto& worker : remaining) {
         worker->join();
     }
 }
 
 /**
- * @brief Retorna o número de threads no pool
+ * @brief Retorna o número de threads vivas no pool
  * @return Número de threads
  */
 size_t ThreadPool::size() const {
-    return workers.size();
+    return live.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Retorna um retrato do pool
+ * @return Estatísticas do pool
+ */
+ThreadPoolStats ThreadPool::stats() const {
+    std::lock_guard lock(resize_mutex);
+    ThreadPoolStats result;
+    result.live_threads = live.load();
+    result.min_threads = min_threads;
+    result.max_threads = max_threads;
+    result.peak_threads = peak_threads;
+    result.grow_events = grow_events;
+    result.shrink_events = shrink_events;
+    result.rejected_submissions = rejected_count.load(std::memory_order_relaxed);
+    result.blocked_submissions = blocked_count.load(std::memory_order_relaxed);
+    result.recent_resizes.assign(resize_events.begin(), resize_events.end());
+    result.queued_tasks = scheduler ? scheduler->size() : task_queue->size();
+
+    result.totals = retired_stats;
+    for (const auto& worker : workers) {
+        WorkerStats counters = worker->stats();
+        result.totals.merge(counters);
+        if (worker->finished()) continue;
+        if (!scheduler) counters.index = result.workers.size();
+        result.workers.push_back(counters);
+    }
+    return result;
+}
+
+/**
+ * @brief Liga a gravação da linha do tempo das tarefas
+ */
+void ThreadPool::start_tracing() {
+    tracer.enable(true);
+}
+
+/**
+ * @brief Desliga a gravação, mantendo os eventos já gravados
+ */
+void ThreadPool::stop_tracing() {
+    tracer.enable(false);
+}
+
+/**
+ * @brief Escreve os eventos gravados como Chrome trace JSON
+ * @param out Destino do JSON
+ */
+void ThreadPool::write_trace(std::ostream& out) const {
+    tracer.write_json(out);
 }
 
 /**
@@ -45,3 +165,318 @@ size_t ThreadPool::size() const {
 bool ThreadPool::stopped() const {
     return stop;
 }
+
+/**
+ * @brief Retorna o modo de escalonamento do pool
+ * @return Modo de escalonamento
+ */
+SchedulerMode ThreadPool::scheduler_mode() const {
+    return mode;
+}
+
+/**
+ * @brief Retorna a profundidade de fila de uma classe de prioridade
+ * @param priority Classe de prioridade
+ * @return Número de tarefas aguardando execução
+ */
+size_t ThreadPool::queue_depth(TaskPriority priority) const {
+    if (scheduler) {
+        return scheduler->size(priority);
+    }
+    return task_queue->size(priority);
+}
+
+/**
+ * @brief Enfileira tarefa, aplicando a política de rejeição com a fila cheia
+ * @param task Tarefa a ser enfileirada
+ * @param priority Classe de prioridade
+ * @return true se bem-sucedido, false se parado
+ */
+bool ThreadPool::enqueue(TaskQueue::Task task, TaskPriority priority) {
+    constexpr auto no_wait = std::chrono::nanoseconds::zero();
+    constexpr auto no_deadline = std::chrono::nanoseconds::max();
+
+    if (tracer.enabled()) {
+        task = tracer.wrap(std::move(task));
+    }
+    if (!bounded) return publish(task, priority, no_deadline);
+    if (publish(task, priority, no_wait)) return true;
+    if (queue_stopped()) return false;
+
+    switch (config.rejection_policy) {
+    case RejectionPolicy::Block:
+        blocked_count.fetch_add(1, std::memory_order_relaxed);
+        return publish(task, priority, no_deadline);
+
+    case RejectionPolicy::CallerRuns:
+        // A thread que submeteu paga o custo: freia o produtor naturalmente
+        rejected_count.fetch_add(1, std::memory_order_relaxed);
+        task();
+        return true;
+
+    case RejectionPolicy::DropOldest:
+        while (true) {
+            // A tarefa descartada é destruída aqui; seu future recebe broken_promise
+            TaskQueue::Task victim;
+            bool dropped = scheduler ? scheduler->pop_oldest(victim) : task_queue->pop_oldest(victim);
+            if (dropped) {
+                rejected_count.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (publish(task, priority, no_wait)) return true;
+            if (queue_stopped()) return false;
+        }
+
+    case RejectionPolicy::Fail:
+        rejected_count.fetch_add(1, std::memory_order_relaxed);
+        throw QueueFullError();
+    }
+    return false;
+}
+
+/**
+ * @brief Enfileira tarefa esperando por espaço até o prazo
+ * @param task Tarefa a ser enfileirada
+ * @param priority Classe de prioridade
+ * @param timeout Tempo máximo de espera (zero: não espera)
+ * @return true se enfileirou, false se cheia ou parado
+ */
+bool ThreadPool::enqueue_for(TaskQueue::Task& task, TaskPriority priority, std::chrono::nanoseconds timeout) {
+    if (tracer.enabled()) {
+        task = tracer.wrap(std::move(task));
+    }
+    if (publish(task, priority, std::chrono::nanoseconds::zero())) return true;
+    if (queue_stopped()) return false;
+
+    if (timeout > std::chrono::nanoseconds::zero()) {
+        blocked_count.fetch_add(1, std::memory_order_relaxed);
+        if (publish(task, priority, timeout)) return true;
+        if (queue_stopped()) return false;
+    }
+    rejected_count.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+/**
+ * @brief Publica tarefa conforme o modo de escalonamento
+ * @param task Tarefa a ser publicada
+ * @param priority Classe de prioridade
+ * @param timeout Zero: não espera; nanoseconds::max(): espera sem prazo
+ * @return true se publicou
+ */
+bool ThreadPool::publish(TaskQueue::Task& task, TaskPriority priority, std::chrono::nanoseconds timeout) {
+    if (config.task_metrics) {
+        task.stamp(WorkerMetrics::now());
+    }
+
+    bool pushed;
+    if (scheduler) {
+        if (timeout == std::chrono::nanoseconds::max()) {
+            pushed = scheduler->push(std::move(task), priority);
+        } else if (timeout == std::chrono::nanoseconds::zero()) {
+            pushed = scheduler->try_push(task, priority);
+        } else {
+            pushed = scheduler->push_for(task, priority, timeout);
+        }
+    } else {
+        if (timeout == std::chrono::nanoseconds::max()) {
+            pushed = task_queue->push(std::move(task), priority);
+        } else if (timeout == std::chrono::nanoseconds::zero()) {
+            pushed = task_queue->try_push(task, priority);
+        } else {
+            pushed = task_queue->push_for(task, priority, timeout);
+        }
+        if (pushed) {
+            idle->notify_one();  // Sem chamada de sistema se nenhum worker dorme
+        }
+    }
+    if (!pushed) return false;
+
+    maybe_grow();
+    return true;
+}
+
+/**
+ * @brief Cancela um timer pendente
+ * @param id Id do timer
+ * @return true se estava pendente
+ */
+bool ThreadPool::cancel_timer(TimerId id) {
+    return timers().cancel(id);
+}
+
+/**
+ * @brief Retorna a roda de timers, criada no primeiro uso
+ * @return Roda de timers do pool
+ */
+TimerWheel& ThreadPool::timers() {
+    std::call_once(timers_once, [this]() {
+        timer_wheel = std::make_unique<TimerWheel>([this](TaskQueue::Task task) {
+            enqueue(std::move(task));
+        }, config.timer_resolution);
+    });
+    return *timer_wheel;
+}
+
+/**
+ * @brief Verifica se a fila já foi parada
+ * @return true se parada
+ */
+bool ThreadPool::queue_stopped() const {
+    return scheduler ? scheduler->stopped() : task_queue->stopped();
+}
+
+/**
+ * @brief Enfileira lote de tarefas conforme o modo de escalonamento
+ * @param tasks Tarefas a serem enfileiradas
+ * @return true se bem-sucedido, false se parado
+ */
+bool ThreadPool::enqueue_bulk(std::vector<TaskQueue::Task>& tasks) {
+    if (tracer.enabled()) {
+        for (auto& task : tasks) {
+            task = tracer.wrap(std::move(task));
+        }
+    }
+    if (config.task_metrics) {
+        int64_t now = WorkerMetrics::now();
+        for (auto& task : tasks) {
+            task.stamp(now);
+        }
+    }
+
+    if (scheduler) {
+        if (!scheduler->push_bulk(tasks)) return false;
+    } else {
+        size_t count = tasks.size();
+        if (!task_queue->push_bulk(tasks)) return false;
+        idle->notify(count);
+    }
+    maybe_grow();
+    return true;
+}
+
+/**
+ * @brief Cresce o pool quando há backlog sem worker ocioso para absorvê-lo
+ */
+void ThreadPool::maybe_grow() {
+    // Caminho rápido: pool fixo ou já no máximo
+    if (max_threads == min_threads || live.load(std::memory_order_relaxed) >= max_threads) return;
+
+    // Tarefas além das que os workers ociosos (ou acordando) vão absorver
+    EventCount& event = scheduler ? scheduler->idle_event() : *idle;
+    size_t depth = scheduler ? scheduler->size() : task_queue->size();
+    size_t waiters = event.waiters();
+    if (depth <= waiters) {
+        backlog_since.store(0, std::memory_order_relaxed);
+        return;
+    }
+
+    if (depth - waiters >= config.grow_queue_depth) {
+        grow(ResizeReason::QueueDepth);
+        return;
+    }
+
+    // Backlog pequeno, mas persistente (ex.: todos os workers em tarefas bloqueantes)
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t since = backlog_since.load(std::memory_order_relaxed);
+    if (since == 0) {
+        backlog_since.compare_exchange_strong(since, now, std::memory_order_relaxed);
+    } else if (now - since >= std::chrono::nanoseconds(config.grow_wait_time).count() &&
+               backlog_since.compare_exchange_strong(since, 0, std::memory_order_relaxed)) {
+        grow(ResizeReason::QueueWait);
+    }
+}
+
+/**
+ * @brief Cria um worker se abaixo do máximo
+ * @param reason Motivo do crescimento
+ */
+void ThreadPool::grow(ResizeReason reason) {
+    // Um crescimento por vez; submissões concorrentes não esperam
+    std::unique_lock lock(resize_mutex, std::try_to_lock);
+    if (!lock.owns_lock() || stop) return;
+
+    reap_workers();
+    size_t current = live.load();
+    if (current >= max_threads) return;
+    // retire_worker já descontou o worker que está saindo, mas ele só devolve
+    // o índice da sua deque ao terminar: até lá, a vaga continua ocupada
+    if (scheduler && free_indices.empty()) return;
+
+    add_worker();
+    live.store(current + 1);
+    peak_threads = std::max(peak_threads, current + 1);
+    ++grow_events;
+    record_resize(current, current + 1, reason);
+}
+
+/**
+ * @brief Decide se um worker ocioso pode sair
+ * @return true se o worker deve sair
+ */
+bool ThreadPool::retire_worker() {
+    std::lock_guard lock(resize_mutex);
+    size_t current = live.load();
+    if (stop || current <= min_threads) return false;
+
+    reap_workers();
+    live.store(current - 1);
+    ++shrink_events;
+    record_resize(current, current - 1, ResizeReason::IdleTimeout);
+    return true;
+}
+
+/**
+ * @brief Cria e registra um worker
+ */
+void ThreadPool::add_worker() {
+    WorkerRetirement retirement;
+    if (max_threads > min_threads) {
+        retirement.idle_timeout = config.idle_timeout;
+        retirement.may_retire = [this]() { return retire_worker(); };
+    }
+
+    // No modo work-stealing a posição é o índice da deque, estável entre reusos
+    size_t slot = scheduler ? free_indices.back() : next_placement++;
+    if (scheduler) {
+        free_indices.pop_back();
+        if (!placement.empty()) {
+            scheduler->set_domain(slot, placement_domains[slot % placement.size()]);
+        }
+        workers.emplace_back(std::make_unique<WorkerThread>(
+            scheduler, slot, config.wait_strategy, std::move(retirement), config.task_metrics));
+    } else {
+        workers.emplace_back(std::make_unique<WorkerThread>(
+            task_queue, idle, config.wait_strategy, std::move(retirement), config.task_metrics));
+    }
+
+    if (!placement.empty()) {
+        workers.back()->pin_to_cpu(placement[slot % placement.size()]);
+    }
+}
+
+/**
+ * @brief Junta workers que já saíram do loop e libera seus índices
+ */
+void ThreadPool::reap_workers() {
+    auto it = std::remove_if(workers.begin(), workers.end(), [this](std::unique_ptr<WorkerThread>& worker) {
+        if (!worker->finished()) return false;
+        worker->join();
+        retired_stats.merge(worker->stats());
+        if (scheduler) {
+            free_indices.push_back(worker->worker_index());
+        }
+        return true;
+    });
+    workers.erase(it, workers.end());
+}
+
+/**
+ * @brief Registra um evento de redimensionamento, mantendo os 64 mais recentes
+ */
+void ThreadPool::record_resize(size_t from, size_t to, ResizeReason reason) {
+    resize_events.push_back(ResizeEvent{std::chrono::steady_clock::now(), from, to, reason});
+    if (resize_events.size() > 64) {
+        resize_events.pop_front();
+    }
+}
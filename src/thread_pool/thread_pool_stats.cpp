@@ -0,0 +1,87 @@
+#include "thread_pool/thread_pool_stats.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Retorna o balde de uma duração
+ * @param nanoseconds Duração em ns
+ * @return Índice do balde
+ */
+size_t LatencyHistogram::bucket_of(uint64_t nanoseconds) {
+    if (nanoseconds == 0) return 0;
+    size_t bits = 64 - static_cast<size_t>(__builtin_clzll(nanoseconds));
+    return std::min(bits, BUCKETS - 1);
+}
+
+/**
+ * @brief Retorna o limite superior de um balde
+ * @param bucket Índice do balde
+ * @return Limite em ns
+ */
+std::chrono::nanoseconds LatencyHistogram::bucket_limit(size_t bucket) {
+    if (bucket == 0) return std::chrono::nanoseconds(1);
+    if (bucket >= BUCKETS - 1) return std::chrono::nanoseconds::max();
+    return std::chrono::nanoseconds(int64_t{1} << bucket);
+}
+
+/**
+ * @brief Estima um percentil pelo limite superior do balde
+ * @param fraction Fração em [0, 1]
+ * @return Duração estimada
+ */
+std::chrono::nanoseconds LatencyHistogram::percentile(double fraction) const {
+    if (count == 0) return std::chrono::nanoseconds(0);
+
+    // Posição (1..count) da amostra procurada
+    double clamped = std::clamp(fraction, 0.0, 1.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped * static_cast<double>(count))));
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+        seen += buckets[bucket];
+        if (seen >= rank) return bucket_limit(bucket);
+    }
+    return bucket_limit(BUCKETS - 1);
+}
+
+/**
+ * @brief Retorna a duração média
+ * @return Média
+ */
+std::chrono::nanoseconds LatencyHistogram::mean() const {
+    if (count == 0) return std::chrono::nanoseconds(0);
+    return total / static_cast<int64_t>(count);
+}
+
+/**
+ * @brief Soma outro histograma a este
+ * @param other Histograma somado
+ */
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+        buckets[bucket] += other.buckets[bucket];
+    }
+    count += other.count;
+    total += other.total;
+}
+
+/**
+ * @brief Soma os contadores de outro worker
+ * @param other Contadores somados
+ */
+void WorkerStats::merge(const WorkerStats& other) {
+    tasks_executed += other.tasks_executed;
+    busy_time += other.busy_time;
+    idle_time += other.idle_time;
+    queue_wait.merge(other.queue_wait);
+    run_time.merge(other.run_time);
+}
+
+/**
+ * @brief Fração do tempo medido gasta executando tarefas
+ * @return Utilização em [0, 1]
+ */
+double WorkerStats::utilization() const {
+    auto measured = busy_time + idle_time;
+    if (measured.count() <= 0) return 0.0;
+    return static_cast<double>(busy_time.count()) / static_cast<double>(measured.count());
+}
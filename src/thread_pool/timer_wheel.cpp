@@ -0,0 +1,346 @@
+#include "thread_pool/timer_wheel.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+/**
+ * @class PeriodicFiring
+ * @brief Disparo de uma tarefa periódica entregue ao sink
+ *
+ * Libera o próximo disparo ao terminar a execução ou, se o disparo for
+ * descartado sem executar, ao ser destruído.
+ */
+template<class Periodic>
+class PeriodicFiring {
+public:
+    explicit PeriodicFiring(std::shared_ptr<Periodic> periodic) noexcept
+        : periodic(std::move(periodic)) {}
+
+    PeriodicFiring(PeriodicFiring&&) noexcept = default;
+
+    ~PeriodicFiring() {
+        if (periodic) periodic->running.store(false, std::memory_order_release);
+    }
+
+    void operator()() {
+        // Libera o próximo disparo mesmo se o corpo lançar
+        std::shared_ptr<Periodic> owner = std::move(periodic);
+        struct Done {
+            Periodic& state;
+            ~Done() { state.running.store(false, std::memory_order_release); }
+        } done{*owner};
+        owner->body();
+    }
+
+private:
+    std::shared_ptr<Periodic> periodic;         ///< Corpo compartilhado
+};
+
+}
+
+/**
+ * @brief Construtor do TimerWheel
+ * @param sink Destino das tarefas vencidas
+ * @param resolution Duração de um tick
+ */
+TimerWheel::TimerWheel(Sink sink, Clock::duration resolution)
+    : sink(std::move(sink))
+    , resolution(std::max<Clock::duration>(resolution, Clock::duration(1)))
+    , origin(Clock::now()) {
+    heads.fill(NIL);
+    thread = std::thread(&TimerWheel::run, this);
+}
+
+/**
+ * @brief Destrutor do TimerWheel
+ */
+TimerWheel::~TimerWheel() {
+    {
+        std::lock_guard lock(mutex);
+        stop_flag = true;
+    }
+    wakeup.notify_one();
+    thread.join();
+}
+
+/**
+ * @brief Agenda uma tarefa para um instante
+ * @param when Instante mínimo de disparo
+ * @param task Tarefa
+ * @return Id do timer
+ */
+TimerId TimerWheel::schedule_at(Clock::time_point when, InlineTask task) {
+    uint64_t expiry = tick_at(when);
+    std::unique_lock lock(mutex);
+    TimerId id = add(expiry, 0, std::move(task), nullptr);
+    bool earlier = nodes[id.index].expiry < wake_tick;
+    lock.unlock();
+
+    // Só acorda a thread se ela dorme até depois do novo prazo
+    if (earlier) wakeup.notify_one();
+    return id;
+}
+
+/**
+ * @brief Agenda uma tarefa periódica
+ * @param first Instante do primeiro disparo
+ * @param period Intervalo entre disparos
+ * @param task Tarefa
+ * @return Id do timer
+ */
+TimerId TimerWheel::schedule_every(Clock::time_point first, Clock::duration period, InlineTask task) {
+    uint64_t expiry = tick_at(first);
+    uint64_t ticks = std::max<uint64_t>(1, static_cast<uint64_t>((period + resolution - Clock::duration(1)) / resolution));
+    auto periodic = std::make_shared<Periodic>();
+    periodic->body = std::move(task);
+
+    std::unique_lock lock(mutex);
+    TimerId id = add(expiry, ticks, nullptr, std::move(periodic));
+    bool earlier = nodes[id.index].expiry < wake_tick;
+    lock.unlock();
+
+    if (earlier) wakeup.notify_one();
+    return id;
+}
+
+/**
+ * @brief Cancela um timer pendente
+ * @param id Id do timer
+ * @return true se estava pendente
+ */
+bool TimerWheel::cancel(TimerId id) {
+    std::lock_guard lock(mutex);
+    if (id.index >= nodes.size()) return false;
+
+    Node& node = nodes[id.index];
+    if (node.generation != id.generation || node.list == NO_LIST) return false;
+
+    unlink(id.index);
+    release(id.index);
+    return true;
+}
+
+/**
+ * @brief Retorna o número de timers pendentes
+ * @return Número de timers
+ */
+size_t TimerWheel::pending() const {
+    std::lock_guard lock(mutex);
+    return count;
+}
+
+/**
+ * @brief Loop da thread do timer: avança, entrega vencidas e dorme até o próximo evento
+ */
+void TimerWheel::run() {
+    std::vector<InlineTask> expired;
+    std::unique_lock lock(mutex);
+
+    while (!stop_flag) {
+        advance(tick_now(Clock::now()), expired);
+
+        if (!expired.empty()) {
+            // Entrega fora do lock: o sink pode esperar por espaço na fila
+            lock.unlock();
+            for (auto& task : expired) {
+                try {
+                    sink(std::move(task));
+                } catch (const std::exception& e) {
+                    std::cerr << "Exceção em TimerWheel: " << e.what() << std::endl;
+                }
+            }
+            expired.clear();
+            lock.lock();
+            continue;
+        }
+
+        uint64_t next = next_event();
+        wake_tick = next;
+        if (next == UINT64_MAX) {
+            wakeup.wait(lock);
+        } else {
+            wakeup.wait_until(lock, origin + resolution * next);
+        }
+        wake_tick = 0;
+    }
+}
+
+/**
+ * @brief Cria um nó e o encadeia
+ */
+TimerId TimerWheel::add(uint64_t expiry, uint64_t period, InlineTask task, std::shared_ptr<Periodic> periodic) {
+    uint32_t index;
+    if (!free_nodes.empty()) {
+        index = free_nodes.back();
+        free_nodes.pop_back();
+    } else {
+        index = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+    }
+
+    Node& node = nodes[index];
+    node.task = std::move(task);
+    node.periodic = std::move(periodic);
+    node.expiry = std::max(expiry, current + 1);
+    node.period = period;
+    link(index);
+    ++count;
+    return TimerId{index, node.generation};
+}
+
+/**
+ * @brief Encadeia um nó no nível mais baixo que compartilha os bits altos com o tick corrente
+ */
+void TimerWheel::link(uint32_t index) {
+    Node& node = nodes[index];
+    uint32_t list = OVERFLOW_LIST;
+    for (size_t level = 0; level < LEVELS; ++level) {
+        size_t shift = SLOT_BITS * (level + 1);
+        if ((node.expiry >> shift) == (current >> shift)) {
+            list = static_cast<uint32_t>(level * SLOTS + ((node.expiry >> (SLOT_BITS * level)) & (SLOTS - 1)));
+            break;
+        }
+    }
+
+    node.list = list;
+    node.prev = NIL;
+    node.next = heads[list];
+    if (node.next != NIL) {
+        nodes[node.next].prev = index;
+    }
+    heads[list] = index;
+    if (list < OVERFLOW_LIST) {
+        occupied[list / SLOTS] |= uint64_t{1} << (list % SLOTS);
+    }
+}
+
+/**
+ * @brief Remove um nó da sua lista
+ */
+void TimerWheel::unlink(uint32_t index) {
+    Node& node = nodes[index];
+    if (node.prev != NIL) {
+        nodes[node.prev].next = node.next;
+    } else {
+        heads[node.list] = node.next;
+    }
+    if (node.next != NIL) {
+        nodes[node.next].prev = node.prev;
+    }
+    if (heads[node.list] == NIL && node.list < OVERFLOW_LIST) {
+        occupied[node.list / SLOTS] &= ~(uint64_t{1} << (node.list % SLOTS));
+    }
+    node.list = NO_LIST;
+}
+
+/**
+ * @brief Devolve um nó à lista livre, invalidando ids antigos
+ */
+void TimerWheel::release(uint32_t index) {
+    Node& node = nodes[index];
+    node.task = nullptr;
+    node.periodic.reset();
+    node.list = NO_LIST;
+    ++node.generation;
+    free_nodes.push_back(index);
+    --count;
+}
+
+/**
+ * @brief Retira todos os nós de uma lista e os reencadeia relativos ao tick corrente
+ */
+void TimerWheel::cascade(uint32_t list) {
+    uint32_t index = heads[list];
+    heads[list] = NIL;
+    if (list < OVERFLOW_LIST) {
+        occupied[list / SLOTS] &= ~(uint64_t{1} << (list % SLOTS));
+    }
+    while (index != NIL) {
+        uint32_t following = nodes[index].next;
+        link(index);
+        index = following;
+    }
+}
+
+/**
+ * @brief Avança a roda até target, pulando direto entre ticks com eventos
+ */
+void TimerWheel::advance(uint64_t target, std::vector<InlineTask>& expired) {
+    while (current < target) {
+        current = std::min(next_event(), target);
+
+        // Cascatas do nível mais alto para o mais baixo: um timer pode descer vários níveis no mesmo tick
+        if (heads[OVERFLOW_LIST] != NIL && (current & ((uint64_t{1} << (SLOT_BITS * LEVELS)) - 1)) == 0) {
+            cascade(OVERFLOW_LIST);
+        }
+        for (size_t level = LEVELS - 1; level > 0; --level) {
+            if ((current & ((uint64_t{1} << (SLOT_BITS * level)) - 1)) == 0) {
+                cascade(static_cast<uint32_t>(level * SLOTS + ((current >> (SLOT_BITS * level)) & (SLOTS - 1))));
+            }
+        }
+
+        // Dispara a posição do tick corrente no nível 0
+        uint32_t list = static_cast<uint32_t>(current & (SLOTS - 1));
+        uint32_t index = heads[list];
+        heads[list] = NIL;
+        occupied[0] &= ~(uint64_t{1} << list);
+        while (index != NIL) {
+            Node& node = nodes[index];
+            uint32_t following = node.next;
+            if (node.period == 0) {
+                expired.push_back(std::move(node.task));
+                release(index);
+            } else {
+                // Pula o disparo se a execução anterior ainda não terminou
+                if (!node.periodic->running.exchange(true, std::memory_order_acq_rel)) {
+                    expired.emplace_back(PeriodicFiring<Periodic>(node.periodic));
+                }
+                node.expiry = std::max(node.expiry + node.period, current + 1);
+                link(index);
+            }
+            index = following;
+        }
+    }
+}
+
+/**
+ * @brief Próximo tick com disparo (nível 0) ou cascata (níveis acima)
+ * @return Tick, ou UINT64_MAX se não há timers
+ */
+uint64_t TimerWheel::next_event() const {
+    uint64_t best = UINT64_MAX;
+    for (size_t level = 0; level < LEVELS; ++level) {
+        // Posições ocupadas estão sempre à frente da posição do tick corrente
+        size_t digit = (current >> (SLOT_BITS * level)) & (SLOTS - 1);
+        uint64_t ahead = digit + 1 == SLOTS ? 0 : occupied[level] & (~uint64_t{0} << (digit + 1));
+        if (ahead == 0) continue;
+
+        uint64_t slot = static_cast<uint64_t>(__builtin_ctzll(ahead));
+        size_t shift = SLOT_BITS * (level + 1);
+        uint64_t tick = ((current >> shift) << shift) | (slot << (SLOT_BITS * level));
+        best = std::min(best, tick);
+    }
+    if (heads[OVERFLOW_LIST] != NIL) {
+        uint64_t span = uint64_t{1} << (SLOT_BITS * LEVELS);
+        best = std::min(best, (current / span + 1) * span);
+    }
+    return best;
+}
+
+/**
+ * @brief Converte um instante no primeiro tick não anterior a ele (arredonda para cima)
+ */
+uint64_t TimerWheel::tick_at(Clock::time_point when) const {
+    if (when <= origin) return 0;
+    auto elapsed = when - origin;
+    return static_cast<uint64_t>((elapsed + resolution - Clock::duration(1)) / resolution);
+}
+
+/**
+ * @brief Converte um instante no último tick iniciado (arredonda para baixo)
+ */
+uint64_t TimerWheel::tick_now(Clock::time_point now) const {
+    if (now <= origin) return 0;
+    return static_cast<uint64_t>((now - origin) / resolution);
+}
@@ -0,0 +1,277 @@
+#include "thread_pool/trace_recorder.h"
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+/**
+ * @brief Nome de tarefa em vigor nesta thread (TraceLabel)
+ */
+thread_local const char* current_label = nullptr;
+
+/**
+ * @brief Gerador de ids únicos de gravador (nunca reutilizados, ao contrário de endereços)
+ */
+std::atomic<uint64_t> next_identity{1};
+
+/**
+ * @struct LocalCache
+ * @brief Último buffer usado pela thread, para evitar o registro a cada evento
+ */
+struct LocalCache {
+    uint64_t recorder = 0;                      ///< Id do gravador do buffer
+    void* buffer = nullptr;                     ///< Buffer da thread nesse gravador
+};
+
+thread_local LocalCache local_cache;
+
+/**
+ * @brief Instante corrente em ns de steady_clock
+ */
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Escreve uma string JSON com escape
+ */
+void write_string(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        unsigned char ch = static_cast<unsigned char>(*c);
+        if (ch == '"' || ch == '\\') {
+            out << '\\' << *c;
+        } else if (ch < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+            out << escaped;
+        } else {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+/**
+ * @brief Escreve um instante em microssegundos relativo à origem do trace
+ */
+void write_timestamp(std::ostream& out, int64_t timestamp, int64_t origin) {
+    int64_t ns = timestamp - origin;
+    char text[32];
+    std::snprintf(text, sizeof(text), "%lld.%03lld",
+                  static_cast<long long>(ns / 1000), static_cast<long long>(ns % 1000));
+    out << text;
+}
+
+}
+
+/**
+ * @brief Passa a nomear as tarefas da thread corrente
+ * @param name Nome exibido no trace
+ */
+TraceLabel::TraceLabel(const char* name) noexcept
+    : previous(current_label) {
+    current_label = name;
+}
+
+/**
+ * @brief Restaura o nome anterior
+ */
+TraceLabel::~TraceLabel() {
+    current_label = previous;
+}
+
+/**
+ * @brief Retorna o nome em vigor na thread corrente
+ * @return Nome ou nullptr
+ */
+const char* TraceLabel::current() noexcept {
+    return current_label;
+}
+
+/**
+ * @brief Construtor do TraceRecorder (gravação desligada)
+ */
+TraceRecorder::TraceRecorder()
+    : identity(next_identity.fetch_add(1, std::memory_order_relaxed)) {}
+
+/**
+ * @brief Destrutor que libera os blocos de todas as threads
+ */
+TraceRecorder::~TraceRecorder() {
+    for (auto& buffer : buffers) {
+        Chunk* chunk = buffer->head;
+        while (chunk) {
+            Chunk* following = chunk->next.load(std::memory_order_relaxed);
+            delete chunk;
+            chunk = following;
+        }
+    }
+}
+
+/**
+ * @brief Registra a submissão e embrulha a tarefa
+ * @param task Tarefa a ser publicada
+ * @return Tarefa que registra início e fim em volta da original
+ */
+InlineTask TraceRecorder::wrap(InlineTask task) {
+    uint64_t id = next_task.fetch_add(1, std::memory_order_relaxed);
+    const char* name = current_label ? current_label : "task";
+    record(TraceEvent::Kind::Submit, id, name);
+
+    return InlineTask([this, id, name, inner = std::move(task)]() mutable {
+        // Registra o fim mesmo se a tarefa lançar
+        struct Finish {
+            TraceRecorder& recorder;
+            uint64_t id;
+            const char* name;
+            ~Finish() { recorder.record(TraceEvent::Kind::Finish, id, name); }
+        };
+        record(TraceEvent::Kind::Start, id, name);
+        Finish finish{*this, id, name};
+        inner();
+    });
+}
+
+/**
+ * @brief Registra um evento no buffer da thread corrente
+ * @param kind Momento registrado
+ * @param task Id da tarefa
+ * @param name Nome da tarefa
+ */
+void TraceRecorder::record(TraceEvent::Kind kind, uint64_t task, const char* name) {
+    ThreadBuffer& buffer = local_buffer();
+    Chunk* chunk = buffer.tail;
+    size_t used = chunk->used.load(std::memory_order_relaxed);
+    if (used == CHUNK_EVENTS) {
+        // Bloco cheio: encadeia um novo, sem mover os anteriores
+        Chunk* fresh = new Chunk();
+        chunk->next.store(fresh, std::memory_order_release);
+        buffer.tail = fresh;
+        chunk = fresh;
+        used = 0;
+    }
+
+    TraceEvent& event = chunk->events[used];
+    event.timestamp = now_ns();
+    event.task = task;
+    event.name = name;
+    event.kind = kind;
+    // Publica o evento para leitores concorrentes de write_json()
+    chunk->used.store(used + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Retorna o buffer da thread corrente
+ * @return Buffer escrito só por esta thread
+ */
+TraceRecorder::ThreadBuffer& TraceRecorder::local_buffer() {
+    if (local_cache.recorder == identity) {
+        return *static_cast<ThreadBuffer*>(local_cache.buffer);
+    }
+
+    std::lock_guard lock(registry_mutex);
+    std::thread::id self = std::this_thread::get_id();
+    ThreadBuffer* found = nullptr;
+    for (auto& buffer : buffers) {
+        if (buffer->owner == self) {
+            found = buffer.get();
+            break;
+        }
+    }
+    if (!found) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->owner = self;
+        buffer->thread_number = buffers.size() + 1;
+        buffer->head = buffer->tail = new Chunk();
+        found = buffer.get();
+        buffers.push_back(std::move(buffer));
+    }
+    local_cache.recorder = identity;
+    local_cache.buffer = found;
+    return *found;
+}
+
+/**
+ * @brief Retorna o número de eventos gravados
+ * @return Total de eventos
+ */
+size_t TraceRecorder::event_count() const {
+    std::lock_guard lock(registry_mutex);
+    size_t total = 0;
+    for (auto& buffer : buffers) {
+        for (Chunk* chunk = buffer->head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            total += chunk->used.load(std::memory_order_acquire);
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Escreve os eventos como Chrome trace JSON
+ * @param out Destino do JSON
+ */
+void TraceRecorder::write_json(std::ostream& out) const {
+    std::lock_guard lock(registry_mutex);
+
+    // Origem do trace: o evento mais antigo (timestamps pequenos no visualizador)
+    int64_t origin = INT64_MAX;
+    for (auto& buffer : buffers) {
+        Chunk* chunk = buffer->head;
+        if (chunk->used.load(std::memory_order_acquire) > 0) {
+            origin = std::min(origin, chunk->events[0].timestamp);
+        }
+    }
+    if (origin == INT64_MAX) origin = 0;
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) out << ',';
+        first = false;
+        out << '\n';
+    };
+
+    for (auto& buffer : buffers) {
+        size_t tid = buffer->thread_number;
+        separator();
+        out << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+            << ",\"name\":\"thread_name\",\"args\":{\"name\":\"thread " << tid << "\"}}";
+
+        for (Chunk* chunk = buffer->head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            size_t used = chunk->used.load(std::memory_order_acquire);
+            for (size_t i = 0; i < used; ++i) {
+                const TraceEvent& event = chunk->events[i];
+                auto common = [&](const char* phase) {
+                    separator();
+                    out << "{\"ph\":\"" << phase << "\",\"pid\":1,\"tid\":" << tid << ",\"ts\":";
+                    write_timestamp(out, event.timestamp, origin);
+                    out << ",\"name\":";
+                    write_string(out, event.name);
+                };
+
+                switch (event.kind) {
+                case TraceEvent::Kind::Submit:
+                    // Instante da submissão e início da seta até a execução
+                    common("i");
+                    out << ",\"s\":\"t\",\"cat\":\"submit\",\"args\":{\"task\":" << event.task << "}}";
+                    common("s");
+                    out << ",\"cat\":\"task\",\"id\":" << event.task << "}";
+                    break;
+                case TraceEvent::Kind::Start:
+                    common("B");
+                    out << ",\"cat\":\"task\",\"args\":{\"task\":" << event.task << "}}";
+                    common("f");
+                    out << ",\"cat\":\"task\",\"bp\":\"e\",\"id\":" << event.task << "}";
+                    break;
+                case TraceEvent::Kind::Finish:
+                    common("E");
+                    out << ",\"cat\":\"task\"}";
+                    break;
+                }
+            }
+        }
+    }
+    out << "\n]}\n";
+}
@@ -0,0 +1,76 @@
+#include "thread_pool/work_stealing_queue.h"
+
+/**
+ * @brief Adiciona tarefa no fundo da deque
+ * @param task Tarefa a ser adicionada
+ */
+void WorkStealingQueue::push(Task task) {
+    std::lock_guard lock(mutex);
+    deque.push_back(std::move(task));
+    count.store(deque.size(), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Adiciona lote no fundo da deque
+ * @param tasks Tarefas a serem adicionadas
+ */
+void WorkStealingQueue::push_bulk(std::vector<Task>& tasks) {
+    {
+        std::lock_guard lock(mutex);
+        for (auto& task : tasks) {
+            deque.push_back(std::move(task));
+        }
+        count.store(deque.size(), std::memory_order_relaxed);
+    }
+    tasks.clear();
+}
+
+/**
+ * @brief Remove tarefa do fundo da deque (LIFO)
+ * @param task Referência para armazenar a tarefa
+ * @return true se obteve tarefa, false se vazia
+ */
+bool WorkStealingQueue::pop(Task& task) {
+    if (empty()) return false;
+
+    std::lock_guard lock(mutex);
+    if (deque.empty()) return false;
+
+    task = std::move(deque.back());
+    deque.pop_back();
+    count.store(deque.size(), std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Rouba tarefa do topo da deque (FIFO)
+ * @param task Referência para armazenar a tarefa
+ * @return true se obteve tarefa, false se vazia
+ */
+bool WorkStealingQueue::steal(Task& task) {
+    if (empty()) return false;
+
+    std::lock_guard lock(mutex);
+    if (deque.empty()) return false;
+
+    task = std::move(deque.front());
+    deque.pop_front();
+    count.store(deque.size(), std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Verifica se a deque parece vazia (sem travar)
+ * @return true se vazia
+ */
+bool WorkStealingQueue::empty() const {
+    return count.load(std::memory_order_relaxed) == 0;
+}
+
+/**
+ * @brief Retorna tamanho aproximado da deque
+ * @return Número de tarefas
+ */
+size_t WorkStealingQueue::size() const {
+    return count.load(std::memory_order_relaxed);
+}
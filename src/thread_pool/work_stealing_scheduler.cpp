@@ -0,0 +1,360 @@
+#include "thread_pool/work_stealing_scheduler.h"
+#include <algorithm>
+
+namespace {
+
+// Escalonador e worker associados à thread corrente (nullptr fora do pool)
+thread_local WorkStealingScheduler* current_scheduler = nullptr;
+thread_local size_t current_index = 0;
+
+// Buffer reutilizado para lotes retirados da fila de injeção
+thread_local std::vector<TaskQueue::Task> injection_batch;
+
+// Limite de tarefas movidas da fila de injeção para a deque local de uma vez
+constexpr size_t MAX_INJECTION_BATCH = 32;
+
+}
+
+/**
+ * @brief Construtor do WorkStealingScheduler
+ * @param num_workers Número de workers
+ * @param injection_queue Fila para tarefas externas
+ */
+WorkStealingScheduler::WorkStealingScheduler(size_t num_workers, std::shared_ptr<TaskQueue> injection_queue)
+    : injection_queue(std::move(injection_queue))
+    , domains(num_workers) {
+    local_queues.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+        local_queues.emplace_back(std::make_unique<WorkStealingQueue>());
+    }
+}
+
+/**
+ * @brief Adiciona tarefa ao escalonador
+ * @param task Tarefa a ser adicionada
+ * @return true se bem-sucedido, false se parado
+ */
+bool WorkStealingScheduler::push(Task task) {
+    return push(std::move(task), TaskPriority::Normal);
+}
+
+/**
+ * @brief Adiciona tarefa com classe de prioridade
+ * @param task Tarefa a ser adicionada
+ * @param priority Classe de prioridade
+ * @return true se bem-sucedido, false se parado
+ */
+bool WorkStealingScheduler::push(Task task, TaskPriority priority) {
+    if (stop_flag.load(std::memory_order_acquire)) return false;
+
+    if (pushes_locally(priority)) {
+        // Submissão de dentro de um worker: vai para a deque local. O contador
+        // sobe antes da publicação, senão quem retirar a tarefa o decrementa
+        // primeiro e ele passa por zero
+        pending.fetch_add(1);
+        local_queues[current_index]->push(std::move(task));
+        notify();
+        return true;
+    }
+
+    reserve_injected(1);
+    if (!injection_queue->push(std::move(task), priority)) {
+        cancel_injected(1);
+        return false;
+    }
+    notify();
+    return true;
+}
+
+/**
+ * @brief Tenta adicionar tarefa sem esperar por espaço
+ * @param task Tarefa a ser adicionada
+ * @param priority Classe de prioridade
+ * @return true se adicionou, false se cheio ou parado
+ */
+bool WorkStealingScheduler::try_push(Task& task, TaskPriority priority) {
+    if (stop_flag.load(std::memory_order_acquire)) return false;
+    if (pushes_locally(priority)) return push(std::move(task), priority);
+
+    reserve_injected(1);
+    if (!injection_queue->try_push(task, priority)) {
+        cancel_injected(1);
+        return false;
+    }
+    notify();
+    return true;
+}
+
+/**
+ * @brief Adiciona tarefa esperando por espaço até o prazo
+ * @param task Tarefa a ser adicionada
+ * @param priority Classe de prioridade
+ * @param timeout Tempo máximo de espera
+ * @return true se adicionou, false se expirou ou parado
+ */
+bool WorkStealingScheduler::push_for(Task& task, TaskPriority priority, std::chrono::nanoseconds timeout) {
+    if (stop_flag.load(std::memory_order_acquire)) return false;
+    if (pushes_locally(priority)) return push(std::move(task), priority);
+
+    reserve_injected(1);
+    if (!injection_queue->push_for(task, priority, timeout)) {
+        cancel_injected(1);
+        return false;
+    }
+    notify();
+    return true;
+}
+
+/**
+ * @brief Remove da fila de injeção a tarefa mais antiga
+ * @param task Referência para armazenar a tarefa
+ * @return true se removeu
+ */
+bool WorkStealingScheduler::pop_oldest(Task& task) {
+    if (!injection_queue->pop_oldest(task)) return false;
+    injected.fetch_sub(1);
+    pending.fetch_sub(1);
+    return true;
+}
+
+/**
+ * @brief Retorna a capacidade da fila de injeção
+ * @return Capacidade (0: ilimitada)
+ */
+size_t WorkStealingScheduler::capacity() const {
+    return injection_queue->capacity();
+}
+
+/**
+ * @brief Adiciona um lote de tarefas ao escalonador
+ * @param tasks Tarefas a serem adicionadas
+ * @return true se bem-sucedido, false se parado
+ */
+bool WorkStealingScheduler::push_bulk(std::vector<Task>& tasks) {
+    if (stop_flag.load(std::memory_order_acquire)) return false;
+
+    size_t count = tasks.size();
+    if (current_scheduler == this) {
+        pending.fetch_add(count);
+        local_queues[current_index]->push_bulk(tasks);
+    } else {
+        reserve_injected(count);
+        if (!injection_queue->push_bulk(tasks)) {
+            cancel_injected(count);
+            return false;
+        }
+    }
+
+    notify(count);
+    return true;
+}
+
+/**
+ * @brief Obtém a próxima tarefa para um worker (bloqueante)
+ * @param index Índice do worker
+ * @param task Referência para armazenar a tarefa
+ * @return true se obteve tarefa, false se parado e sem tarefas
+ */
+bool WorkStealingScheduler::pop(size_t index, Task& task) {
+    while (true) {
+        if (try_acquire(index, task)) return true;
+
+        EventCount::Key key = idle.prepare_wait();
+        if (try_acquire(index, task)) {
+            idle.cancel_wait();
+            return true;
+        }
+        if (stop_flag.load() && pending.load() == 0) {
+            idle.cancel_wait();
+            return false;
+        }
+        idle.wait(key);
+    }
+}
+
+/**
+ * @brief Tenta obter tarefa sem bloquear
+ * @param index Índice do worker
+ * @param task Referência para armazenar a tarefa
+ * @return true se obteve tarefa
+ */
+bool WorkStealingScheduler::try_pop(size_t index, Task& task) {
+    return try_acquire(index, task);
+}
+
+/**
+ * @brief Ponto de espera dos workers ociosos
+ * @return EventCount do escalonador
+ */
+EventCount& WorkStealingScheduler::idle_event() {
+    return idle;
+}
+
+/**
+ * @brief Associa a thread corrente a um worker
+ * @param index Índice do worker
+ */
+void WorkStealingScheduler::bind(size_t index) {
+    current_scheduler = this;
+    current_index = index;
+}
+
+/**
+ * @brief Define o domínio de LLC de um worker
+ * @param index Índice do worker
+ * @param domain Domínio de LLC
+ */
+void WorkStealingScheduler::set_domain(size_t index, size_t domain) {
+    domains[index].store(domain, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Para o escalonador e acorda todos os workers
+ */
+void WorkStealingScheduler::stop() {
+    stop_flag.store(true, std::memory_order_release);
+    injection_queue->stop();
+    idle.notify_all();
+}
+
+/**
+ * @brief Verifica se o escalonador está parado
+ * @return true se parado
+ */
+bool WorkStealingScheduler::stopped() const {
+    return stop_flag.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Retorna o número de tarefas pendentes
+ * @return Número de tarefas
+ */
+size_t WorkStealingScheduler::size() const {
+    return pending.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Retorna o número de tarefas pendentes de uma prioridade
+ * @param priority Classe de prioridade
+ * @return Número de tarefas
+ */
+size_t WorkStealingScheduler::size(TaskPriority priority) const {
+    size_t queued = injection_queue->size(priority);
+    if (priority == TaskPriority::Normal) {
+        // Deques locais só recebem tarefas Normal
+        size_t total = pending.load(std::memory_order_relaxed);
+        size_t external = injected.load(std::memory_order_relaxed);
+        queued += total > external ? total - external : 0;
+    }
+    return queued;
+}
+
+/**
+ * @brief Verifica se a tarefa vai para a deque local da thread corrente
+ */
+bool WorkStealingScheduler::pushes_locally(TaskPriority priority) const {
+    return current_scheduler == this && priority == TaskPriority::Normal;
+}
+
+/**
+ * @brief Contabiliza tarefas antes de publicá-las na fila de injeção
+ *
+ * Um worker pode retirar a tarefa assim que ela é publicada; se os
+ * contadores subissem depois, o decremento dele viria antes e os levaria
+ * abaixo de zero (perto de SIZE_MAX) até o incremento chegar.
+ */
+void WorkStealingScheduler::reserve_injected(size_t count) {
+    injected.fetch_add(count);
+    pending.fetch_add(count);
+}
+
+/**
+ * @brief Desfaz reserve_injected quando a fila de injeção recusou as tarefas
+ */
+void WorkStealingScheduler::cancel_injected(size_t count) {
+    injected.fetch_sub(count);
+    pending.fetch_sub(count);
+    // Um worker que viu a reserva pode ter ido dormir esperando por ela em
+    // vez de sair; acorda todos para reavaliarem a parada
+    if (stop_flag.load(std::memory_order_acquire)) idle.notify_all();
+}
+
+/**
+ * @brief Tenta obter tarefa: deque local, fila de injeção e roubo
+ */
+bool WorkStealingScheduler::try_acquire(size_t index, Task& task) {
+    // Tarefas High na fila de injeção passam à frente do trabalho local
+    bool urgent = injection_queue->size(TaskPriority::High) > 0;
+    if ((urgent && try_acquire_injected(index, task)) ||
+        local_queues[index]->pop(task) ||
+        try_acquire_injected(index, task) ||
+        try_steal(index, task)) {
+        pending.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Retira um lote da fila de injeção, mantendo o excedente na deque local
+ */
+bool WorkStealingScheduler::try_acquire_injected(size_t index, Task& task) {
+    size_t available = injected.load(std::memory_order_relaxed);
+    if (available == 0) return false;
+
+    // Divide a fila de injeção entre os workers para não esvaziá-la sozinho
+    size_t batch = std::clamp<size_t>(available / local_queues.size(), 1, MAX_INJECTION_BATCH);
+
+    injection_batch.clear();
+    size_t taken = injection_queue->try_pop_bulk(injection_batch, batch);
+    if (taken == 0) return false;
+    injected.fetch_sub(taken);
+
+    // O lote sai da fila em ordem de prioridade; empilha ao contrário para
+    // que o pop LIFO do dono preserve essa ordem
+    task = std::move(injection_batch.front());
+    for (size_t i = taken - 1; i >= 1; --i) {
+        local_queues[index]->push(std::move(injection_batch[i]));
+    }
+    injection_batch.clear();
+
+    // O excedente agora está em uma deque local e pode ser roubado
+    if (taken > 1) notify();
+    return true;
+}
+
+/**
+ * @brief Rouba tarefa de outro worker: primeiro do mesmo domínio de LLC,
+ *        depois dos demais, começando pelo vizinho seguinte
+ */
+bool WorkStealingScheduler::try_steal(size_t index, Task& task) {
+    size_t n = local_queues.size();
+    size_t home = domains[index].load(std::memory_order_relaxed);
+    for (size_t i = 1; i < n; ++i) {
+        size_t victim = (index + i) % n;
+        if (domains[victim].load(std::memory_order_relaxed) == home &&
+            local_queues[victim]->steal(task)) return true;
+    }
+    for (size_t i = 1; i < n; ++i) {
+        size_t victim = (index + i) % n;
+        if (domains[victim].load(std::memory_order_relaxed) != home &&
+            local_queues[victim]->steal(task)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Acorda um worker adormecido, se houver algum
+ */
+void WorkStealingScheduler::notify() {
+    notify(1);
+}
+
+/**
+ * @brief Acorda até count workers adormecidos
+ * @param count Número de tarefas que precisam de worker
+ */
+void WorkStealingScheduler::notify(size_t count) {
+    // Sem worker dormindo, não há chamada de sistema
+    idle.notify(count);
+}
@@ -0,0 +1,29 @@
+#include "thread_pool/worker_metrics.h"
+
+/**
+ * @brief Lê os contadores sem bloquear o escritor
+ * @param index Índice reportado no retrato
+ * @return Retrato dos contadores
+ */
+WorkerStats WorkerMetrics::snapshot(size_t index) const {
+    WorkerStats result;
+    result.index = index;
+    result.tasks_executed = tasks.load(std::memory_order_relaxed);
+    result.busy_time = std::chrono::nanoseconds(busy.load(std::memory_order_relaxed));
+    result.idle_time = std::chrono::nanoseconds(idle.load(std::memory_order_relaxed));
+    read(wait_buckets, wait_total, result.queue_wait);
+    read(run_buckets, run_total, result.run_time);
+    return result;
+}
+
+/**
+ * @brief Copia um histograma vivo para o retrato
+ */
+void WorkerMetrics::read(const Buckets& buckets, const std::atomic<uint64_t>& total, LatencyHistogram& out) {
+    // A contagem vem dos próprios baldes, então é coerente com eles
+    for (size_t bucket = 0; bucket < LatencyHistogram::BUCKETS; ++bucket) {
+        out.buckets[bucket] = buckets[bucket].load(std::memory_order_relaxed);
+        out.count += out.buckets[bucket];
+    }
+    out.total = std::chrono::nanoseconds(total.load(std::memory_order_relaxed));
+}
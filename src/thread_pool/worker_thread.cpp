@@ -1,12 +1,70 @@
 #include "thread_pool/worker_thread.h"
 #include <iostream>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Dica de espera ativa para o processador (reduz consumo e contenção)
+ */
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief Worker cuja thread é a corrente (nullptr fora do pool)
+ */
+thread_local WorkerThread* current_worker = nullptr;
+
+}
 
 /**
  * @brief Construtor do WorkerThread
  * @param task_queue Fila compartilhada de tarefas
+ * @param idle EventCount notificado pelos produtores
+ * @param strategy Estratégia de espera
+ * @param retirement Política de aposentadoria
+ * @param timed Mede os tempos de cada tarefa
  */
-WorkerThread::WorkerThread(std::shared_ptr<TaskQueue> task_queue)
+WorkerThread::WorkerThread(std::shared_ptr<TaskQueue> task_queue,
+                           std::shared_ptr<EventCount> idle,
+                           WaitStrategy strategy,
+                           WorkerRetirement retirement,
+                           bool timed)
     : task_queue(std::move(task_queue))
+    , idle(std::move(idle))
+    , strategy(strategy)
+    , retirement(std::move(retirement))
+    , timed(timed)
+    , index(0)
+    , running(true) {
+
+    // Inicia a thread com o loop de execução
+    thread = std::thread(&WorkerThread::run, this);
+}
+
+/**
+ * @brief Construtor do WorkerThread em modo work-stealing
+ * @param scheduler Escalonador com as deques locais
+ * @param index Índice da deque local deste worker
+ * @param strategy Estratégia de espera
+ * @param retirement Política de aposentadoria
+ * @param timed Mede os tempos de cada tarefa
+ */
+WorkerThread::WorkerThread(std::shared_ptr<WorkStealingScheduler> scheduler, size_t index,
+                           WaitStrategy strategy, WorkerRetirement retirement, bool timed)
+    : scheduler(std::move(scheduler))
+    , strategy(strategy)
+    , retirement(std::move(retirement))
+    , timed(timed)
+    , index(index)
     , running(true) {
 
     // Inicia a thread com o loop de execução
@@ -25,21 +83,157 @@ WorkerThread::~WorkerThread() {
  * @brief Loop principal da thread worker
  */
 void WorkerThread::run() {
+    if (scheduler) {
+        scheduler->bind(index);
+    }
+
+    current_worker = this;
+
+    int64_t idle_since = timed ? WorkerMetrics::now() : 0;
     while (running) {
         TaskQueue::Task task;
 
         // Tenta obter tarefa da fila
-        if (task_queue->pop(task)) {
-            try {
-                task();  // Executa a tarefa
-            } catch (const std::exception& e) {
-                std::cerr << "Exceção em WorkerThread: " << e.what() << std::endl;
-            }
+        if (next_task(task)) {
+            run_task(task, idle_since);
         } else {
-            // Fila parada e vazia, sai do loop
+            // Fila parada e vazia (ou worker aposentado), sai do loop
             break;
         }
     }
+    current_worker = nullptr;
+    done.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief Executa uma tarefa e registra seus tempos
+ * @param task Tarefa obtida da fonte
+ * @param idle_since Início da ociosidade anterior
+ */
+void WorkerThread::run_task(TaskQueue::Task& task, int64_t& idle_since) {
+    int64_t start = timed ? WorkerMetrics::now() : 0;
+    int64_t enqueued = task.enqueued();
+    try {
+        task();  // Executa a tarefa
+    } catch (const std::exception& e) {
+        std::cerr << "Exceção em WorkerThread: " << e.what() << std::endl;
+    }
+
+    if (timed) {
+        int64_t end = WorkerMetrics::now();
+        metrics.record_task(start - idle_since, enqueued ? start - enqueued : -1, end - start);
+        idle_since = end;
+    } else {
+        metrics.count_task();
+    }
+}
+
+/**
+ * @brief Retorna o worker da thread corrente
+ * @return Worker, ou nullptr fora de qualquer pool
+ */
+WorkerThread* WorkerThread::current() noexcept {
+    return current_worker;
+}
+
+/**
+ * @brief Executa uma tarefa pendente dentro da espera de outra
+ * @return true se executou uma tarefa
+ */
+bool WorkerThread::run_one() {
+    TaskQueue::Task task;
+    if (!try_next_task(task)) return false;
+
+    // A tarefa aninhada não conta ociosidade: o worker estava ocupado esperando
+    int64_t idle_since = timed ? WorkerMetrics::now() : 0;
+    run_task(task, idle_since);
+    return true;
+}
+
+/**
+ * @brief Obtém a próxima tarefa: gira, cede a vez e por fim dorme
+ * @param task Referência para armazenar a tarefa
+ * @return true se obteve tarefa, false se parado e vazio
+ */
+bool WorkerThread::next_task(TaskQueue::Task& task) {
+    EventCount* event = scheduler ? &scheduler->idle_event() : idle.get();
+    if (!event) {
+        return task_queue->pop(task);
+    }
+
+    if (try_next_task(task)) return true;
+
+    // Fase de espera ativa: só toca a fila quando a leitura sem lock indica trabalho
+    for (size_t i = 0; i < strategy.spin_iterations; ++i) {
+        if (has_pending() && try_next_task(task)) return true;
+        if (source_stopped()) break;
+        cpu_relax();
+    }
+    for (size_t i = 0; i < strategy.yield_iterations; ++i) {
+        if (has_pending() && try_next_task(task)) return true;
+        if (source_stopped()) break;
+        std::this_thread::yield();
+    }
+
+    while (true) {
+        EventCount::Key key = event->prepare_wait();
+        // Verifica de novo depois de anunciar a espera: um produtor que não
+        // viu o anúncio publicou antes desta leitura
+        if (try_next_task(task)) {
+            event->cancel_wait();
+            return true;
+        }
+        if (source_stopped()) {
+            event->cancel_wait();
+            return try_next_task(task);
+        }
+        if (retirement.idle_timeout.count() > 0) {
+            if (!event->wait_for(key, retirement.idle_timeout)) {
+                // Prazo expirou: verifica a fila antes de pedir para sair
+                if (try_next_task(task)) return true;
+                if (!source_stopped() && retirement.may_retire && retirement.may_retire()) {
+                    return false;
+                }
+            }
+        } else {
+            event->wait(key);
+        }
+        if (try_next_task(task)) return true;
+    }
+}
+
+/**
+ * @brief Tenta obter tarefa sem bloquear
+ * @param task Referência para armazenar a tarefa
+ * @return true se obteve tarefa
+ */
+bool WorkerThread::try_next_task(TaskQueue::Task& task) {
+    if (scheduler) {
+        return scheduler->try_pop(index, task);
+    }
+    return task_queue->try_pop(task);
+}
+
+/**
+ * @brief Verifica, sem travar, se há tarefas pendentes
+ * @return true se há tarefas
+ */
+bool WorkerThread::has_pending() const {
+    if (scheduler) {
+        return scheduler->size() > 0;
+    }
+    return task_queue->size() > 0;
+}
+
+/**
+ * @brief Verifica se a fonte de tarefas foi parada
+ * @return true se parada
+ */
+bool WorkerThread::source_stopped() const {
+    if (scheduler) {
+        return scheduler->stopped();
+    }
+    return task_queue->stopped();
 }
 
 /**
@@ -49,6 +243,48 @@ void WorkerThread::stop() {
     running = false;
 }
 
+/**
+ * @brief Verifica se o loop do worker terminou
+ * @return true se terminou
+ */
+bool WorkerThread::finished() const {
+    return done.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Retorna o índice da deque local
+ * @return Índice do worker
+ */
+size_t WorkerThread::worker_index() const {
+    return index;
+}
+
+/**
+ * @brief Lê os contadores do worker
+ * @return Retrato dos contadores
+ */
+WorkerStats WorkerThread::stats() const {
+    return metrics.snapshot(index);
+}
+
+/**
+ * @brief Fixa a thread do worker em uma CPU
+ * @param cpu CPU lógica
+ * @return true se aplicado
+ */
+bool WorkerThread::pin_to_cpu(int cpu) {
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE || !thread.joinable()) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
 /**
  * @brief Junta a thread (espera término)
  */
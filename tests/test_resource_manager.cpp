@@ -2,6 +2,7 @@
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <algorithm>
 #include "../include/resource_manager/resource_manager.h"
 
 /**
@@ -141,6 +142,390 @@ TEST_F(ResourceManagerTest, ConcorrenciaIntensa) {
     EXPECT_EQ(*final_lock, successful_writes.load());
 }
 
+/**
+ * @brief Testa o mapa dividido em shards: chaves em todos os shards e size() coerente
+ */
+TEST(ShardedResourceManagerTest, ShardsMantemSizeEContains) {
+    using Manager = ResourceManager<int, int>;
+    Manager sharded(Manager::DEFAULT_SHARDS);
+    EXPECT_EQ(sharded.shard_count(), Manager::DEFAULT_SHARDS);
+    EXPECT_EQ(Manager(5).shard_count(), 8u);
+
+    const int NUM_KEYS = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int key = t; key < NUM_KEYS; key += 4) {
+                sharded.add_resource(key, std::make_shared<int>(key));
+            }
+        });
+    }
+
+    // Inserções só crescem o mapa: cada leitura de size() é um instante consistente
+    size_t previous = 0;
+    while (previous < static_cast<size_t>(NUM_KEYS)) {
+        size_t current = sharded.size();
+        EXPECT_GE(current, previous);
+        previous = current;
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    for (int key = 0; key < NUM_KEYS; ++key) {
+        ASSERT_TRUE(sharded.contains(key));
+        EXPECT_EQ(*sharded.get_read_access(key), key);
+    }
+    EXPECT_FALSE(sharded.contains(NUM_KEYS));
+    EXPECT_THROW(sharded.get_read_access(NUM_KEYS), std::runtime_error);
+
+    for (int key = 0; key < NUM_KEYS; key += 2) {
+        sharded.remove_resource(key);
+    }
+    EXPECT_EQ(sharded.size(), static_cast<size_t>(NUM_KEYS / 2));
+    EXPECT_FALSE(sharded.contains(0));
+    EXPECT_TRUE(sharded.contains(1));
+}
+
+/**
+ * @brief Testa que um lock ativo mantém o recurso vivo após a remoção
+ */
+TEST(ShardedResourceManagerTest, LockSobreviveRemocao) {
+    ResourceManager<int, int> sharded(16);
+    sharded.add_resource(7, std::make_shared<int>(1));
+
+    auto write_lock = sharded.get_write_access(7);
+    std::thread remover([&]() { sharded.remove_resource(7); });
+    remover.join();  // A remoção não espera o lock do recurso
+
+    EXPECT_FALSE(sharded.contains(7));
+    *write_lock = 2;
+    EXPECT_EQ(*write_lock, 2);
+
+    try {
+        sharded.get_read_access(7);
+        FAIL() << "Esperava std::runtime_error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("7"), std::string::npos);
+    }
+}
+
+/**
+ * @brief Testa que o EpochDomain só apaga objetos retirados depois que os leitores saem
+ */
+TEST(EpochTest, LiberacaoEsperaLeitores) {
+    struct Tracked {
+        std::atomic<int>* destroyed;
+        ~Tracked() { destroyed->fetch_add(1); }
+    };
+    std::atomic<int> destroyed{0};
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+
+    std::thread reader([&]() {
+        EpochGuard guard;
+        pinned = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    while (!pinned) {
+        std::this_thread::yield();
+    }
+
+    EpochDomain::instance().retire(new Tracked{&destroyed});
+    for (int i = 0; i < 4; ++i) {
+        EpochDomain::instance().collect();
+    }
+    EXPECT_EQ(destroyed.load(), 0);  // Leitor ativo desde antes da retirada
+
+    release = true;
+    reader.join();
+    EpochDomain::instance().collect();
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+/**
+ * @brief Testa buscas sem lock concorrentes com inserções e remoções
+ */
+TEST(EpochTest, BuscasConcorrentesComRemocao) {
+    ResourceManager<int, int> manager;
+    const int STABLE_KEYS = 64;
+    for (int key = 0; key < STABLE_KEYS; ++key) {
+        manager.add_resource(key, std::make_shared<int>(key));
+    }
+
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        // Chaves voláteis forçam crescimento da tabela, substituições e remoções
+        for (int round = 0; round < 20; ++round) {
+            for (int key = STABLE_KEYS; key < STABLE_KEYS + 200; ++key) {
+                manager.add_resource(key, std::make_shared<int>(key));
+            }
+            manager.add_resource(0, std::make_shared<int>(0));
+            for (int key = STABLE_KEYS; key < STABLE_KEYS + 200; ++key) {
+                manager.remove_resource(key);
+            }
+        }
+        done = true;
+    });
+
+    std::vector<std::thread> readers;
+    std::atomic<int> failures{0};
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                for (int key = 0; key < STABLE_KEYS + 200; key += 7) {
+                    if (key < STABLE_KEYS) {
+                        if (*manager.get_read_access(key) != key) failures++;
+                    } else if (manager.contains(key)) {
+                        try {
+                            if (*manager.get_read_access(key) != key) failures++;
+                        } catch (const std::runtime_error&) {
+                            // Removida entre contains e a busca
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(manager.size(), static_cast<size_t>(STABLE_KEYS));
+}
+
+/**
+ * @brief Testa destrutor de recurso que altera o gerenciador durante o crescimento
+ *
+ * A tabela antiga é retirada no crescimento, e a coleta pode apagar um nó
+ * removido antes; o destrutor do recurso dele adiciona outra chave ao
+ * mesmo shard, o que travaria se a retirada acontecesse com o mutex seguro.
+ */
+TEST(EpochTest, DestrutorReentranteNoCrescimento) {
+    struct Reentrante {
+        ResourceManager<int, Reentrante>* manager;
+        int key;
+        Reentrante(ResourceManager<int, Reentrante>* manager, int key) : manager(manager), key(key) {}
+        ~Reentrante() {
+            if (manager) manager->add_resource(key, std::make_shared<Reentrante>(nullptr, 0));
+        }
+    };
+    ResourceManager<int, Reentrante> manager;
+    manager.add_resource(-1, std::make_shared<Reentrante>(&manager, 1000));
+
+    // Um leitor ativo segura o nó removido até o crescimento coletá-lo
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+    std::thread reader([&]() {
+        EpochGuard guard;
+        pinned = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    while (!pinned) {
+        std::this_thread::yield();
+    }
+    manager.remove_resource(-1);
+    release = true;
+    reader.join();
+
+    // Inserções sem substituição não coletam; a que dobra a tabela coleta
+    for (int key = 0; key < 64; ++key) {
+        manager.add_resource(key, std::make_shared<Reentrante>(nullptr, 0));
+    }
+    EpochDomain::instance().collect();
+    EXPECT_TRUE(manager.contains(1000));
+    EXPECT_EQ(manager.size(), 65u);
+}
+
+/**
+ * @brief Testa que a leitura otimista vê as escritas concluídas
+ */
+TEST(OptimisticReadTest, LeituraVeEscritasConcluidas) {
+    ResourceManager<std::string, int> manager;
+    manager.add_resource("contador", std::make_shared<int>(5));
+    EXPECT_EQ(manager.optimistic_read("contador"), 5);
+
+    {
+        auto write_lock = manager.get_write_access("contador");
+        *write_lock = 6;
+        auto moved = std::move(write_lock);  // A versão só é publicada uma vez
+        *moved = 7;
+    }
+    EXPECT_EQ(manager.optimistic_read("contador"), 7);
+    EXPECT_THROW(manager.optimistic_read("inexistente"), std::runtime_error);
+}
+
+/**
+ * @brief Testa que leituras otimistas nunca retornam um valor rasgado
+ */
+TEST(OptimisticReadTest, SemLeiturasRasgadas) {
+    struct Pair {
+        long first;
+        long second;
+        long sum;
+    };
+    SharedResource<Pair> shared(std::make_shared<Pair>(Pair{0, 0, 0}));
+
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (long i = 1; i <= 20000; ++i) {
+            auto write_lock = shared.lock_write();
+            write_lock->first = i;
+            write_lock->second = 2 * i;
+            write_lock->sum = 3 * i;
+        }
+        done = true;
+    });
+
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&]() {
+            long last = 0;
+            while (!done) {
+                Pair copy = shared.optimistic_read();
+                if (copy.second != 2 * copy.first || copy.sum != 3 * copy.first) torn++;
+                if (copy.first < last) torn++;  // Versões nunca retrocedem
+                last = copy.first;
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(shared.optimistic_read().first, 20000);
+}
+
+/**
+ * @brief Testa versões imutáveis: escritas não alteram snapshots já obtidos
+ */
+TEST(CopyOnWriteTest, SnapshotsImutaveis) {
+    ResourceManager<std::string, std::vector<int>> manager;
+    manager.add_resource("rotas", std::make_shared<std::vector<int>>(std::vector<int>{1, 2, 3}),
+                         AccessMode::CopyOnWrite);
+
+    auto before = manager.get_snapshot("rotas");
+    std::weak_ptr<const std::vector<int>> old_version = before;
+    {
+        auto write_lock = manager.get_write_access("rotas");
+        write_lock->push_back(4);
+        EXPECT_EQ(before->size(), 3u);  // Escritor altera uma cópia privada
+    }
+
+    auto after = manager.get_snapshot("rotas");
+    EXPECT_EQ(after->size(), 4u);
+    EXPECT_EQ(before->size(), 3u);
+    EXPECT_EQ(manager.get_read_access("rotas")->size(), 4u);
+
+    // A versão antiga é liberada quando o último leitor a solta
+    before.reset();
+    EpochDomain::instance().collect();
+    EpochDomain::instance().collect();
+    EXPECT_TRUE(old_version.expired());
+
+    // Recursos Locked também oferecem snapshot (cópia com lock de leitura)
+    manager.add_resource("fila", std::make_shared<std::vector<int>>(std::vector<int>{7}));
+    EXPECT_EQ(*manager.get_snapshot("fila"), std::vector<int>{7});
+}
+
+/**
+ * @brief Testa que leitores não esperam um escritor demorado
+ */
+TEST(CopyOnWriteTest, LeitoresNaoEsperamEscritor) {
+    ResourceManager<int, std::vector<int>> manager;
+    manager.add_resource(1, std::make_shared<std::vector<int>>(100, 1), AccessMode::CopyOnWrite);
+
+    std::atomic<bool> writing{false};
+    std::atomic<bool> finish{false};
+    std::thread writer([&]() {
+        auto write_lock = manager.get_write_access(1);
+        std::fill(write_lock->begin(), write_lock->end(), 2);
+        writing = true;
+        while (!finish) {
+            std::this_thread::yield();  // Reconstrução demorada
+        }
+    });
+    while (!writing) {
+        std::this_thread::yield();
+    }
+
+    // Com o escritor ativo, leituras retornam a versão anterior sem bloquear
+    for (int i = 0; i < 100; ++i) {
+        auto snapshot = manager.get_snapshot(1);
+        auto read_lock = manager.get_read_access(1);
+        EXPECT_EQ((*snapshot)[0], 1);
+        EXPECT_EQ((*read_lock)[99], 1);
+    }
+
+    finish = true;
+    writer.join();
+    auto snapshot = manager.get_snapshot(1);
+    EXPECT_EQ(std::count(snapshot->begin(), snapshot->end(), 2), 100);
+}
+
+/**
+ * @brief Testa transferências em ordens opostas com lock_many (sem deadlock)
+ */
+TEST(LockManyTest, TransferenciasSemDeadlock) {
+    ResourceManager<std::string, int> accounts(4);
+    accounts.add_resource("a", std::make_shared<int>(1000));
+    accounts.add_resource("b", std::make_shared<int>(1000));
+    accounts.add_resource("c", std::make_shared<int>(1000));
+
+    const std::vector<std::vector<std::string>> routes = {{"a", "b"}, {"b", "a"}, {"c", "a"}, {"b", "c"}};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < routes.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 2000; ++i) {
+                auto batch = accounts.lock_many(routes[t], {LockMode::Write, LockMode::Write});
+                batch[0] -= 1;
+                batch[1] += 1;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    auto total = accounts.lock_many({"a", "b", "c"}, {LockMode::Read, LockMode::Read, LockMode::Read});
+    EXPECT_EQ(total.size(), 3u);
+    EXPECT_EQ(total[0] + total[1] + total[2], 3000);
+    EXPECT_EQ(total[0], 3000);   // Recebe de b e de c, envia para b
+    EXPECT_EQ(total[1], -1000);  // Recebe de a, envia para a e para c
+    EXPECT_EQ(total[2], 1000);
+}
+
+/**
+ * @brief Testa modos mistos, chaves repetidas e falhas sem locks pendentes
+ */
+TEST_F(ResourceManagerTest, LockManyModosMistos) {
+    {
+        auto batch = manager.lock_many({"config", "data", "config"},
+                                       {LockMode::Read, LockMode::Write, LockMode::Write});
+        EXPECT_EQ(&batch[0], &batch[2]);  // Chave repetida: um único lock de escrita
+        batch[1] = batch[0] + 1;
+    }
+    EXPECT_EQ(*manager.get_read_access("data"), 101);
+
+    EXPECT_THROW(manager.lock_many({"data", "inexistente"}, {LockMode::Write, LockMode::Write}),
+                 std::runtime_error);
+    EXPECT_THROW(manager.lock_many({"data"}, {}), std::invalid_argument);
+
+    // Nenhuma falha deixou lock preso
+    std::thread writer([&]() { *manager.get_write_access("data") = 5; });
+    writer.join();
+    EXPECT_EQ(*manager.get_read_access("data"), 5);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -1,6 +1,24 @@
 #include <gtest/gtest.h>
 #include <atomic>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
 #include "../include/thread_pool/thread_pool.h"
+#include "../include/thread_pool/ring_buffer_task_queue.h"
+#include "../include/thread_pool/cpu_topology.h"
+#include "../include/thread_pool/task_graph.h"
+#include "../include/thread_pool/timer_wheel.h"
+#include "../include/thread_pool/async_task.h"
+#include "../include/thread_pool/parallel_algorithms.h"
+#include "../include/thread_pool/strand.h"
+#include "../include/thread_pool/basic_thread_pool.h"
 
 /**
  * @brief Testes unitários para ThreadPool
@@ -92,6 +110,1515 @@ TEST(ThreadPoolSingleThreadTest, PoolSingleThread) {
     EXPECT_EQ(counter.load(), 45);
 }
 
+/**
+ * @brief Fixture para o pool em modo work-stealing
+ */
+class WorkStealingPoolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        pool = std::make_unique<ThreadPool>(ThreadPoolOptions{4, SchedulerMode::WorkStealing});
+    }
+
+    void TearDown() override {
+        pool.reset();
+    }
+
+    std::unique_ptr<ThreadPool> pool;
+};
+
+/**
+ * @brief Testa execução e retorno de valores em modo work-stealing
+ */
+TEST_F(WorkStealingPoolTest, ExecucaoERetorno) {
+    EXPECT_EQ(pool->scheduler_mode(), SchedulerMode::WorkStealing);
+    EXPECT_EQ(pool->size(), 4u);
+
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 1000; ++i) {
+        futures.push_back(pool->submit([](int x) { return x * 2; }, i));
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(futures[i].get(), i * 2);
+    }
+
+    auto failing = pool->submit([]() -> int { throw std::runtime_error("Erro simulado"); });
+    EXPECT_THROW(failing.get(), std::runtime_error);
+}
+
+/**
+ * @brief Testa tarefas submetidas de dentro de workers (deque local e roubo)
+ */
+TEST_F(WorkStealingPoolTest, SubmissaoAninhada) {
+    std::atomic<int> counter{0};
+    const int NUM_OUTER = 20;
+    const int NUM_INNER = 50;
+
+    std::vector<std::future<std::vector<std::future<void>>>> outer;
+    for (int i = 0; i < NUM_OUTER; ++i) {
+        outer.push_back(pool->submit([this, &counter]() {
+            // Filhas vão para a deque local deste worker e podem ser roubadas
+            std::vector<std::future<void>> inner;
+            for (int j = 0; j < NUM_INNER; ++j) {
+                inner.push_back(pool->submit([&counter]() { counter++; }));
+            }
+            return inner;
+        }));
+    }
+
+    for (auto& future : outer) {
+        for (auto& inner : future.get()) {
+            inner.wait();
+        }
+    }
+
+    EXPECT_EQ(counter.load(), NUM_OUTER * NUM_INNER);
+}
+
+/**
+ * @brief Testa que a profundidade de fila nunca passa do que foi submetido
+ *
+ * Um worker pode retirar a tarefa logo que ela é publicada; se o contador
+ * de pendentes subisse só depois, ele passaria por zero e a profundidade
+ * apareceria perto de SIZE_MAX.
+ */
+TEST_F(WorkStealingPoolTest, ProfundidadeNuncaPassaDoSubmetido) {
+    const size_t NUM_TASKS = 20000;
+    std::atomic<bool> done{false};
+    std::atomic<size_t> executed{0};
+    size_t max_depth = 0;
+
+    std::thread sampler([&]() {
+        while (!done.load()) {
+            max_depth = std::max(max_depth, pool->stats().queued_tasks);
+        }
+    });
+
+    // Tarefas avulsas e lotes, os dois caminhos de publicação na fila de injeção
+    std::vector<int> values(4);
+    for (size_t i = 0; i < NUM_TASKS; ++i) {
+        pool->execute([&executed]() { executed++; });
+        if (i % 64 == 0) {
+            pool->submit_bulk(values, [](int& value) { value++; }).wait();
+        }
+    }
+    while (executed.load() < NUM_TASKS) {
+        std::this_thread::yield();
+    }
+    done.store(true);
+    sampler.join();
+
+    EXPECT_LE(max_depth, NUM_TASKS);
+    EXPECT_EQ(pool->stats().queued_tasks, 0u);
+}
+
+/**
+ * @brief Testa o contrato básico da fila em anel
+ */
+TEST(RingBufferTaskQueueTest, ContratoBasico) {
+    RingBufferTaskQueue queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);  // Arredondada para potência de dois
+
+    TaskQueue::Task task;
+    EXPECT_FALSE(queue.try_pop(task));
+
+    int counter = 0;
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(queue.push([&counter]() { counter++; }));
+    }
+    EXPECT_EQ(queue.size(), 8u);
+
+    // Anel cheio: try_push falha sem consumir a tarefa
+    TaskQueue::Task extra = [&counter]() { counter += 100; };
+    EXPECT_FALSE(queue.try_push(extra));
+    EXPECT_TRUE(static_cast<bool>(extra));
+
+    // Após parar, tarefas restantes ainda são drenadas
+    queue.stop();
+    EXPECT_FALSE(queue.push([]() {}));
+    while (queue.pop(task)) {
+        task();
+    }
+    EXPECT_EQ(counter, 8);
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+/**
+ * @brief Testa o pool com backend em anel pequeno (produtor bloqueia quando cheio)
+ */
+TEST(RingBufferTaskQueueTest, PoolComAnelPequeno) {
+    ThreadPoolOptions options;
+    options.num_threads = 4;
+    options.queue_backend = QueueBackend::RingBuffer;
+    options.queue_capacity = 8;
+
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        options.scheduler = mode;
+        ThreadPool ring_pool(options);
+
+        std::vector<std::future<int>> futures;
+        for (int i = 0; i < 2000; ++i) {
+            futures.push_back(ring_pool.submit([i]() { return i; }));
+        }
+
+        long sum = 0;
+        for (auto& future : futures) {
+            sum += future.get();
+        }
+        EXPECT_EQ(sum, 2000L * 1999 / 2);
+    }
+}
+
+/**
+ * @brief Testa armazenamento inline e fallback para heap da InlineTask
+ */
+TEST(InlineTaskTest, ArmazenamentoInlineEHeap) {
+    int counter = 0;
+    auto small = [&counter]() { counter += 1; };
+    struct Large { char data[128]; int* target; void operator()() { *target += 10; } };
+
+    EXPECT_TRUE(InlineTask::fits_inline<decltype(small)>());
+    EXPECT_FALSE(InlineTask::fits_inline<Large>());
+    EXPECT_EQ(sizeof(InlineTask), 64u);
+
+    InlineTask first(small);
+    InlineTask second(Large{{}, &counter});
+    InlineTask moved = std::move(second);
+    EXPECT_FALSE(static_cast<bool>(second));
+
+    first();
+    moved();
+    EXPECT_EQ(counter, 11);
+
+    moved = nullptr;
+    EXPECT_FALSE(static_cast<bool>(moved));
+    EXPECT_THROW(moved(), std::bad_function_call);
+}
+
+/**
+ * @brief Testa submissão de callables move-only (inviável com std::function)
+ */
+TEST_F(ThreadPoolTest, CallableMoveOnly) {
+    auto value = std::make_unique<int>(21);
+    auto future = pool->submit([value = std::move(value)]() { return *value * 2; });
+    EXPECT_EQ(future.get(), 42);
+}
+
+/**
+ * @brief Testa parallel_for e submit_bulk em ambos os modos de escalonamento
+ */
+TEST(BulkSubmissionTest, ParallelForESubmitBulk) {
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        ThreadPool bulk_pool(ThreadPoolOptions{4, mode});
+
+        const size_t N = 100000;
+        std::vector<std::atomic<int>> hits(N);
+        bulk_pool.parallel_for(0, N, 64, [&hits](size_t i) { hits[i]++; }).get();
+        for (size_t i = 0; i < N; ++i) {
+            ASSERT_EQ(hits[i].load(), 1) << "índice " << i;
+        }
+
+        std::vector<int> values(10000, 1);
+        bulk_pool.submit_bulk(values, [](int& value) { value *= 3; }).get();
+        EXPECT_EQ(std::count(values.begin(), values.end(), 3), 10000);
+
+        // Intervalo vazio retorna handle já concluído
+        EXPECT_TRUE(bulk_pool.parallel_for(10, 10, 1, [](int) {}).ready());
+    }
+}
+
+/**
+ * @brief Testa propagação da primeira exceção de um lote
+ */
+TEST_F(ThreadPoolTest, ParallelForExcecao) {
+    auto handle = pool->parallel_for(0, 1000, 1, [](int i) {
+        if (i == 500) throw std::runtime_error("Erro no lote");
+    });
+    EXPECT_THROW(handle.get(), std::runtime_error);
+    EXPECT_TRUE(handle.ready());
+}
+
+/**
+ * @brief Testa ordem de prioridade e contadores de profundidade por nível
+ */
+TEST(PriorityTest, OrdemEProfundidade) {
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        ThreadPoolOptions options{1, mode};
+        options.priority_aging = std::chrono::seconds(10);
+        ThreadPool priority_pool(options);
+
+        // Bloqueia o único worker enquanto as tarefas são enfileiradas
+        std::promise<void> gate;
+        std::promise<void> started;
+        std::shared_future<void> opened = gate.get_future().share();
+        auto blocker = priority_pool.submit([opened, &started]() {
+            started.set_value();
+            opened.wait();
+        });
+        started.get_future().wait();
+
+        std::mutex order_mutex;
+        std::vector<int> order;
+        auto record = [&](int value) {
+            std::lock_guard lock(order_mutex);
+            order.push_back(value);
+        };
+
+        std::vector<std::future<void>> futures;
+        futures.push_back(priority_pool.submit(TaskPriority::Low, record, 3));
+        futures.push_back(priority_pool.submit(TaskPriority::Normal, record, 2));
+        futures.push_back(priority_pool.submit(TaskPriority::High, record, 1));
+        futures.push_back(priority_pool.submit(TaskPriority::High, record, 1));
+
+        EXPECT_EQ(priority_pool.queue_depth(TaskPriority::High), 2);
+        EXPECT_EQ(priority_pool.queue_depth(TaskPriority::Normal), 1);
+        EXPECT_EQ(priority_pool.queue_depth(TaskPriority::Low), 1);
+
+        gate.set_value();
+        blocker.get();
+        for (auto& future : futures) future.get();
+
+        EXPECT_EQ(order, (std::vector<int>{1, 1, 2, 3}));
+        EXPECT_EQ(priority_pool.queue_depth(TaskPriority::High), 0);
+        EXPECT_EQ(priority_pool.queue_depth(TaskPriority::Low), 0);
+    }
+}
+
+/**
+ * @brief Testa que o envelhecimento evita starvation de tarefas Low
+ */
+TEST(PriorityTest, EnvelhecimentoEvitaStarvation) {
+    ThreadPoolOptions options{1};
+    options.priority_aging = std::chrono::milliseconds(1);
+    ThreadPool priority_pool(options);
+
+    std::atomic<bool> low_done{false};
+    std::atomic<bool> stop_flood{false};
+
+    // Cada tarefa High reenfileira outra, mantendo o nível High sempre ocupado
+    std::function<void()> flood = [&]() {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        if (!stop_flood.load()) priority_pool.submit(TaskPriority::High, flood);
+    };
+    for (int i = 0; i < 4; ++i) priority_pool.submit(TaskPriority::High, flood);
+
+    auto low = priority_pool.submit(TaskPriority::Low, [&]() { low_done = true; });
+    EXPECT_EQ(low.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_TRUE(low_done.load());
+    stop_flood = true;
+}
+
+/**
+ * @brief Testa o EventCount: notificar sem espera é inócuo e quem dorme acorda
+ */
+TEST(EventCountTest, EsperaENotificacao) {
+    EventCount event;
+    event.notify_one();
+    EXPECT_EQ(event.waiters(), 0);
+
+    std::atomic<bool> ready{false};
+    std::thread sleeper([&]() {
+        while (true) {
+            EventCount::Key key = event.prepare_wait();
+            if (ready.load()) {
+                event.cancel_wait();
+                return;
+            }
+            event.wait(key);
+        }
+    });
+
+    ready = true;
+    event.notify_one();
+    sleeper.join();
+    EXPECT_EQ(event.waiters(), 0);
+}
+
+/**
+ * @brief Testa a estratégia spin-then-park com rajadas após ociosidade
+ */
+TEST(WaitStrategyTest, SpinThenParkEmAmbosOsModos) {
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        ThreadPoolOptions options{4, mode};
+        options.wait_strategy = WaitStrategy::spin_then_park(100, 10);
+        ThreadPool spin_pool(options);
+
+        for (int burst = 0; burst < 20; ++burst) {
+            std::vector<std::future<int>> futures;
+            for (int i = 0; i < 10; ++i) {
+                futures.push_back(spin_pool.submit([i]() { return i; }));
+            }
+            int sum = 0;
+            for (auto& future : futures) sum += future.get();
+            EXPECT_EQ(sum, 45);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+}
+
+/**
+ * @brief Testa crescimento por profundidade de fila e aposentadoria por ociosidade
+ */
+TEST(ElasticPoolTest, CresceEEncolhe) {
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        ThreadPoolOptions options{1, mode};
+        options.min_threads = 1;
+        options.max_threads = 4;
+        options.grow_queue_depth = 2;
+        options.idle_timeout = std::chrono::milliseconds(50);
+        ThreadPool elastic_pool(options);
+        EXPECT_EQ(elastic_pool.size(), 1);
+
+        // Tarefas bloqueantes: o pool precisa crescer para absorvê-las
+        std::promise<void> gate;
+        std::shared_future<void> opened = gate.get_future().share();
+        std::vector<std::future<void>> futures;
+        for (int i = 0; i < 16; ++i) {
+            futures.push_back(elastic_pool.submit([opened]() { opened.wait(); }));
+        }
+        EXPECT_GT(elastic_pool.size(), 1);
+        EXPECT_LE(elastic_pool.size(), 4);
+
+        gate.set_value();
+        for (auto& future : futures) future.get();
+
+        // Ociosos além do mínimo se aposentam
+        for (int i = 0; i < 100 && elastic_pool.size() > 1; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        ThreadPoolStats stats = elastic_pool.stats();
+        EXPECT_EQ(stats.live_threads, 1);
+        EXPECT_GE(stats.grow_events, 1);
+        EXPECT_EQ(stats.grow_events, stats.shrink_events);
+        EXPECT_LE(stats.peak_threads, 4);
+        ASSERT_FALSE(stats.recent_resizes.empty());
+        EXPECT_EQ(stats.recent_resizes.back().reason, ResizeReason::IdleTimeout);
+
+        // O pool continua funcional depois de encolher
+        EXPECT_EQ(elastic_pool.submit([]() { return 7; }).get(), 7);
+    }
+}
+
+/**
+ * @brief Testa crescimento por tempo de backlog com poucas tarefas bloqueantes
+ */
+TEST(ElasticPoolTest, CresceComBacklogPersistente) {
+    ThreadPoolOptions options{1};
+    options.min_threads = 1;
+    options.max_threads = 2;
+    options.grow_queue_depth = 1000;
+    options.grow_wait_time = std::chrono::milliseconds(1);
+    ThreadPool elastic_pool(options);
+
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    auto blocked = elastic_pool.submit([opened]() { opened.wait(); });
+
+    // O segundo submit inicia o backlog; os seguintes, após o prazo, fazem o pool crescer
+    for (int i = 0; i < 10 && elastic_pool.size() < 2; ++i) {
+        elastic_pool.submit([]() {});
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    EXPECT_EQ(elastic_pool.size(), 2);
+    EXPECT_EQ(elastic_pool.stats().recent_resizes.front().reason, ResizeReason::QueueWait);
+
+    gate.set_value();
+    blocked.get();
+}
+
+/**
+ * @brief Testa crescimento logo após uma aposentadoria no modo work-stealing
+ *
+ * O worker aposentado só devolve o índice da sua deque quando termina; um
+ * crescimento nesse intervalo não pode usar um índice inexistente.
+ */
+TEST(ElasticPoolTest, CresceLogoAposAposentadoria) {
+    ThreadPoolOptions options{1, SchedulerMode::WorkStealing};
+    options.min_threads = 1;
+    options.max_threads = 2;
+    options.grow_queue_depth = 1;
+    options.idle_timeout = std::chrono::milliseconds(1);
+    ThreadPool elastic_pool(options);
+
+    std::atomic<int> done{0};
+    int submitted = 0;
+    for (int round = 0; round < 200; ++round) {
+        // Rajada faz o pool crescer; a pausa curta deixa o worker extra se aposentar
+        for (int i = 0; i < 8; ++i, ++submitted) {
+            elastic_pool.execute([&done]() { done.fetch_add(1); });
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(500 + (round % 7) * 250));
+        EXPECT_LE(elastic_pool.size(), 2);
+    }
+    for (int i = 0; i < 1000 && done.load() < submitted; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    EXPECT_EQ(done.load(), submitted);
+    EXPECT_GE(elastic_pool.stats().grow_events, 1);
+}
+
+/**
+ * @brief Testa a leitura de topologia a partir de um sysfs simulado
+ */
+TEST(CpuTopologyTest, LeituraDoSysfs) {
+    EXPECT_EQ(CpuTopology::parse_cpu_list("0-2,5\n"), (std::vector<int>{0, 1, 2, 5}));
+
+    // 4 CPUs lógicas: 2 núcleos com SMT, cada núcleo em seu próprio domínio de LLC
+    namespace fs = std::filesystem;
+    fs::path root = fs::temp_directory_path() / "cpu_topology_test";
+    fs::remove_all(root);
+    auto write = [](const fs::path& path, const std::string& text) {
+        fs::create_directories(path.parent_path());
+        std::ofstream(path) << text << "\n";
+    };
+    write(root / "online", "0-3");
+    for (int cpu = 0; cpu < 4; ++cpu) {
+        fs::path dir = root / ("cpu" + std::to_string(cpu));
+        write(dir / "topology" / "physical_package_id", "0");
+        write(dir / "topology" / "core_id", std::to_string(cpu % 2));
+        write(dir / "cache" / "index0" / "level", "1");
+        write(dir / "cache" / "index0" / "type", "Data");
+        write(dir / "cache" / "index0" / "shared_cpu_list", cpu % 2 ? "1,3" : "0,2");
+        write(dir / "cache" / "index1" / "level", "3");
+        write(dir / "cache" / "index1" / "type", "Unified");
+        write(dir / "cache" / "index1" / "shared_cpu_list", cpu % 2 ? "1,3" : "0,2");
+    }
+
+    CpuTopology topology = CpuTopology::detect(root.string());
+    fs::remove_all(root);
+
+    ASSERT_EQ(topology.cpus().size(), 4);
+    EXPECT_EQ(topology.num_cores(), 2);
+    EXPECT_EQ(topology.num_llc_domains(), 2);
+    EXPECT_EQ(topology.smt_siblings(0), (std::vector<int>{0, 2}));
+    EXPECT_NE(topology.llc_domain(0), topology.llc_domain(1));
+    EXPECT_EQ(topology.placement(AffinityMode::Compact), (std::vector<int>{0, 2, 1, 3}));
+    EXPECT_EQ(topology.placement(AffinityMode::Scatter), (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(topology.placement(AffinityMode::Scatter, {2, 3}), (std::vector<int>{2, 3}));
+    EXPECT_TRUE(topology.placement(AffinityMode::None).empty());
+}
+
+/**
+ * @brief Testa pool com workers fixados em CPUs
+ */
+TEST(CpuTopologyTest, PoolComAfinidade) {
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        ThreadPoolOptions options{4, mode};
+        options.affinity = AffinityMode::Compact;
+        ThreadPool pinned_pool(options);
+
+        std::atomic<int> sum{0};
+        pinned_pool.parallel_for(0, 1000, 10, [&sum](int i) { sum += i; }).get();
+        EXPECT_EQ(sum.load(), 499500);
+    }
+}
+
+/**
+ * @brief Testa ordem de dependências, then() e diamante sobre um único worker
+ */
+TEST(TaskGraphTest, DependenciasEThen) {
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        // Um só worker: qualquer bloqueio dentro de um nó travaria o grafo
+        ThreadPool graph_pool(ThreadPoolOptions{1, mode});
+        TaskGraph graph;
+
+        std::atomic<int> order{0};
+        auto a = graph.emplace([&order]() { return order++ == 0 ? 20 : -1; });
+        auto b = graph.emplace([&order]() { return order++ == 1 ? 22 : -1; });
+        auto sum = graph.emplace([&]() { return a.get() + b.get(); });
+        sum.succeed(a, b);
+        a.precede(b);
+        auto doubled = sum.then([](int value) { return value * 2; });
+        auto text = doubled.then([](int value) { return std::to_string(value); });
+
+        graph.run(graph_pool).get();
+        EXPECT_EQ(sum.get(), 42);
+        EXPECT_EQ(doubled.get(), 84);
+        EXPECT_EQ(text.get(), "84");
+
+        // Reexecução do mesmo grafo
+        order = 0;
+        graph.run(graph_pool).get();
+        EXPECT_EQ(doubled.get(), 84);
+    }
+}
+
+/**
+ * @brief Testa propagação de falha para descendentes e detecção de ciclo
+ */
+TEST(TaskGraphTest, FalhaECiclo) {
+    ThreadPool graph_pool(2);
+    TaskGraph graph;
+
+    std::atomic<bool> ran{false};
+    auto failing = graph.emplace([]() -> int { throw std::runtime_error("Falha no nó"); });
+    auto child = failing.then([&ran](int value) { ran = true; return value; });
+    auto independent = graph.emplace([]() { return 1; });
+
+    JoinHandle handle = graph.run(graph_pool);
+    EXPECT_THROW(handle.get(), std::runtime_error);
+    EXPECT_FALSE(ran.load());
+    EXPECT_THROW(child.get(), std::runtime_error);
+    EXPECT_EQ(independent.get(), 1);
+
+    TaskGraph cyclic;
+    auto x = cyclic.emplace([]() {});
+    auto y = cyclic.emplace([]() {});
+    x.precede(y);
+    y.precede(x);
+    EXPECT_THROW(cyclic.run(graph_pool), std::logic_error);
+}
+
+/**
+ * @brief Testa try_submit, submit_for e os contadores da fila limitada
+ */
+TEST(BoundedQueueTest, TrySubmitESubmitFor) {
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        ThreadPoolOptions options{1, mode};
+        options.queue_limit = 2;
+        ThreadPool bounded_pool(options);
+
+        // Ocupa o único worker e enche a fila
+        std::promise<void> started;
+        std::promise<void> gate;
+        std::shared_future<void> opened = gate.get_future().share();
+        auto blocker = bounded_pool.submit([&started, opened]() {
+            started.set_value();
+            opened.wait();
+        });
+        started.get_future().wait();
+        auto first = bounded_pool.try_submit([]() { return 1; });
+        auto second = bounded_pool.submit_for(std::chrono::milliseconds(10), []() { return 2; });
+        ASSERT_TRUE(first.has_value());
+        ASSERT_TRUE(second.has_value());
+
+        EXPECT_FALSE(bounded_pool.try_submit([]() { return 3; }).has_value());
+        EXPECT_FALSE(bounded_pool.submit_for(std::chrono::milliseconds(20), []() { return 4; }).has_value());
+
+        ThreadPoolStats stats = bounded_pool.stats();
+        EXPECT_EQ(stats.rejected_submissions, 2);
+        EXPECT_EQ(stats.blocked_submissions, 1);
+
+        // submit_for ganha a vaga liberada pelo worker
+        std::thread releaser([&gate]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            gate.set_value();
+        });
+        auto late = bounded_pool.submit_for(std::chrono::seconds(10), []() { return 5; });
+        releaser.join();
+        ASSERT_TRUE(late.has_value());
+
+        blocker.get();
+        EXPECT_EQ(first->get(), 1);
+        EXPECT_EQ(second->get(), 2);
+        EXPECT_EQ(late->get(), 5);
+    }
+}
+
+/**
+ * @brief Testa as políticas de rejeição de submit com a fila cheia
+ */
+TEST(BoundedQueueTest, PoliticasDeRejeicao) {
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        for (auto backend : {QueueBackend::Mutex, QueueBackend::RingBuffer}) {
+            for (auto policy : {RejectionPolicy::Block, RejectionPolicy::CallerRuns,
+                                RejectionPolicy::DropOldest, RejectionPolicy::Fail}) {
+                ThreadPoolOptions options{1, mode};
+                options.queue_backend = backend;
+                options.queue_limit = 2;
+                options.queue_capacity = 2;
+                options.rejection_policy = policy;
+                ThreadPool bounded_pool(options);
+
+                std::promise<void> started;
+                std::promise<void> gate;
+                std::shared_future<void> opened = gate.get_future().share();
+                auto blocker = bounded_pool.submit([&started, opened]() {
+                    started.set_value();
+                    opened.wait();
+                });
+                started.get_future().wait();
+                auto oldest = bounded_pool.submit([]() { return 1; });
+                auto newer = bounded_pool.submit([]() { return 2; });
+
+                const auto caller = std::this_thread::get_id();
+                auto where = []() { return std::this_thread::get_id(); };
+                if (policy == RejectionPolicy::Block) {
+                    std::thread releaser([&gate]() {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                        gate.set_value();
+                    });
+                    auto waited = bounded_pool.submit(where);
+                    releaser.join();
+                    EXPECT_NE(waited.get(), caller);
+                    EXPECT_EQ(bounded_pool.stats().blocked_submissions, 1);
+                    EXPECT_EQ(oldest.get(), 1);
+                } else if (policy == RejectionPolicy::CallerRuns) {
+                    auto inline_run = bounded_pool.submit(where);
+                    EXPECT_EQ(inline_run.get(), caller);
+                    gate.set_value();
+                    EXPECT_EQ(oldest.get(), 1);
+                } else if (policy == RejectionPolicy::DropOldest) {
+                    auto newest = bounded_pool.submit(where);
+                    gate.set_value();
+                    EXPECT_THROW(oldest.get(), std::future_error);
+                    EXPECT_NE(newest.get(), caller);
+                } else {
+                    EXPECT_THROW(bounded_pool.submit(where), QueueFullError);
+                    gate.set_value();
+                    EXPECT_EQ(oldest.get(), 1);
+                }
+
+                blocker.get();
+                EXPECT_EQ(newer.get(), 2);
+                size_t expected_rejections = policy == RejectionPolicy::Block ? 0 : 1;
+                EXPECT_EQ(bounded_pool.stats().rejected_submissions, expected_rejections);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Testa schedule_after, schedule_at, schedule_every e cancel_timer
+ */
+TEST(TimerWheelTest, AtrasoPeriodicoECancelamento) {
+    ThreadPool timer_pool(2);
+    using Clock = std::chrono::steady_clock;
+
+    // Disparo nunca antes do prazo, e na ordem dos prazos
+    auto start = Clock::now();
+    std::mutex order_mutex;
+    std::vector<int> order;
+    std::promise<void> last;
+    auto record = [&](int value) {
+        std::lock_guard lock(order_mutex);
+        order.push_back(value);
+        if (order.size() == 3) last.set_value();
+    };
+    timer_pool.schedule_after(std::chrono::milliseconds(60), [&]() { record(3); });
+    timer_pool.schedule_at(start + std::chrono::milliseconds(30), [&]() { record(2); });
+    timer_pool.schedule_after(std::chrono::milliseconds(-5), [&]() { record(1); });
+    last.get_future().wait();
+    EXPECT_GE(Clock::now() - start, std::chrono::milliseconds(60));
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+
+    // Cancelamento antes do prazo
+    std::atomic<bool> fired{false};
+    TimerId id = timer_pool.schedule_after(std::chrono::milliseconds(20), [&fired]() { fired = true; });
+    EXPECT_TRUE(timer_pool.cancel_timer(id));
+    EXPECT_FALSE(timer_pool.cancel_timer(id));
+
+    // Periódico até ser cancelado
+    std::atomic<int> ticks{0};
+    TimerId periodic = timer_pool.schedule_every(std::chrono::milliseconds(5), [&ticks]() { ++ticks; });
+    for (int i = 0; i < 200 && ticks.load() < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_GE(ticks.load(), 3);
+    EXPECT_TRUE(timer_pool.cancel_timer(periodic));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    int after_cancel = ticks.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    EXPECT_EQ(ticks.load(), after_cancel);
+    EXPECT_FALSE(fired.load());
+}
+
+/**
+ * @brief Testa muitos timers atravessando todos os níveis da roda
+ */
+TEST(TimerWheelTest, MuitosTimersEmTodosOsNiveis) {
+    using Clock = TimerWheel::Clock;
+    std::atomic<int> fired{0};
+    std::atomic<int> early{0};
+
+    // Tick de 1us: os níveis cobrem 64us, 4ms, 262ms e 16,7s
+    TimerWheel wheel([](InlineTask task) { task(); }, std::chrono::microseconds(1));
+
+    const int NUM_TIMERS = 100000;
+    auto start = Clock::now();
+    std::vector<TimerId> ids;
+    ids.reserve(NUM_TIMERS);
+    for (int i = 0; i < NUM_TIMERS; ++i) {
+        auto deadline = start + std::chrono::microseconds((i * 7919) % 300000);
+        ids.push_back(wheel.schedule_at(deadline, [deadline, &fired, &early]() {
+            if (Clock::now() < deadline) ++early;
+            ++fired;
+        }));
+    }
+    // Além do último nível: lista de excedentes
+    TimerId far = wheel.schedule_at(start + std::chrono::seconds(60), []() {});
+
+    // Cancela metade (ids já disparados simplesmente falham)
+    int cancelled = 0;
+    for (int i = 0; i < NUM_TIMERS; i += 2) {
+        if (wheel.cancel(ids[i])) ++cancelled;
+    }
+
+    for (int i = 0; i < 500 && fired.load() + cancelled < NUM_TIMERS; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(fired.load() + cancelled, NUM_TIMERS);
+    EXPECT_EQ(early.load(), 0);
+    EXPECT_EQ(wheel.pending(), 1);
+    EXPECT_TRUE(wheel.cancel(far));
+    EXPECT_EQ(wheel.pending(), 0);
+}
+
+/**
+ * @brief Testa parallel_reduce, parallel_transform e parallel_scan contra std::
+ */
+TEST(ParallelAlgorithmsTest, ReduceTransformScan) {
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        ThreadPool algo_pool(ThreadPoolOptions{4, mode});
+
+        for (size_t count : {size_t{0}, size_t{1}, size_t{1000}, size_t{100003}}) {
+            std::vector<long long> input(count);
+            std::iota(input.begin(), input.end(), 1);
+
+            // Grão pequeno força vários pedaços e reivindicações
+            for (size_t grain : {size_t{0}, size_t{7}}) {
+                EXPECT_EQ(parallel_reduce(algo_pool, input.begin(), input.end(), 5LL, std::plus<>(), grain),
+                          std::accumulate(input.begin(), input.end(), 5LL));
+
+                std::vector<long long> squares(count);
+                auto out = parallel_transform(algo_pool, input.begin(), input.end(), squares.begin(),
+                                              [](long long value) { return value * value; }, grain);
+                EXPECT_EQ(out, squares.end());
+                std::vector<long long> expected(count);
+                std::transform(input.begin(), input.end(), expected.begin(),
+                               [](long long value) { return value * value; });
+                EXPECT_EQ(squares, expected);
+
+                std::vector<long long> prefix(count);
+                parallel_scan(algo_pool, input.begin(), input.end(), prefix.begin(), std::plus<>(), grain);
+                std::inclusive_scan(input.begin(), input.end(), expected.begin());
+                EXPECT_EQ(prefix, expected);
+            }
+        }
+
+        // Operação não comutativa no scan (apenas associativa): concatenação
+        std::vector<std::string> words(500);
+        for (size_t i = 0; i < words.size(); ++i) words[i] = std::string(1, static_cast<char>('a' + i % 26));
+        std::vector<std::string> joined(words.size());
+        parallel_scan(algo_pool, words.begin(), words.end(), joined.begin(), std::plus<>(), 16);
+        std::vector<std::string> expected(words.size());
+        std::inclusive_scan(words.begin(), words.end(), expected.begin());
+        EXPECT_EQ(joined, expected);
+
+        // Exceção do corpo chega ao chamador
+        std::vector<int> values(10000, 1);
+        EXPECT_THROW(parallel_transform(algo_pool, values.begin(), values.end(), values.begin(),
+                                        [](int value) -> int {
+                                            if (value == 1) throw std::runtime_error("falha");
+                                            return value;
+                                        }, 64), std::runtime_error);
+    }
+}
+
+/**
+ * @brief Testa parallel_sort com duplicatas, comparador próprio e tipos só movíveis
+ */
+TEST(ParallelAlgorithmsTest, SortComDuplicatasEComparador) {
+    std::mt19937 rng(42);
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        for (size_t threads : {size_t{3}, size_t{4}, size_t{8}}) {
+            ThreadPool algo_pool(ThreadPoolOptions{threads, mode});
+
+            for (size_t count : {size_t{0}, size_t{100}, size_t{50000}, size_t{200001}}) {
+                // Poucos valores distintos: muitos empates no merge path
+                std::vector<int> values(count);
+                for (auto& value : values) value = static_cast<int>(rng() % 1000);
+                std::vector<int> expected = values;
+                std::sort(expected.begin(), expected.end(), std::greater<>());
+
+                parallel_sort(algo_pool, values.begin(), values.end(), std::greater<>(), 512);
+                EXPECT_EQ(values, expected);
+            }
+        }
+    }
+
+    // Tipo só movível, com o grão automático
+    ThreadPool algo_pool(ThreadPoolOptions{4, SchedulerMode::WorkStealing});
+    std::vector<std::unique_ptr<int>> boxes;
+    for (int i = 0; i < 100000; ++i) boxes.push_back(std::make_unique<int>(static_cast<int>(rng() % 100000)));
+    parallel_sort(algo_pool, boxes.begin(), boxes.end(),
+                  [](const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) { return *a < *b; });
+    EXPECT_TRUE(std::is_sorted(boxes.begin(), boxes.end(),
+                               [](const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) { return *a < *b; }));
+    EXPECT_TRUE(std::all_of(boxes.begin(), boxes.end(), [](const std::unique_ptr<int>& box) { return box != nullptr; }));
+}
+
+/**
+ * @brief Testa baldes, percentis e média do LatencyHistogram
+ */
+TEST(MetricsTest, HistogramaLogaritmico) {
+    EXPECT_EQ(LatencyHistogram::bucket_of(0), 0u);
+    EXPECT_EQ(LatencyHistogram::bucket_of(1), 1u);
+    EXPECT_EQ(LatencyHistogram::bucket_of(1023), 10u);
+    EXPECT_EQ(LatencyHistogram::bucket_of(1024), 11u);
+    EXPECT_EQ(LatencyHistogram::bucket_of(UINT64_MAX), LatencyHistogram::BUCKETS - 1);
+
+    // 90 amostras de ~100ns e 10 de ~1ms
+    LatencyHistogram histogram;
+    for (int i = 0; i < 100; ++i) {
+        uint64_t sample = i < 90 ? 100 : 1000000;
+        histogram.buckets[LatencyHistogram::bucket_of(sample)]++;
+        histogram.count++;
+        histogram.total += std::chrono::nanoseconds(sample);
+    }
+    EXPECT_EQ(histogram.percentile(0.5), std::chrono::nanoseconds(128));
+    EXPECT_EQ(histogram.percentile(0.9), std::chrono::nanoseconds(128));
+    EXPECT_EQ(histogram.percentile(0.99), std::chrono::nanoseconds(1 << 20));
+    EXPECT_EQ(histogram.mean(), std::chrono::nanoseconds((90 * 100 + 10 * 1000000) / 100));
+
+    LatencyHistogram merged;
+    merged.merge(histogram);
+    merged.merge(histogram);
+    EXPECT_EQ(merged.count, 200u);
+    EXPECT_EQ(merged.percentile(0.99), histogram.percentile(0.99));
+    EXPECT_EQ(LatencyHistogram().percentile(0.5), std::chrono::nanoseconds(0));
+}
+
+/**
+ * @brief Testa contadores por worker, tempos e retrato sem parar o pool
+ */
+TEST(MetricsTest, ContadoresPorWorker) {
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        ThreadPoolOptions options{2, mode};
+        ThreadPool metrics_pool(options);
+
+        // Tarefas de ~2ms: tempo de execução mensurável
+        const int NUM_TASKS = 20;
+        std::vector<std::future<void>> futures;
+        for (int i = 0; i < NUM_TASKS; ++i) {
+            futures.push_back(metrics_pool.submit([]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }));
+        }
+
+        // Retrato durante a execução não bloqueia nem perde contagens
+        ThreadPoolStats during = metrics_pool.stats();
+        EXPECT_LE(during.totals.tasks_executed, static_cast<uint64_t>(NUM_TASKS));
+        for (auto& future : futures) future.get();
+
+        // O contador é atualizado logo depois de o future ficar pronto
+        ThreadPoolStats after = metrics_pool.stats();
+        for (int i = 0; i < 200 && after.totals.tasks_executed < NUM_TASKS; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            after = metrics_pool.stats();
+        }
+        EXPECT_EQ(after.totals.tasks_executed, static_cast<uint64_t>(NUM_TASKS));
+        ASSERT_EQ(after.workers.size(), 2u);
+        uint64_t per_worker = 0;
+        for (const auto& worker : after.workers) per_worker += worker.tasks_executed;
+        EXPECT_EQ(per_worker, after.totals.tasks_executed);
+
+        EXPECT_EQ(after.totals.run_time.count, static_cast<uint64_t>(NUM_TASKS));
+        EXPECT_EQ(after.totals.queue_wait.count, static_cast<uint64_t>(NUM_TASKS));
+        EXPECT_GE(after.totals.run_time.percentile(0.5), std::chrono::milliseconds(2));
+        EXPECT_GE(after.totals.busy_time, std::chrono::milliseconds(2 * NUM_TASKS));
+        // Com duas threads, metade das tarefas esperou ao menos uma execução
+        EXPECT_GE(after.totals.queue_wait.percentile(0.9), std::chrono::milliseconds(1));
+        EXPECT_GT(after.totals.utilization(), 0.0);
+        EXPECT_LE(after.totals.utilization(), 1.0);
+        EXPECT_EQ(after.queued_tasks, 0u);
+
+        // Sem medição de tempo só o número de tarefas é contado
+        options.task_metrics = false;
+        ThreadPool untimed(options);
+        untimed.submit([]() {}).get();
+        ThreadPoolStats counted = untimed.stats();
+        for (int i = 0; i < 200 && counted.totals.tasks_executed < 1; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            counted = untimed.stats();
+        }
+        EXPECT_EQ(counted.totals.tasks_executed, 1u);
+        EXPECT_EQ(counted.totals.run_time.count, 0u);
+        EXPECT_EQ(counted.totals.busy_time.count(), 0);
+    }
+}
+
+/**
+ * @brief Testa que contadores de workers aposentados permanecem nos totais
+ */
+TEST(MetricsTest, TotaisSobrevivemAposentadoria) {
+    ThreadPoolOptions options{1, SchedulerMode::SharedQueue};
+    options.min_threads = 1;
+    options.max_threads = 3;
+    options.grow_queue_depth = 1;
+    options.idle_timeout = std::chrono::milliseconds(20);
+    ThreadPool elastic(options);
+
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 30; ++i) {
+        futures.push_back(elastic.submit([]() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); }));
+    }
+    for (auto& future : futures) future.get();
+
+    // Espera os excedentes se aposentarem; o worker registra a tarefa
+    // depois de entregar o future, então espera também os contadores
+    ThreadPoolStats stats = elastic.stats();
+    for (int i = 0; i < 200 && (elastic.size() > 1 || stats.totals.tasks_executed < 30); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        stats = elastic.stats();
+    }
+    EXPECT_EQ(stats.totals.tasks_executed, 30u);
+    EXPECT_EQ(stats.totals.run_time.count, 30u);
+    EXPECT_LE(stats.workers.size(), stats.live_threads);
+}
+
+/**
+ * @brief Conta ocorrências de um trecho em um texto
+ */
+static size_t count_occurrences(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief Testa a linha do tempo exportada como Chrome trace
+ */
+TEST(TraceTest, LinhaDoTempoChromeJson) {
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        ThreadPool traced(ThreadPoolOptions{2, mode});
+
+        // Desligado: nada é gravado
+        traced.submit([]() {}).get();
+        std::ostringstream empty;
+        traced.write_trace(empty);
+        EXPECT_EQ(count_occurrences(empty.str(), "\"ph\":\"B\""), 0u);
+
+        traced.start_tracing();
+        std::vector<std::future<void>> futures;
+        {
+            TraceLabel label("parse \"json\"");
+            for (int i = 0; i < 10; ++i) {
+                futures.push_back(traced.submit([]() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }));
+            }
+        }
+        futures.push_back(traced.submit([]() {}));
+        traced.parallel_for(0, 4, 1, [](int) {}).get();
+        for (auto& future : futures) future.get();
+
+        // O fim é gravado logo depois de o future ficar pronto
+        std::string json;
+        for (int i = 0; i < 200; ++i) {
+            std::ostringstream out;
+            traced.write_trace(out);
+            json = out.str();
+            if (count_occurrences(json, "\"ph\":\"E\"") >= 13) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        traced.stop_tracing();
+        traced.submit([]() {}).get();
+
+        // Uma fatia e uma seta por tarefa; parallel_for publica uma tarefa por worker
+        size_t slices = count_occurrences(json, "\"ph\":\"B\"");
+        EXPECT_EQ(slices, 13u);
+        EXPECT_EQ(count_occurrences(json, "\"ph\":\"E\""), slices);
+        EXPECT_EQ(count_occurrences(json, "\"ph\":\"s\""), slices);
+        EXPECT_EQ(count_occurrences(json, "\"ph\":\"f\""), slices);
+        EXPECT_EQ(count_occurrences(json, "\"name\":\"parse \\\"json\\\"\""), 10u * 5);
+        EXPECT_NE(json.find("\"thread_name\""), std::string::npos);
+        EXPECT_EQ(json.rfind("{\"displayTimeUnit\"", 0), 0u);
+        EXPECT_EQ(json.substr(json.size() - 3), "]}\n");
+    }
+}
+
+/**
+ * @brief Testa descarte de tarefas canceladas antes de começar e cancelamento em grupo
+ */
+TEST(CancellationTest, GrupoDescartadoAntesDeExecutar) {
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        ThreadPool cancel_pool(ThreadPoolOptions{1, mode});
+
+        // Segura o único worker enquanto a fila enche
+        std::promise<void> gate;
+        std::shared_future<void> opened = gate.get_future().share();
+        auto blocker = cancel_pool.submit([opened]() { opened.wait(); });
+
+        CancellationSource group;
+        CancellationSource subgroup(group.token());
+        CancellationSource other;
+        std::atomic<int> ran{0};
+        std::atomic<int> executed{0};
+
+        std::vector<std::future<int>> in_group;
+        for (int i = 0; i < 50; ++i) {
+            in_group.push_back(cancel_pool.submit(i % 2 ? group.token() : subgroup.token(),
+                                                  [&ran, i]() { ++ran; return i; }));
+        }
+        cancel_pool.execute(group.token(), [&executed]() { ++executed; });
+        auto survivor = cancel_pool.submit(other.token(), TaskPriority::Low, [](int x) { return x * 2; }, 21);
+        auto plain = cancel_pool.submit([]() { return 7; });
+
+        // Cancelar o grupo pai cancela também o subgrupo
+        group.cancel();
+        EXPECT_TRUE(subgroup.cancelled());
+        EXPECT_FALSE(other.cancelled());
+        gate.set_value();
+
+        for (auto& future : in_group) {
+            EXPECT_THROW(future.get(), TaskCancelledError);
+        }
+        EXPECT_EQ(survivor.get(), 42);
+        EXPECT_EQ(plain.get(), 7);
+        blocker.get();
+        EXPECT_EQ(ran.load(), 0);
+        EXPECT_EQ(executed.load(), 0);
+
+        // Cancelar um subgrupo não afeta o pai
+        CancellationSource parent;
+        CancellationSource child(parent.token());
+        child.cancel();
+        EXPECT_FALSE(parent.cancelled());
+        EXPECT_TRUE(child.token().cancelled());
+        EXPECT_FALSE(CancellationToken().cancelled());
+        EXPECT_FALSE(CancellationToken().can_be_cancelled());
+    }
+}
+
+/**
+ * @brief Testa tarefa em execução consultando o token
+ */
+TEST(CancellationTest, TarefaEmExecucaoConsultaToken) {
+    ThreadPool cancel_pool(2);
+    CancellationSource source;
+    CancellationToken token = source.token();
+
+    std::promise<void> started;
+    auto long_running = cancel_pool.submit(token, [token, &started]() {
+        started.set_value();
+        int iterations = 0;
+        while (!token.cancelled()) {
+            ++iterations;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        token.throw_if_cancelled();
+        return iterations;
+    });
+
+    started.get_future().wait();
+    source.cancel();
+    source.cancel();
+    EXPECT_THROW(long_running.get(), TaskCancelledError);
+
+    // Tarefas submetidas depois do cancelamento nunca executam
+    std::atomic<bool> ran{false};
+    auto late = cancel_pool.submit(token, [&ran]() { ran = true; });
+    EXPECT_THROW(late.get(), TaskCancelledError);
+    EXPECT_FALSE(ran.load());
+}
+
+/**
+ * @brief Testa ordem de submissão e exclusão mútua em um strand
+ */
+TEST(StrandTest, OrdemSemConcorrencia) {
+    ThreadPool strand_pool(4);
+    Strand strand(strand_pool);
+
+    // Duas threads submetem; cada uma deve ver suas tarefas em ordem
+    constexpr int PER_PRODUCER = 500;
+    std::vector<int> seen[2];
+    std::atomic<int> inside{0};
+    std::atomic<bool> overlapped{false};
+    std::atomic<bool> outside_strand{false};
+
+    auto produce = [&](int producer) {
+        for (int i = 0; i < PER_PRODUCER; ++i) {
+            strand.post([&, producer, i]() {
+                if (inside.fetch_add(1) != 0) overlapped = true;
+                if (!strand.running_in_this_thread()) outside_strand = true;
+                seen[producer].push_back(i);
+                inside.fetch_sub(1);
+            });
+        }
+    };
+    std::thread first(produce, 0);
+    std::thread second(produce, 1);
+    first.join();
+    second.join();
+
+    // Tarefas postadas por uma tarefa do strand entram no fim da mesma fila
+    auto last = strand.submit([&strand]() {
+        auto nested = std::make_shared<std::promise<int>>();
+        std::future<int> result = nested->get_future();
+        strand.post([nested]() { nested->set_value(42); });
+        return result;
+    });
+    EXPECT_EQ(last.get().get(), 42);
+
+    EXPECT_FALSE(overlapped.load());
+    EXPECT_FALSE(outside_strand.load());
+    EXPECT_FALSE(strand.running_in_this_thread());
+    EXPECT_EQ(strand.pending(), 0u);
+    for (auto& sequence : seen) {
+        ASSERT_EQ(sequence.size(), static_cast<size_t>(PER_PRODUCER));
+        EXPECT_TRUE(std::is_sorted(sequence.begin(), sequence.end()));
+    }
+}
+
+/**
+ * @brief Testa strands por chave: ordem por chave e chaves em paralelo
+ */
+TEST(StrandTest, ChavesEmParaleloSemBloquearWorkers) {
+    ThreadPool strand_pool(2);
+
+    {
+        StrandMap<int> strands(strand_pool);
+
+        // A chave 1 só termina quando a chave 2 executar: exige as duas em paralelo
+        std::promise<void> released;
+        auto waiting = strands.submit(1, [&released]() {
+            released.get_future().wait();
+            return 1;
+        });
+        auto releasing = strands.submit(2, [&released]() {
+            released.set_value();
+            return 2;
+        });
+        EXPECT_EQ(waiting.get() + releasing.get(), 3);
+
+        // Cada chave acumula seu vetor sem lock: ordem e exclusão vêm do strand
+        constexpr int KEYS = 8;
+        constexpr int PER_KEY = 300;
+        std::vector<std::vector<int>> per_key(KEYS);
+        std::vector<std::future<size_t>> done;
+        for (int i = 0; i < PER_KEY; ++i) {
+            for (int key = 0; key < KEYS; ++key) {
+                strands.post(key, [&per_key, key, i]() { per_key[key].push_back(i); });
+            }
+        }
+        for (int key = 0; key < KEYS; ++key) {
+            done.push_back(strands.submit(key, [&per_key, key]() { return per_key[key].size(); }));
+        }
+        for (int key = 0; key < KEYS; ++key) {
+            EXPECT_EQ(done[key].get(), static_cast<size_t>(PER_KEY));
+            EXPECT_TRUE(std::is_sorted(per_key[key].begin(), per_key[key].end()));
+        }
+
+        // Chaves ociosas são descartadas
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (strands.active_keys() != 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        EXPECT_EQ(strands.active_keys(), 0u);
+
+        // O destrutor espera tarefas ainda pendentes
+        for (int i = 0; i < 50; ++i) {
+            strands.post(i % 3, []() { std::this_thread::sleep_for(std::chrono::microseconds(50)); });
+        }
+    }
+
+    std::string text = "chaves";
+    StrandMap<std::string> named(strand_pool);
+    EXPECT_EQ(named.submit(text, [](const std::string& value) { return value.size(); }, text).get(), 6u);
+}
+
+/**
+ * @brief Testa TaskFuture: then, when_all e when_any sem thread esperando
+ */
+TEST(FutureTest, ContinuacoesECombinadores) {
+    ThreadPool future_pool(4);
+
+    // Lote juntado por when_all em vez de N get()
+    std::vector<TaskFuture<int>> squares;
+    for (int i = 0; i < 20; ++i) {
+        squares.push_back(future_pool.async([](int value) { return value * value; }, i));
+    }
+    auto total = when_all(std::move(squares)).then([](std::vector<int> values) {
+        return std::accumulate(values.begin(), values.end(), 0);
+    });
+    EXPECT_EQ(total.get(), 2470);
+
+    // Encadeamento inline e em executor
+    auto text = future_pool.async([]() { return 2; })
+        .then([](int value) { return value * 3; })
+        .then(future_pool, [](int value) { return std::to_string(value); });
+    EXPECT_EQ(text.get(), "6");
+    EXPECT_FALSE(text.valid());
+
+    auto after_void = future_pool.async(TaskPriority::High, []() {}).then([]() { return 7; });
+    EXPECT_EQ(after_void.get(), 7);
+
+    // Os combinadores disparam na thread que publica o resultado
+    TaskPromise<int> first, second;
+    std::vector<TaskFuture<int>> pair;
+    pair.push_back(first.get_future());
+    pair.push_back(second.get_future());
+    auto all = when_all(std::move(pair));
+    first.set_value(1);
+    EXPECT_FALSE(all.ready());
+    second.set_value(2);
+    EXPECT_TRUE(all.ready());
+    EXPECT_EQ(all.get(), (std::vector<int>{1, 2}));
+
+    TaskPromise<std::string> slow, fast;
+    std::vector<TaskFuture<std::string>> race;
+    race.push_back(slow.get_future());
+    race.push_back(fast.get_future());
+    auto any = when_any(std::move(race));
+    EXPECT_FALSE(any.ready());
+    fast.set_value("rápido");
+    EXPECT_TRUE(any.ready());
+    slow.set_value("lento");
+    WhenAnyResult<std::string> winner = any.get();
+    EXPECT_EQ(winner.index, 1u);
+    EXPECT_EQ(winner.value, "rápido");
+
+    std::vector<TaskFuture<void>> nothing;
+    EXPECT_TRUE(when_all(std::move(nothing)).ready());
+}
+
+/**
+ * @brief Testa propagação de exceções e promise quebrado em TaskFuture
+ */
+TEST(FutureTest, ExcecoesEPromiseQuebrado) {
+    ThreadPool future_pool(2);
+
+    // A continuação não é chamada e a exceção segue adiante
+    std::atomic<bool> continued{false};
+    auto failed = future_pool.async([]() -> int { throw std::runtime_error("falhou"); })
+        .then([&continued](int value) { continued = true; return value; });
+    EXPECT_THROW(failed.get(), std::runtime_error);
+    EXPECT_FALSE(continued.load());
+    EXPECT_THROW(failed.get(), std::future_error);
+
+    // when_all espera todos e entrega a exceção
+    std::atomic<int> finished{0};
+    std::vector<TaskFuture<void>> batch;
+    for (int i = 0; i < 8; ++i) {
+        batch.push_back(future_pool.async([i, &finished]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++finished;
+            if (i == 3) throw std::logic_error("parte 3");
+        }));
+    }
+    auto joined = when_all(std::move(batch));
+    EXPECT_THROW(joined.get(), std::logic_error);
+    EXPECT_EQ(finished.load(), 8);
+
+    TaskFuture<int> orphan;
+    {
+        TaskPromise<int> promise;
+        orphan = promise.get_future();
+    }
+    try {
+        orphan.get();
+        FAIL() << "esperava broken_promise";
+    } catch (const std::future_error& error) {
+        EXPECT_EQ(error.code(), std::future_errc::broken_promise);
+    }
+
+    TaskPromise<int> twice;
+    twice.set_value(1);
+    EXPECT_THROW(twice.set_value(2), std::future_error);
+    EXPECT_THROW(when_any(std::vector<TaskFuture<int>>{}), std::invalid_argument);
+}
+
+/**
+ * @brief Soma recursiva que espera a metade submetida com HelpingWait::get
+ */
+static long fork_join_sum(ThreadPool& pool, int depth) {
+    if (depth == 0) return 1;
+    std::future<long> left = pool.submit(fork_join_sum, std::ref(pool), depth - 1);
+    long right = fork_join_sum(pool, depth - 1);
+    return right + HelpingWait::get(left);
+}
+
+/**
+ * @brief Soma recursiva com TaskFuture, cujo get() já ajuda o pool
+ */
+static int fork_join_count(ThreadPool& pool, int depth) {
+    if (depth == 0) return 1;
+    TaskFuture<int> left = pool.async(fork_join_count, std::ref(pool), depth - 1);
+    TaskFuture<int> right = pool.async(fork_join_count, std::ref(pool), depth - 1);
+    return left.get() + right.get();
+}
+
+/**
+ * @brief Testa fork/join recursivo mais profundo que o número de threads
+ */
+TEST(HelpingWaitTest, ForkJoinMaisProfundoQueThreads) {
+    EXPECT_FALSE(HelpingWait::in_worker());
+    EXPECT_FALSE(HelpingWait::run_one());
+
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        // Dois workers e profundidade 10: sem ajuda, todos esperariam e o pool travaria
+        ThreadPool small_pool(ThreadPoolOptions{2, mode});
+
+        auto sum = small_pool.submit(fork_join_sum, std::ref(small_pool), 10);
+        ASSERT_EQ(sum.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+        EXPECT_EQ(sum.get(), 1024);
+
+        auto count = small_pool.async(fork_join_count, std::ref(small_pool), 8);
+        EXPECT_EQ(count.get(), 256);
+
+        auto inside = small_pool.submit([]() { return HelpingWait::in_worker(); });
+        EXPECT_TRUE(inside.get());
+    }
+}
+
+/**
+ * @brief Testa parallel_for aninhado esperando o JoinHandle dentro das tarefas
+ */
+TEST(HelpingWaitTest, JoinHandleAninhado) {
+    ThreadPool small_pool(2);
+    std::atomic<int> cells{0};
+
+    // Cada parte externa espera seu próprio parallel_for interno
+    small_pool.parallel_for(0, 8, 1, [&small_pool, &cells](int) {
+        small_pool.parallel_for(0, 16, 1, [&cells](int) {
+            cells.fetch_add(1);
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }).get();
+    }).get();
+
+    EXPECT_EQ(cells.load(), 8 * 16);
+
+    // Algoritmos paralelos chamados de dentro de tarefas do mesmo pool
+    std::vector<long long> input(4096);
+    std::iota(input.begin(), input.end(), 0LL);
+    std::vector<std::future<long long>> sums;
+    for (int i = 0; i < 4; ++i) {
+        sums.push_back(small_pool.submit([&small_pool, &input]() {
+            return parallel_reduce(small_pool, input.begin(), input.end(), 0LL, std::plus<>(), 64);
+        }));
+    }
+    for (auto& sum : sums) {
+        EXPECT_EQ(sum.get(), 4095LL * 4096 / 2);
+    }
+}
+
+/**
+ * @brief Executa a mesma carga em uma configuração do BasicThreadPool
+ */
+template<class Pool>
+static void exercise_basic_pool(Pool& pool) {
+    std::atomic<int> counter{0};
+    for (int i = 0; i < 1000; ++i) {
+        pool.execute([&counter]() { counter.fetch_add(1); });
+    }
+
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 100; ++i) {
+        results.push_back(pool.submit([](int a, int b) { return a + b; }, i, 1));
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(results[i].get(), i + 1);
+    }
+
+    auto failing = pool.submit([]() -> int { throw std::runtime_error("erro"); });
+    EXPECT_THROW(failing.get(), std::runtime_error);
+
+    // Tarefa move-only (inclusive com std::function)
+    auto owned = std::make_unique<int>(7);
+    EXPECT_EQ(pool.submit([value = std::move(owned)]() { return *value; }).get(), 7);
+
+    while (counter.load() < 1000) std::this_thread::yield();
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+/**
+ * @brief Testa as combinações de políticas do BasicThreadPool
+ */
+TEST(BasicThreadPoolTest, ConfiguracoesDePoliticas) {
+    {
+        DefaultThreadPool pool(4);
+        EXPECT_EQ(pool.size(), 4u);
+        exercise_basic_pool(pool);
+    }
+    {
+        BasicThreadPool<RingQueuePolicy<64>, SpinThenParkWaitPolicy<100, 10>, InlineTaskPolicy> pool(3);
+        exercise_basic_pool(pool);
+    }
+    {
+        BasicThreadPool<RingQueuePolicy<8>, SpinWaitPolicy, InlineTaskPolicy> pool(2);
+        exercise_basic_pool(pool);
+    }
+    {
+        BasicThreadPool<MutexQueuePolicy, ParkWaitPolicy, FunctionTaskPolicy> pool(2);
+        exercise_basic_pool(pool);
+    }
+}
+
+/**
+ * @brief Testa que o destrutor executa as tarefas pendentes
+ */
+TEST(BasicThreadPoolTest, DestrutorDrenaFila) {
+    std::atomic<int> executed{0};
+    {
+        BasicThreadPool<RingQueuePolicy<16>> pool(1);
+        std::promise<void> gate;
+        std::shared_future<void> opened = gate.get_future().share();
+        pool.execute([opened]() { opened.wait(); });
+
+        // Com o único worker preso, o anel enche e execute cede a vez até haver espaço
+        std::thread producer([&pool, &executed]() {
+            for (int i = 0; i < 100; ++i) {
+                pool.execute([&executed]() { executed.fetch_add(1); });
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        gate.set_value();
+        producer.join();
+    }
+    EXPECT_EQ(executed.load(), 100);
+}
+
+#ifdef THREAD_POOL_HAS_COROUTINES
+/**
+ * @brief Testa co_await pool.schedule() e AsyncTask aninhadas
+ */
+TEST(CoroutineTest, ScheduleEAsyncTask) {
+    for (auto mode : {SchedulerMode::SharedQueue, SchedulerMode::WorkStealing}) {
+        ThreadPool coroutine_pool(ThreadPoolOptions{2, mode});
+        const auto caller = std::this_thread::get_id();
+
+        auto square = [&coroutine_pool](int value) -> AsyncTask<int> {
+            co_await coroutine_pool.schedule();
+            co_return value * value;
+        };
+        auto sum = [&]() -> AsyncTask<int> {
+            int total = 0;
+            for (int i = 1; i <= 100; ++i) {
+                total += co_await square(i);
+            }
+            EXPECT_NE(std::this_thread::get_id(), caller);
+            co_return total;
+        };
+
+        EXPECT_EQ(sync_wait(sum()), 338350);
+    }
+}
+
+/**
+ * @brief Testa propagação de exceções e retomada com prioridade
+ */
+TEST(CoroutineTest, ExcecaoEPrioridade) {
+    ThreadPool coroutine_pool(1);
+
+    auto failing = [&coroutine_pool]() -> AsyncTask<> {
+        co_await coroutine_pool.schedule(TaskPriority::High);
+        throw std::runtime_error("Falha na corrotina");
+    };
+    EXPECT_THROW(sync_wait(failing()), std::runtime_error);
+
+    auto caught = [&]() -> AsyncTask<bool> {
+        try {
+            co_await failing();
+        } catch (const std::runtime_error&) {
+            co_return true;
+        }
+        co_return false;
+    };
+    EXPECT_TRUE(sync_wait(caught()));
+}
+#endif
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();